@@ -1,10 +1,17 @@
-#include "include/Unix/UnixSocket.hpp"
+#include "include/Unix/DiscoveryClient.hpp"
 #include "include/Config/Config.hpp"
 #include "include/Utility/Serialization/Deserializer.hpp"
 #include "include/Network/NetInterfaces/NetInterface.hpp"
 #include "include/Network/NetInterfaces/IPv4Info.hpp"
 #include "include/Network/NetInterfaces/IPv6Info.hpp"
 #include "include/Network/NetInterfaces/NetInterfaceManager.hpp"
+#include "include/Unix/UnixRequest.hpp"
+#include "include/Journal/JournalEvent.hpp"
+#include "include/Network/Protocol/ShardDigest.hpp"
+#include "include/Network/NeighborPage.hpp"
+#include "include/Network/NeighborLatency.hpp"
+#include "include/Network/NeighborLoss.hpp"
+#include "include/Utility/Result.hpp"
 
 #include <iostream>
 #include <vector>
@@ -12,83 +19,303 @@
 #include <chrono>
 #include <ranges>
 #include <algorithm>
+#include <string>
+#include <format>
 
-using Unix::UnixSocket;
+using Unix::DiscoveryClient;
+using Unix::DiscoveryResponse;
 using Utility::Serialization::Deserializer;
 using Network::NetInterfaces::NetInterface;
 using Network::NetInterfaces::IPv4Info;
 using Network::NetInterfaces::IPv6Info;
 using Network::NetInterfaces::NetInterfaceManager;
+using Unix::UnixRequest;
+using Journal::JournalEvent;
+using Journal::JournalEventType;
+using Network::Protocol::ShardDigest;
+using Network::NeighborPage;
+using Network::NeighborLatency;
+using Network::NeighborLoss;
+using Network::LossReport;
+using Utility::Result;
+using Utility::Error;
+using Utility::ErrorCode;
 
-int main() {
-    auto clientReturn = UnixSocket::clientFactory(Config::UNIX_DOMAIN_SOCKET_PATH);
-    if (!clientReturn.isOk()) {
-        std::cout << "Failed opening UNIX domain socket on " << Config::UNIX_DOMAIN_SOCKET_PATH << ": " << clientReturn.msg.value() << std::endl;
-        return -1;
+namespace {
+    //usage: cpp_neighbor_cli [socket=PATH] [[request] [mac=MAC_PREFIX] [cidr=SUBNET] [interface=NAME] [age=SECONDS] [rtt=MS] [fields=name,mac,ipv4,ipv6]
+    //                         | events [since=SECONDS] [from=MS] [to=MS] [mac=MAC] | shards | latency | loss | reload]
+    //neighbor list options are evaluated by daemon, so only matching neighbors are sent
+    //without request command neighbor list is fetched in pages, request asks for whole list at once
+    UnixRequest parseArguments(int argc, char** argv) {
+        UnixRequest request{Config::UNIX_DOMAIN_PAGE_COMMAND, {}};
+        request.options["limit"] = std::to_string(Config::CLI_PAGE_SIZE);
+        int firstOption = 1;
+        if (argc > 1 && std::string(argv[1]) == Config::UNIX_DOMAIN_SHARDS_COMMAND) {
+            request.command = Config::UNIX_DOMAIN_SHARDS_COMMAND;
+            firstOption = argc;
+        } else if (argc > 1 && std::string(argv[1]) == Config::UNIX_DOMAIN_LOSS_COMMAND) {
+            request.command = Config::UNIX_DOMAIN_LOSS_COMMAND;
+            firstOption = argc;
+        } else if (argc > 1 && std::string(argv[1]) == Config::UNIX_DOMAIN_LATENCY_COMMAND) {
+            request.command = Config::UNIX_DOMAIN_LATENCY_COMMAND;
+            firstOption = argc;
+        } else if (argc > 1 && std::string(argv[1]) == Config::UNIX_DOMAIN_RELOAD_COMMAND) {
+            request.command = Config::UNIX_DOMAIN_RELOAD_COMMAND;
+            firstOption = argc;
+        } else if (argc > 1 && std::string(argv[1]) == Config::UNIX_DOMAIN_EVENTS_COMMAND) {
+            request.command = Config::UNIX_DOMAIN_EVENTS_COMMAND;
+            firstOption = 2;
+        } else if (argc > 1 && std::string(argv[1]) == Config::UNIX_DOMAIN_REQUEST_COMMAND) {
+            request.command = Config::UNIX_DOMAIN_REQUEST_COMMAND;
+            firstOption = 2;
+        }
+        if (request.command != Config::UNIX_DOMAIN_PAGE_COMMAND) {
+            request.options.clear();
+        }
+
+        for (int i = firstOption; i < argc; i++) {
+            std::string arg = argv[i];
+            auto eq = arg.find('=');
+            if (eq == std::string::npos) {
+                continue;
+            }
+            std::string key = arg.substr(0, eq);
+            std::string value = arg.substr(eq + 1);
+            //since is relative to now, daemon only understands absolute time
+            if (key == "since" && request.command == Config::UNIX_DOMAIN_EVENTS_COMMAND) {
+                auto now = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+                key = "from";
+                value = std::to_string(now - std::stoll(value) * 1000);
+            }
+            request.options[key] = value;
+        }
+        //daemon is allowed to compress response
+        request.options[Config::UNIX_DOMAIN_ACCEPT_OPTION] = "lz";
+        return request;
     }
 
-    auto client = std::move(clientReturn.data.value());
+    std::string eventTypeName(JournalEventType type) {
+        switch (type) {
+            case JournalEventType::Added: return "ADDED";
+            case JournalEventType::Updated: return "UPDATED";
+            case JournalEventType::Expired: return "EXPIRED";
+        }
+        return "UNKNOWN";
+    }
 
-    //request neigbhor list
-    auto sendReturn = client.send(Config::UNIX_DOMAIN_REQUEST_COMMAND);
-    if (!sendReturn.isOk()) {
-        std::cout << "Failed sending on UNIX domain socket on " << Config::UNIX_DOMAIN_SOCKET_PATH << ": " << sendReturn.msg.value() << std::endl;
-        return -1;
+    void printEvents(const std::vector<JournalEvent>& events) {
+        std::cout << "Neighbor events: \n";
+        for (const auto& event : events) {
+            auto time = std::chrono::sys_time<std::chrono::milliseconds>(std::chrono::milliseconds(event.timeMs));
+            std::cout << std::format("{:%Y-%m-%d %H:%M:%S}", time) << " " << eventTypeName(event.type) << " " << event.nif.mac;
+            if (!event.nif.name.empty()) {
+                std::cout << " (" << event.nif.name << ")";
+            }
+            std::cout << "\n";
+            for (const auto& ipv4 : event.nif.ipv4s) {
+                std::cout << "\t - " << ipv4.address << "\n";
+            }
+            for (const auto& ipv6 : event.nif.ipv6s) {
+                std::cout << "\t - " << ipv6.address << "\n";
+            }
+        }
+        std::cout << std::endl;
     }
 
+    //loss is share of announcements expected from sequence numbers that never arrived
+    void printLoss(const NeighborLoss& loss) {
+        std::uint64_t expected = loss.received + loss.lost;
+        double lossPercent = expected > 0 ? 100.0 * static_cast<double>(loss.lost) / static_cast<double>(expected) : 0.0;
+        double duplicatePercent = loss.received > 0 ? 100.0 * static_cast<double>(loss.duplicates) / static_cast<double>(loss.received) : 0.0;
+        std::cout << std::format("{}: received {}, lost {} ({:.1f}%), reordered {}, duplicates {} ({:.1f}%), restarts {}",
+            loss.sender, loss.received, loss.lost, lossPercent, loss.reordered, loss.duplicates, duplicatePercent, loss.restarts);
+        if (loss.epoch != 0) {
+            std::cout << std::format(", interval {}ms +-{}ms, epoch {:016x}", loss.intervalMs, loss.intervalJitterMs, loss.epoch);
+        }
+        std::cout << "\n";
+        if (!loss.macs.empty()) {
+            std::cout << "\t - " << loss.macs << "\n";
+        }
+    }
 
-    std::vector<std::uint8_t> buff{};
-    bool received = false;
-    auto start = std::chrono::steady_clock::now();
-    do {
-        std::vector<std::uint8_t> rbuff(Config::SINGLE_MESSAGE_MAX_SIZE_BYTES);
-        auto receiveReturn = client.receive(rbuff);
-        if (!receiveReturn.isOk()) {
-            std::cout << "Failed receiving on UNIX domain socket on " << Config::UNIX_DOMAIN_SOCKET_PATH << ": " << receiveReturn.msg.value() << std::endl;
-            return -1;
+    void printNeighbor(int index, const NetInterface& nif, const std::vector<std::string>& localMacs) {
+        std::string local = std::ranges::find(localMacs, nif.mac) == localMacs.end() ? "" : "LOCAL ";
+        std::cout << index << ") " << local << nif.mac << "\n";
+        std::cout << "\tSame subnet IPv4s: \n";
+        for (const auto& ipv4 : nif.ipv4s) {    
+            std::cout <<  "\t - " << ipv4.address << " (" << ipv4.netmask  << " netmask)" << "\n";
         }
-        if (rbuff.size() > 0) {
-            received = true;
-            buff = std::move(rbuff);
+        std::cout << "\tSame subnet IPv6s: \n";
+        for (const auto& ipv6 : nif.ipv6s) {    
+            std::cout <<  "\t - " << ipv6.address << " (" << static_cast<int>(ipv6.prefixLength) << " prefix length)" << "\n";
         }
-    } while (!received 
-        && std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now() - start).count() < Config::CLI_REQUEST_WAIT_TIME_SECONDS);
+    }
+}
 
-    if (!received) {
-        std::cout << "Couldn't receive data from daemon" << std::endl;
-        return -1;
+int main(int argc, char** argv) {
+    //socket option selects daemon started with other unix_domain_socket_path, e.g. by release training run
+    std::string socketPath = Config::UNIX_DOMAIN_SOCKET_PATH;
+    if (argc > 1 && std::string(argv[1]).starts_with("socket=")) {
+        socketPath = std::string(argv[1]).substr(std::string("socket=").size());
+        argv[1] = argv[0];
+        argc--;
+        argv++;
     }
 
-    auto desReturn = Deserializer::deserialize<NetInterface>(buff);
-    if (!desReturn.isOk()) {
-        std::cout << "Failed deserializing: " << desReturn.msg.value() << std::endl;
+    UnixRequest request = parseArguments(argc, argv);
+
+    //daemon may run with checksum_enabled off in its settings file, so responses without trailer are accepted
+    auto clientReturn = DiscoveryClient::connect(socketPath, false, Config::SINGLE_MESSAGE_MAX_SIZE_BYTES);
+    if (!clientReturn.isOk()) {
+        std::cout << clientReturn.message() << std::endl;
         return -1;
     }
+    auto client = std::move(clientReturn).value();
 
-    std::vector<NetInterface> neighbors = desReturn.data.value();
+    //daemon answers with error frame if it can't serve request
+    auto exchange = [&](const UnixRequest& request) {
+        auto responseReturn = client.request(request, std::chrono::seconds(Config::CLI_REQUEST_WAIT_TIME_SECONDS));
+        if (responseReturn.isOk() && responseReturn.value().error.has_value()) {
+            return Result<DiscoveryResponse>{Error{ErrorCode::Failed, "Daemon couldn't serve request:", responseReturn.value().error.value()}};
+        }
+        return responseReturn;
+    };
 
     auto nifsReturn = NetInterfaceManager::getInterfaces(); 
     if (!nifsReturn.isOk()) {
-        std::cout << "Couldn't check local network interfaces:" << nifsReturn.msg.value();
+        std::cout << "Couldn't check local network interfaces:" << nifsReturn.message();
     }
 
-    auto localMacs = nifsReturn.data.value() | std::ranges::views::transform([](const NetInterface& nif){ return nif.mac; });
+    std::vector<NetInterface> localNifs = nifsReturn.isOk() ? std::move(nifsReturn).value() : std::vector<NetInterface>{};
+    auto localMacsView = localNifs | std::ranges::views::transform([](const NetInterface& nif){ return nif.mac; });
+    std::vector<std::string> localMacs(localMacsView.begin(), localMacsView.end());
 
-    std::cout << "Current neighbors: \n";
-    int i = 0;
-    for (const auto& nif : neighbors) {
-        std::string local = std::ranges::find(localMacs, nif.mac) == localMacs.end() ? "" : "LOCAL ";
-        std::cout << ++i << ") " << local << nif.mac << "\n";
-        std::cout << "\tSame subnet IPv4s: \n";
-        for (const auto& ipv4 : nif.ipv4s) {    
-            std::cout <<  "\t - " << ipv4.address << " (" << ipv4.netmask  << " netmask)" << "\n";
+    //pages are requested over the same connection and printed as they arrive, only one of them is held at a time
+    if (request.command == Config::UNIX_DOMAIN_PAGE_COMMAND) {
+        std::cout << "Current neighbors: \n";
+        int i = 0;
+        std::optional<std::uint64_t> generation{};
+        bool changed = false;
+        do {
+            auto exchangeReturn = exchange(request);
+            if (!exchangeReturn.isOk()) {
+                std::cout << exchangeReturn.message() << std::endl;
+                return -1;
+            }
+
+            auto& response = exchangeReturn.value();
+            auto pageReturn = NeighborPage::deserialize(response.buff, response.offset);
+            if (!pageReturn.isOk()) {
+                std::cout << "Failed deserializing: " << pageReturn.message() << std::endl;
+                return -1;
+            }
+
+            const NeighborPage& page = pageReturn.value();
+            changed = changed || (generation.has_value() && generation.value() != page.generation);
+            generation = page.generation;
+            for (const auto& nif : page.neighbors) {
+                printNeighbor(++i, nif, localMacs);
+            }
+            request.options["after"] = page.cursor;
+        } while (!request.options["after"].empty());
+
+        if (changed) {
+            std::cout << "Neighbor table changed while it was being listed\n";
         }
-        std::cout << "\tSame subnet IPv6s: \n";
-        for (const auto& ipv6 : nif.ipv6s) {    
-            std::cout <<  "\t - " << ipv6.address << " (" << static_cast<int>(ipv6.prefixLength) << " prefix length)" << "\n";
+        std::cout << std::endl;
+        return 0;
+    }
+
+    auto exchangeReturn = exchange(request);
+    if (!exchangeReturn.isOk()) {
+        std::cout << exchangeReturn.message() << std::endl;
+        return -1;
+    }
+    auto& buff = exchangeReturn.value().buff;
+    std::size_t offset = exchangeReturn.value().offset;
+
+    if (request.command == Config::UNIX_DOMAIN_SHARDS_COMMAND) {
+        auto digestsReturn = Deserializer::deserialize<ShardDigest>(buff, offset);
+        if (!digestsReturn.isOk()) {
+            std::cout << "Failed deserializing: " << digestsReturn.message() << std::endl;
+            return -1;
+        }
+        std::cout << "Multicast shards: \n";
+        for (const auto& digest : digestsReturn.value()) {
+            std::cout << std::format("{}) {} members, digest {:016x}", digest.shard, digest.members, digest.digest) << "\n";
+        }
+        std::cout << std::endl;
+        return 0;
+    }
+
+    if (request.command == Config::UNIX_DOMAIN_LOSS_COMMAND) {
+        auto reportReturn = LossReport::deserialize(buff, offset);
+        if (!reportReturn.isOk()) {
+            std::cout << "Failed deserializing: " << reportReturn.message() << std::endl;
+            return -1;
+        }
+        const auto& report = reportReturn.value();
+        std::cout << "Announcement loss: \n";
+        for (const auto& loss : report.senders) {
+            printLoss(loss);
+        }
+        printLoss(report.total);
+        std::cout << std::format("Datagrams dropped by kernel on full receive queues of this daemon: {}", report.kernelDrops) << std::endl;
+        return 0;
+    }
+
+    if (request.command == Config::UNIX_DOMAIN_LATENCY_COMMAND) {
+        auto latenciesReturn = Deserializer::deserialize<NeighborLatency>(buff, offset);
+        if (!latenciesReturn.isOk()) {
+            std::cout << "Failed deserializing: " << latenciesReturn.message() << std::endl;
+            return -1;
+        }
+        std::cout << "Neighbor latency: \n";
+        for (const auto& latency : latenciesReturn.value()) {
+            if (latency.samples == 0) {
+                std::cout << std::format("{} not measured yet, loss {:.1f}%", latency.mac, latency.lossPermille / 10.0) << "\n";
+                continue;
+            }
+            std::cout << std::format("{} rtt {}us, jitter {}us, p50/p90/p99 {}/{}/{}us, loss {:.1f}%, {} samples",
+                latency.mac, latency.smoothedRttUs, latency.jitterUs, latency.p50RttUs, latency.p90RttUs, latency.p99RttUs,
+                latency.lossPermille / 10.0, latency.samples) << "\n";
+        }
+        std::cout << std::endl;
+        return 0;
+    }
+
+    if (request.command == Config::UNIX_DOMAIN_RELOAD_COMMAND) {
+        auto statusReturn = Deserializer::deserialize(buff, offset);
+        if (!statusReturn.isOk()) {
+            std::cout << "Failed deserializing: " << statusReturn.message() << std::endl;
+            return -1;
+        }
+        std::cout << statusReturn.value() << std::endl;
+        return 0;
+    }
+
+    if (request.command == Config::UNIX_DOMAIN_EVENTS_COMMAND) {
+        auto eventsReturn = Deserializer::deserialize<JournalEvent>(buff, offset);
+        if (!eventsReturn.isOk()) {
+            std::cout << "Failed deserializing: " << eventsReturn.message() << std::endl;
+            return -1;
         }
+        printEvents(eventsReturn.value());
+        return 0;
+    }
+
+    auto desReturn = Deserializer::deserialize<NetInterface>(buff, offset);
+    if (!desReturn.isOk()) {
+        std::cout << "Failed deserializing: " << desReturn.message() << std::endl;
+        return -1;
+    }
+
+    std::cout << "Current neighbors: \n";
+    int i = 0;
+    for (const auto& nif : desReturn.value()) {
+        printNeighbor(++i, nif, localMacs);
     }
     std::cout << std::endl;
 
     return 0;
-}
\ No newline at end of file
+}
@@ -2,42 +2,135 @@
 #include "include/Config/Config.hpp"
 #include "include/Logging/StdLogger.hpp"
 #include "include/Network/NetworkNeighborDiscoverer.hpp"
+#include "include/Network/DaemonHandoff.hpp"
 #include "include/Network/DiscoverySettings.hpp"
 #include "include/Unix/UnixDomainSettings.hpp"
 #include "include/Processes/Process.hpp"
+#include "include/Config/SettingsFile.hpp"
 
 #include <functional>
+#include <filesystem>
+#include <string>
+#include <optional>
+#include <format>
 
 using Logging::StdLogger;
 using Network::DiscoverySettings;
 using Unix::UnixDomainSettings;
 using Network::NetworkNeighborDiscoverer;
+using Network::DaemonHandoff;
+using Network::HandoffState;
 using Processes::Process;
+using Config::SettingsFile;
 
-int main() {
+int main(int argc, char** argv) {
     auto logger = Logging::StdLogger::getInstance();
     
     //used for comm with other daemons over net
     DiscoverySettings netSettings;
     netSettings.port = Config::PORT;
+    netSettings.shardCount = Config::MULTICAST_SHARD_COUNT;
+    netSettings.subscribedShards = Config::MULTICAST_SUBSCRIBED_SHARDS;
     netSettings.sendingPeriodS = Config::SENDING_PERIOD_SECONDS;
     netSettings.neighborActivityPeriodS = Config::NEIGHBOR_ACTIVITY_PERIOD_SECONDS;
+    netSettings.solicitResponseMaxDelayMs = Config::SOLICIT_RESPONSE_MAX_DELAY_MILLISECONDS;
+    netSettings.solicitResponseMinIntervalMs = Config::SOLICIT_RESPONSE_MIN_INTERVAL_MILLISECONDS;
     netSettings.maxBufferSize = Config::SINGLE_MESSAGE_MAX_SIZE_BYTES;
+    netSettings.useChecksum = Config::CHECKSUM_ENABLED;
+    netSettings.useSocketFilter = Config::SOCKET_FILTER_ENABLED;
+    netSettings.receiveBufferSize = Config::SOCKET_RECEIVE_BUFFER_BYTES;
+    netSettings.maxReceiveBufferSize = Config::SOCKET_RECEIVE_BUFFER_MAX_BYTES;
+    netSettings.sendBufferSize = Config::SOCKET_SEND_BUFFER_BYTES;
+    netSettings.receiveWorkers = Config::RECEIVE_WORKER_COUNT;
+    netSettings.useIoUring = Config::IO_URING_ENABLED;
+    netSettings.ioUringQueueDepth = Config::IO_URING_QUEUE_DEPTH;
+    netSettings.ioUringReceiveBuffers = Config::IO_URING_RECEIVE_BUFFERS;
+    netSettings.probePeriodMs = Config::PROBE_PERIOD_MILLISECONDS;
+    netSettings.probeMaxPerSecond = Config::PROBE_MAX_PER_SECOND;
+    netSettings.probeTimeoutMs = Config::PROBE_TIMEOUT_MILLISECONDS;
+    netSettings.probeReplyMaxPerSecond = Config::PROBE_REPLY_MAX_PER_SECOND;
+    netSettings.compressionThreshold = Config::COMPRESSION_THRESHOLD_BYTES;
+    netSettings.snapshotPath = Config::SNAPSHOT_PATH;
+    netSettings.snapshotPeriodS = Config::SNAPSHOT_PERIOD_SECONDS;
+    netSettings.journalDirectory = Config::JOURNAL_DIRECTORY;
+    netSettings.journalSegmentSize = Config::JOURNAL_SEGMENT_SIZE_BYTES;
+    netSettings.journalMaxSegments = Config::JOURNAL_MAX_SEGMENTS;
+    netSettings.handoffSocketPath = Config::HANDOFF_SOCKET_PATH;
+    netSettings.handoffTimeoutMs = Config::HANDOFF_TIMEOUT_MILLISECONDS;
 
     //used for comm with cli
     UnixDomainSettings localCommSettings;
     localCommSettings.requestString = Config::UNIX_DOMAIN_REQUEST_COMMAND;
+    localCommSettings.eventsRequestString = Config::UNIX_DOMAIN_EVENTS_COMMAND;
+    localCommSettings.shardsRequestString = Config::UNIX_DOMAIN_SHARDS_COMMAND;
+    localCommSettings.latencyRequestString = Config::UNIX_DOMAIN_LATENCY_COMMAND;
+    localCommSettings.lossRequestString = Config::UNIX_DOMAIN_LOSS_COMMAND;
+    localCommSettings.pageRequestString = Config::UNIX_DOMAIN_PAGE_COMMAND;
+    localCommSettings.reloadRequestString = Config::UNIX_DOMAIN_RELOAD_COMMAND;
+    localCommSettings.maxPageSize = Config::UNIX_DOMAIN_MAX_PAGE_SIZE;
+    localCommSettings.pageScanLimit = Config::UNIX_DOMAIN_PAGE_SCAN_LIMIT;
+    localCommSettings.maxRequestSize = Config::UNIX_DOMAIN_MAX_REQUEST_BYTES;
+    localCommSettings.requestTimeoutMs = Config::UNIX_DOMAIN_REQUEST_TIMEOUT_MILLISECONDS;
+    localCommSettings.idleTimeoutS = Config::UNIX_DOMAIN_IDLE_TIMEOUT_SECONDS;
     localCommSettings.maxBufferSize = Config::SINGLE_MESSAGE_MAX_SIZE_BYTES;
     localCommSettings.socketPath = Config::UNIX_DOMAIN_SOCKET_PATH;
+    localCommSettings.useChecksum = Config::CHECKSUM_ENABLED;
+    localCommSettings.compressionThreshold = Config::COMPRESSION_THRESHOLD_BYTES;
 
-    NetworkNeighborDiscoverer discoverer{logger, netSettings, localCommSettings};
+    //settings file is optional, compiled settings are used without it
+    unsigned int iterationPeriodS = Config::ITERATION_PERIOD_SECONDS;
+    std::string settingsPath = argc > 1 ? argv[1] : Config::SETTINGS_FILE_PATH;
+    if (std::filesystem::exists(settingsPath)) {
+        auto loadReturn = SettingsFile::load(settingsPath, netSettings, localCommSettings, iterationPeriodS);
+        if (!loadReturn.isOk()) {
+            logger->error(loadReturn.message());
+            return -1;
+        }
+        logger->info("Loaded settings from " + settingsPath);
+    } else {
+        logger->info("No settings file at " + settingsPath + ", using compiled settings");
+    }
+
+    //running daemon hands over its sockets and neighbor table, one that refused or failed keeps them, so this one doesn't start next to it
+    std::optional<HandoffState> handoff{};
+    if (!netSettings.handoffSocketPath.empty()) {
+        auto handoffReturn = DaemonHandoff::request(netSettings, localCommSettings);
+        if (!handoffReturn.isOk()) {
+            logger->error("Handoff from running daemon failed: " + handoffReturn.message());
+            return -1;
+        }
+        handoff = std::move(handoffReturn).value();
+        if (handoff.has_value()) {
+            logger->info(std::format("Running daemon handed over {} sockets", handoff->descriptorCount()));
+        }
+    }
+
+    NetworkNeighborDiscoverer discoverer{logger, netSettings, localCommSettings, std::move(handoff)};
 
     Process& process = 
-        Process::create(true, Config::ITERATION_PERIOD_SECONDS, Config::STD_REDIRECT_PATH, std::bind(&NetworkNeighborDiscoverer::runIteration, &discoverer));
+        Process::create(true, iterationPeriodS, Config::STD_REDIRECT_PATH, std::bind(&NetworkNeighborDiscoverer::runIteration, &discoverer));
+
+    //SIGHUP or CLI reload command rereads file, tunables change without dropping neighbor table
+    discoverer.setSettingsLoader([&process, settingsPath, iterationPeriodS](DiscoverySettings& netSettings, UnixDomainSettings& localCommSettings) mutable {
+        auto loadReturn = SettingsFile::load(settingsPath, netSettings, localCommSettings, iterationPeriodS);
+        if (loadReturn.isOk()) {
+            process.setIterationPeriod(iterationPeriodS);
+        }
+        return loadReturn;
+    });
+
+    //SIGTERM or SIGINT ends run loop, so destructors close sockets and stop worker threads
+    discoverer.setStopHandler([&process]() {
+        process.stop();
+    });
+
+    //reacts to datagrams, solicitations and CLI requests between iterations instead of sleeping
+    process.setWaitFunction(std::bind(&NetworkNeighborDiscoverer::waitForEvents, &discoverer, std::placeholders::_1));
 
     process.daemonize();
     logger->info("Service started");
     process.run();
+    logger->info("Service stopped");
 
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,166 @@
+#include "include/Config/Config.hpp"
+#include "include/Network/NetInterfaces/NetInterface.hpp"
+#include "include/Network/NetInterfaces/IPv4Info.hpp"
+#include "include/Network/NetInterfaces/IPv6Info.hpp"
+#include "include/Network/NetInterfaces/NetInterfaceManager.hpp"
+#include "include/Network/Sockets/IPMulticastSender.hpp"
+#include "include/Network/Sockets/Constants/IPAddresses.hpp"
+#include "include/Network/Protocol/Frame.hpp"
+#include "include/Utility/Serialization/Serializer.hpp"
+
+#include <arpa/inet.h>
+#include <net/if.h>
+#include <unistd.h>
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <optional>
+#include <cstdint>
+#include <format>
+
+using Network::NetInterfaces::NetInterface;
+using Network::NetInterfaces::IPv4Info;
+using Network::NetInterfaces::IPv6Info;
+using Network::NetInterfaces::NetInterfaceManager;
+using Network::Sockets::IPMulticastSender;
+using Network::Sockets::Constants::IPAddresses;
+using Network::Protocol::Frame;
+using Utility::Serialization::Serializer;
+
+//training workload of release build (see Makefile.release), not installed
+//announces synthetic neighbors over multicast of local interfaces, looped back copies reach daemon on the same host
+//every frame goes out over IPv4 and IPv6, so daemon also sees duplicates it has to recognize
+namespace {
+    constexpr unsigned int ROUND_PERIOD_MILLISECONDS = 50u;
+
+    //neighbor address inside subnet of local address, so daemon accepts it
+    std::optional<IPv4Info> localSubnetIPv4(const IPv4Info& local, unsigned int host) {
+        ::in_addr address{};
+        ::in_addr mask{};
+        if (::inet_pton(AF_INET, local.address.c_str(), &address) != 1 || ::inet_pton(AF_INET, local.netmask.c_str(), &mask) != 1) {
+            return std::nullopt;
+        }
+        std::uint32_t hostMask = ~ntohl(mask.s_addr);
+        if (hostMask < 4) {
+            return std::nullopt;
+        }
+        address.s_addr = htonl((ntohl(address.s_addr) & ~hostMask) | (1 + host % (hostMask - 1)));
+
+        char text[INET_ADDRSTRLEN]{};
+        ::inet_ntop(AF_INET, &address, text, sizeof(text));
+        return IPv4Info{text, local.netmask};
+    }
+
+    std::optional<IPv6Info> localSubnetIPv6(const IPv6Info& local, unsigned int host) {
+        ::in6_addr address{};
+        if (local.prefixLength > 112 || ::inet_pton(AF_INET6, local.address.substr(0, local.address.find('%')).c_str(), &address) != 1) {
+            return std::nullopt;
+        }
+        address.s6_addr[14] = static_cast<std::uint8_t>((host >> 8) & 0xFFu);
+        address.s6_addr[15] = static_cast<std::uint8_t>(host & 0xFFu);
+
+        char text[INET6_ADDRSTRLEN]{};
+        ::inet_ntop(AF_INET6, &address, text, sizeof(text));
+        return IPv6Info{text, local.prefixLength};
+    }
+
+    //mixes neighbors daemon accepts with ones it filters out, a few move to other address every round
+    std::vector<NetInterface> neighbors(const std::vector<NetInterface>& localNifs, unsigned int count, unsigned int round) {
+        std::vector<NetInterface> nifs{};
+        for (unsigned int i = 0; i < count; i++) {
+            NetInterface nif{};
+            nif.name = std::format("train{}", i % 4);
+            nif.mac = std::format("02:50:47:{:02x}:{:02x}:{:02x}", (i >> 16) & 0xFFu, (i >> 8) & 0xFFu, i & 0xFFu);
+
+            unsigned int host = i % 7 == 0 ? 100 + i + round : 100 + i;
+            for (const auto& local : localNifs) {
+                for (const auto& ipv4 : local.ipv4s) {
+                    auto synthetic = localSubnetIPv4(ipv4, host);
+                    if (synthetic.has_value()) {
+                        nif.ipv4s.push_back(std::move(synthetic.value()));
+                    }
+                }
+                if (i % 3 == 0) {
+                    for (const auto& ipv6 : local.ipv6s) {
+                        auto synthetic = localSubnetIPv6(ipv6, host);
+                        if (synthetic.has_value()) {
+                            nif.ipv6s.push_back(std::move(synthetic.value()));
+                        }
+                    }
+                }
+            }
+            if (i % 5 == 0) {
+                nif.ipv4s.push_back(IPv4Info{std::format("198.51.100.{}", i % 250 + 1), "255.255.255.0"});
+            }
+            nifs.push_back(std::move(nif));
+        }
+        return nifs;
+    }
+}
+
+//usage: cpp_training_traffic.out [port] [neighbors] [rounds]
+//training daemon listens on its own port, so daemons running on the host don't pick synthetic neighbors up
+int main(int argc, char** argv) {
+    std::uint16_t port = argc > 1 ? static_cast<std::uint16_t>(std::stoul(argv[1])) : Config::PORT;
+    unsigned int count = argc > 2 ? static_cast<unsigned int>(std::stoul(argv[2])) : 64u;
+    unsigned int rounds = argc > 3 ? static_cast<unsigned int>(std::stoul(argv[3])) : 200u;
+
+    auto nifsReturn = NetInterfaceManager::getInterfaces();
+    if (!nifsReturn.isOk()) {
+        std::cout << "Couldn't retrieve local network interfaces: " << nifsReturn.message() << std::endl;
+        return -1;
+    }
+    std::vector<NetInterface> localNifs = std::move(nifsReturn).value();
+
+    auto ipv4Return = IPMulticastSender<::sockaddr_in>::factory();
+    auto ipv6Return = IPMulticastSender<::sockaddr_in6>::factory();
+    if (!ipv4Return.isOk() || !ipv6Return.isOk()) {
+        std::cout << "Couldn't create sender sockets: " << ipv4Return.message() << ipv6Return.message() << std::endl;
+        return -1;
+    }
+    auto ipv4sender = std::move(ipv4Return).value();
+    auto ipv6sender = std::move(ipv6Return).value();
+    for (const auto& nif : localNifs) {
+        unsigned int ifindex = ::if_nametoindex(nif.name.c_str());
+        if (!nif.ipv4s.empty()) {
+            auto addReturn = ipv4sender.addMulticastAddress(IPAddresses::IPv4CustomMulticast, port, ifindex);
+            if (!addReturn.isOk()) {
+                std::cout << addReturn.message() << std::endl;
+            }
+        }
+        if (!nif.ipv6s.empty()) {
+            auto addReturn = ipv6sender.addMulticastAddress(IPAddresses::IPv6CustomMulticast, port, ifindex);
+            if (!addReturn.isOk()) {
+                std::cout << addReturn.message() << std::endl;
+            }
+        }
+    }
+
+    std::uint32_t sequence = 1;
+    for (unsigned int round = 0; round < rounds; round++) {
+        std::vector<std::uint8_t> frame{};
+        Frame::reserveHeader(frame);
+        Serializer::serialize<NetInterface>(frame, neighbors(localNifs, count, round));
+        auto type = round % 10 == 0 ? Frame::MessageType::Solicitation : Frame::MessageType::Announcement;
+        //every 16th announcement is never sent, so daemon counts gaps
+        if (round % 16 == 15) {
+            sequence++;
+        }
+        Frame::seal(frame, Config::CHECKSUM_ENABLED, round % 2 == 0 ? Config::COMPRESSION_THRESHOLD_BYTES : 0, type, sequence++);
+
+        //failures are ignored, interfaces without multicast route just don't carry training traffic
+        (void)ipv4sender.send(frame);
+        (void)ipv6sender.send(frame);
+
+        //corrupted copy has to be rejected by checksum
+        if (round % 8 == 0 && frame.size() > Frame::HEADER_SIZE) {
+            frame[Frame::HEADER_SIZE] ^= 0xFFu;
+            (void)ipv4sender.send(frame);
+        }
+
+        ::usleep(ROUND_PERIOD_MILLISECONDS * 1000u);
+    }
+
+    return 0;
+}
@@ -8,15 +8,54 @@ namespace Config {
     static constexpr std::uint16_t PORT = 5320u;
     static constexpr char MULTICAST_IPV4[] = "239.1.1.1"; //239.0.0.0 subnet
     static constexpr char MULTICAST_IPV6[] = "ff02::100"; //ff02:/16 prefix
-    static constexpr unsigned int SENDING_PERIOD_SECONDS = 30u;
+    static constexpr unsigned int MULTICAST_SHARD_COUNT = 1u; //above 1 interfaces announce into one of consecutive groups starting at MULTICAST_IPV4/IPV6 by MAC hash, next group carries shard digests
+    static constexpr char MULTICAST_SUBSCRIBED_SHARDS[] = ""; //comma separated shards to receive announcements from, "" receives all
+    static constexpr unsigned int SENDING_PERIOD_SECONDS = 30u; //own interfaces are announced that often, changes right away
     static constexpr unsigned int NEIGHBOR_ACTIVITY_PERIOD_SECONDS = 30u;
+    static constexpr unsigned int SOLICIT_RESPONSE_MAX_DELAY_MILLISECONDS = 250u; //answers to solicitations are randomly delayed to avoid bursts
+    static constexpr unsigned int SOLICIT_RESPONSE_MIN_INTERVAL_MILLISECONDS = 1000u; //at most one answer per interval
     static constexpr unsigned int SINGLE_MESSAGE_MAX_SIZE_BYTES = 12800u;
+    static constexpr bool CHECKSUM_ENABLED = true; //CRC32C trailer on sent frames, received frames with invalid one are dropped, ones without it are accepted
+    static constexpr bool SOCKET_FILTER_ENABLED = true; //kernel BPF filter drops foreign and own looped back datagrams before they reach daemon
+    static constexpr unsigned int SOCKET_RECEIVE_BUFFER_BYTES = 0u; //multicast receive queue size, 0 keeps kernel default, above net.core.rmem_max only with CAP_NET_ADMIN
+    static constexpr unsigned int SOCKET_RECEIVE_BUFFER_MAX_BYTES = 8u * 1024u * 1024u; //receive queues double up to it while kernel reports dropped datagrams
+    static constexpr unsigned int SOCKET_SEND_BUFFER_BYTES = 0u; //0 keeps kernel default
+    static constexpr unsigned int RECEIVE_WORKER_COUNT = 0u; //above 0 datagrams are received and decoded by that many threads on SO_REUSEPORT sockets, split by origin with BPF filters
+    static constexpr bool IO_URING_ENABLED = true; //multicast and UNIX domain I/O goes through io_uring, poll() is used if kernel doesn't support it
+    static constexpr unsigned int IO_URING_QUEUE_DEPTH = 64u;
+    static constexpr unsigned int IO_URING_RECEIVE_BUFFERS = 64u; //power of two, each holds one datagram of SINGLE_MESSAGE_MAX_SIZE_BYTES
+    static constexpr char SNAPSHOT_PATH[] = "/tmp/cppneighbordiscovery.snapshot"; //make "" empty to disable neighbor table persistence
+    static constexpr unsigned int SNAPSHOT_PERIOD_SECONDS = 60u; //snapshot is also written whenever neighbor table changes
+    static constexpr char JOURNAL_DIRECTORY[] = "/tmp/cppneighbordiscovery.journal"; //make "" empty to disable neighbor event journal
+    static constexpr unsigned int JOURNAL_SEGMENT_SIZE_BYTES = 4u * 1024u * 1024u;
+    static constexpr unsigned int JOURNAL_MAX_SEGMENTS = 16u;
+    static constexpr unsigned int PROBE_PERIOD_MILLISECONDS = 0u; //above 0 every neighbor gets unicast echo probe this often to measure RTT, jitter and loss, 0 disables probing
+    static constexpr unsigned int PROBE_MAX_PER_SECOND = 20u; //probe budget over all neighbors, large tables are probed less often than period
+    static constexpr unsigned int PROBE_TIMEOUT_MILLISECONDS = 1000u; //unanswered probe counts as lost
+    static constexpr unsigned int PROBE_REPLY_MAX_PER_SECOND = 200u; //probes of other daemons are answered even with probing disabled, above this rate they are dropped
+    static constexpr unsigned int COMPRESSION_THRESHOLD_BYTES = 1024u; //payloads above are LZ compressed if receivers support it, 0 disables
 
     static constexpr char UNIX_DOMAIN_REQUEST_COMMAND[] = "request";
+    static constexpr char UNIX_DOMAIN_ACCEPT_OPTION[] = "accept"; //value "lz" lets daemon compress response
+    static constexpr char UNIX_DOMAIN_EVENTS_COMMAND[] = "events"; //options from/to (ms since epoch) select time range of journal events
+    static constexpr char UNIX_DOMAIN_SHARDS_COMMAND[] = "shards";
+    static constexpr char UNIX_DOMAIN_LOSS_COMMAND[] = "loss"; //announcement sequence statistics per sender and in total, with kernel drops of own sockets
+    static constexpr char UNIX_DOMAIN_LATENCY_COMMAND[] = "latency"; //probe measurements of every probed neighbor, neighbor list takes rtt=MS option to select by smoothed RTT
+    static constexpr char UNIX_DOMAIN_RELOAD_COMMAND[] = "reload"; //daemon rereads settings file, same as on SIGHUP
+    static constexpr char UNIX_DOMAIN_PAGE_COMMAND[] = "page"; //options after (cursor of previous page) and limit, takes same query options as neighbor list
+    static constexpr unsigned int UNIX_DOMAIN_MAX_PAGE_SIZE = 1000u; //larger limits are lowered to it
+    static constexpr unsigned int UNIX_DOMAIN_PAGE_SCAN_LIMIT = 10000u; //page ends early once that many neighbors were checked, so sparse queries don't hold up daemon
     static constexpr char UNIX_DOMAIN_SOCKET_PATH[] = "/tmp/cppneigbhordiscovery.sock";
+    static constexpr unsigned int UNIX_DOMAIN_MAX_REQUEST_BYTES = 256u;
+    static constexpr unsigned int UNIX_DOMAIN_REQUEST_TIMEOUT_MILLISECONDS = 1000u; //connected client that sends no request or reads no response in time is dropped
+    static constexpr unsigned int UNIX_DOMAIN_IDLE_TIMEOUT_SECONDS = 60u; //persistent client connection without further requests is closed after that
+    static constexpr char HANDOFF_SOCKET_PATH[] = "/tmp/cppneighbordiscovery.handoff.sock"; //started daemon takes sockets and neighbor table over from daemon running with the same path, "" disables
+    static constexpr unsigned int HANDOFF_TIMEOUT_MILLISECONDS = 2000u; //started daemon exits if running one doesn't answer in time, same as when it refuses
     
     static constexpr unsigned int CLI_REQUEST_WAIT_TIME_SECONDS = 10u;
+    static constexpr unsigned int CLI_PAGE_SIZE = 500u; //neighbor list is fetched page by page, so CLI memory doesn't grow with table
 
+    static constexpr char SETTINGS_FILE_PATH[] = "/etc/cppneighbordiscovery.conf"; //overrides settings above if present, daemon takes other path as first argument
     static constexpr char STD_REDIRECT_PATH[] = "/tmp/cppneighbordiscovery.log"; //make "" empty to redirect to std::cout
     static unsigned int ITERATION_PERIOD_SECONDS = 20u;
 }
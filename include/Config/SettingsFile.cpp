@@ -0,0 +1,161 @@
+#include "SettingsFile.hpp"
+
+#include "File/FileReader.hpp"
+#include "Utility/Result.hpp"
+
+#include <string>
+#include <sstream>
+#include <functional>
+#include <unordered_map>
+#include <limits>
+#include <format>
+
+using Config::SettingsFile;
+using File::FileReader;
+using Utility::Result;
+using Utility::Error;
+using Utility::ErrorCode;
+
+namespace {
+    std::string trim(const std::string& text) {
+        auto first = text.find_first_not_of(" \t\r");
+        if (first == std::string::npos) {
+            return "";
+        }
+        auto last = text.find_last_not_of(" \t\r");
+        return text.substr(first, last - first + 1);
+    }
+
+    template<typename T>
+    Result<> parseUnsigned(const std::string& text, T& value) {
+        try {
+            std::size_t parsed = 0;
+            unsigned long long number = std::stoull(text, &parsed);
+            if (parsed != text.size() || text.starts_with('-') || number > std::numeric_limits<T>::max()) {
+                return Error{ErrorCode::Failed, "Expected number in range, got", "\"" + text + "\""};
+            }
+            value = static_cast<T>(number);
+        } catch (const std::exception&) {
+            return Error{ErrorCode::Failed, "Expected number, got", "\"" + text + "\""};
+        }
+        return Result<>{};
+    }
+
+    Result<> parseBool(const std::string& text, bool& value) {
+        if (text == "true" || text == "1") {
+            value = true;
+        } else if (text == "false" || text == "0") {
+            value = false;
+        } else {
+            return Error{ErrorCode::Failed, "Expected true or false, got", "\"" + text + "\""};
+        }
+        return Result<>{};
+    }
+
+    struct Targets {
+        DiscoverySettings& net;
+        UnixDomainSettings& local;
+        unsigned int& iterationPeriodS;
+    };
+
+    using Setter = std::function<Result<>(const std::string&, Targets&)>;
+
+    const std::unordered_map<std::string, Setter>& setters() {
+        static const std::unordered_map<std::string, Setter> table{
+            {"port", [](const std::string& v, Targets& t){ return parseUnsigned(v, t.net.port); }},
+            {"multicast_shard_count", [](const std::string& v, Targets& t){ return parseUnsigned(v, t.net.shardCount); }},
+            {"multicast_subscribed_shards", [](const std::string& v, Targets& t){ t.net.subscribedShards = v; return Result<>{}; }},
+            {"sending_period_seconds", [](const std::string& v, Targets& t){ return parseUnsigned(v, t.net.sendingPeriodS); }},
+            {"neighbor_activity_period_seconds", [](const std::string& v, Targets& t){ return parseUnsigned(v, t.net.neighborActivityPeriodS); }},
+            {"solicit_response_max_delay_milliseconds", [](const std::string& v, Targets& t){ return parseUnsigned(v, t.net.solicitResponseMaxDelayMs); }},
+            {"solicit_response_min_interval_milliseconds", [](const std::string& v, Targets& t){ return parseUnsigned(v, t.net.solicitResponseMinIntervalMs); }},
+            //one message size limits both multicast datagrams and CLI responses
+            {"single_message_max_size_bytes", [](const std::string& v, Targets& t){
+                auto funcReturn = parseUnsigned(v, t.net.maxBufferSize);
+                t.local.maxBufferSize = t.net.maxBufferSize;
+                return funcReturn;
+            }},
+            {"checksum_enabled", [](const std::string& v, Targets& t){
+                auto funcReturn = parseBool(v, t.net.useChecksum);
+                t.local.useChecksum = t.net.useChecksum;
+                return funcReturn;
+            }},
+            {"socket_filter_enabled", [](const std::string& v, Targets& t){ return parseBool(v, t.net.useSocketFilter); }},
+            {"socket_receive_buffer_bytes", [](const std::string& v, Targets& t){ return parseUnsigned(v, t.net.receiveBufferSize); }},
+            {"socket_receive_buffer_max_bytes", [](const std::string& v, Targets& t){ return parseUnsigned(v, t.net.maxReceiveBufferSize); }},
+            {"socket_send_buffer_bytes", [](const std::string& v, Targets& t){ return parseUnsigned(v, t.net.sendBufferSize); }},
+            {"receive_worker_count", [](const std::string& v, Targets& t){ return parseUnsigned(v, t.net.receiveWorkers); }},
+            {"io_uring_enabled", [](const std::string& v, Targets& t){ return parseBool(v, t.net.useIoUring); }},
+            {"io_uring_queue_depth", [](const std::string& v, Targets& t){ return parseUnsigned(v, t.net.ioUringQueueDepth); }},
+            {"io_uring_receive_buffers", [](const std::string& v, Targets& t){ return parseUnsigned(v, t.net.ioUringReceiveBuffers); }},
+            {"probe_period_milliseconds", [](const std::string& v, Targets& t){ return parseUnsigned(v, t.net.probePeriodMs); }},
+            {"probe_max_per_second", [](const std::string& v, Targets& t){ return parseUnsigned(v, t.net.probeMaxPerSecond); }},
+            {"probe_timeout_milliseconds", [](const std::string& v, Targets& t){ return parseUnsigned(v, t.net.probeTimeoutMs); }},
+            {"probe_reply_max_per_second", [](const std::string& v, Targets& t){ return parseUnsigned(v, t.net.probeReplyMaxPerSecond); }},
+            {"compression_threshold_bytes", [](const std::string& v, Targets& t){
+                auto funcReturn = parseUnsigned(v, t.net.compressionThreshold);
+                t.local.compressionThreshold = t.net.compressionThreshold;
+                return funcReturn;
+            }},
+            {"snapshot_path", [](const std::string& v, Targets& t){ t.net.snapshotPath = v; return Result<>{}; }},
+            {"snapshot_period_seconds", [](const std::string& v, Targets& t){ return parseUnsigned(v, t.net.snapshotPeriodS); }},
+            {"journal_directory", [](const std::string& v, Targets& t){ t.net.journalDirectory = v; return Result<>{}; }},
+            {"journal_segment_size_bytes", [](const std::string& v, Targets& t){ return parseUnsigned(v, t.net.journalSegmentSize); }},
+            {"journal_max_segments", [](const std::string& v, Targets& t){ return parseUnsigned(v, t.net.journalMaxSegments); }},
+            {"handoff_socket_path", [](const std::string& v, Targets& t){ t.net.handoffSocketPath = v; return Result<>{}; }},
+            {"handoff_timeout_milliseconds", [](const std::string& v, Targets& t){ return parseUnsigned(v, t.net.handoffTimeoutMs); }},
+            {"unix_domain_socket_path", [](const std::string& v, Targets& t){ t.local.socketPath = v; return Result<>{}; }},
+            {"unix_domain_max_request_bytes", [](const std::string& v, Targets& t){ return parseUnsigned(v, t.local.maxRequestSize); }},
+            {"unix_domain_request_timeout_milliseconds", [](const std::string& v, Targets& t){ return parseUnsigned(v, t.local.requestTimeoutMs); }},
+            {"unix_domain_idle_timeout_seconds", [](const std::string& v, Targets& t){ return parseUnsigned(v, t.local.idleTimeoutS); }},
+            {"unix_domain_max_page_size", [](const std::string& v, Targets& t){ return parseUnsigned(v, t.local.maxPageSize); }},
+            {"unix_domain_page_scan_limit", [](const std::string& v, Targets& t){ return parseUnsigned(v, t.local.pageScanLimit); }},
+            {"iteration_period_seconds", [](const std::string& v, Targets& t){ return parseUnsigned(v, t.iterationPeriodS); }}
+        };
+        return table;
+    }
+}
+
+Result<> SettingsFile::load(const std::string& path, DiscoverySettings& netSettings, UnixDomainSettings& localSettings, unsigned int& iterationPeriodS) {
+    auto readReturn = FileReader(path).read();
+    if (!readReturn.isOk()) {
+        return readReturn.within("Couldn't read settings file");
+    }
+
+    //parsed into copies, so invalid file leaves settings untouched
+    DiscoverySettings net = netSettings;
+    UnixDomainSettings local = localSettings;
+    unsigned int periodS = iterationPeriodS;
+    Targets targets{net, local, periodS};
+
+    const auto& bytes = readReturn.value();
+    std::istringstream stream(std::string(bytes.begin(), bytes.end()));
+    std::string line;
+    for (unsigned int lineNumber = 1; std::getline(stream, line); lineNumber++) {
+        line = trim(line.substr(0, line.find('#')));
+        if (line.empty()) {
+            continue;
+        }
+
+        auto separator = line.find('=');
+        if (separator == std::string::npos) {
+            return Error{ErrorCode::Failed, "Expected key = value at", std::format("{}:{}", path, lineNumber)};
+        }
+        std::string key = trim(line.substr(0, separator));
+        std::string value = trim(line.substr(separator + 1));
+
+        auto setter = setters().find(key);
+        if (setter == setters().end()) {
+            return Error{ErrorCode::NotFound, "Unknown settings key", std::format("\"{}\" at {}:{}", key, path, lineNumber)};
+        }
+        auto setReturn = setter->second(value, targets);
+        if (!setReturn.isOk()) {
+            return Error{ErrorCode::Failed, "Invalid setting", std::format("{} at {}:{}: {}", key, path, lineNumber, setReturn.message())};
+        }
+    }
+
+    netSettings = std::move(net);
+    localSettings = std::move(local);
+    iterationPeriodS = periodS;
+    return Result<>{};
+}
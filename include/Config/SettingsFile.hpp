@@ -0,0 +1,25 @@
+#pragma once
+#ifndef SETTINGSFILE_HPP
+#define SETTINGSFILE_HPP
+
+#include "Utility/Result.hpp"
+#include "Network/DiscoverySettings.hpp"
+#include "Unix/UnixDomainSettings.hpp"
+
+#include <string>
+
+using Utility::Result;
+using Network::DiscoverySettings;
+using Unix::UnixDomainSettings;
+
+namespace Config {
+    //runtime overrides of compiled settings, one "key = value" per line, # starts a comment
+    //keys are lowercase names of Config constants, e.g. sending_period_seconds = 10
+    class SettingsFile {
+    public:
+        //settings are changed only if whole file is valid, keys left out keep their current values
+        static Result<> load(const std::string& path, DiscoverySettings& netSettings, UnixDomainSettings& localSettings, unsigned int& iterationPeriodS);
+    };
+}
+
+#endif
@@ -3,23 +3,43 @@
 #define TIMEDSET_HPP
 
 #include <unordered_map>
+#include <set>
 #include <vector>
+#include <cstdint>
+#include <optional>
 #include <string>
 #include <chrono>
 #include <utility>
 #include <ranges>
+#include <algorithm>
 
 namespace Containers {
+    //outcome of IndexedTimedSet::update
+    enum class UpdateResult {
+        Unchanged,
+        Added,
+        Changed
+    };
+
     template<typename TIndex, typename TData>
     class IndexedTimedSet {
     private:
         //lookup done by index
         std::unordered_map<TIndex, std::pair<TData, std::chrono::steady_clock::time_point>> map;
+        //index order for paging, kept next to map so that lookups stay hashed
+        std::set<TIndex> order;
+        //changes whenever entry is added, its data changes or it is removed
+        std::uint64_t generation = 0;
 
     public:
 
         std::pair<TData, std::chrono::steady_clock::time_point>& operator[](const TIndex& index) {
-            return this->map[index];
+            auto [it, inserted] = this->map.try_emplace(index);
+            if (inserted) {
+                this->order.insert(index);
+                this->generation++;
+            }
+            return it->second;
         } 
 
         //non modifying
@@ -27,29 +47,99 @@ namespace Containers {
             return this->map.at(index);
         } 
 
-        void update(const TIndex& index, TData data) {
-            this->map[index] = {data, std::chrono::steady_clock::now()};
+        //reports whether entry was added, its data changed or only last seen time was updated
+        UpdateResult update(const TIndex& index, TData data) {
+            return this->update(index, std::move(data), std::chrono::steady_clock::now());
+        }
+
+        //last seen time never goes back, data handled out of arrival order doesn't make entry look older
+        UpdateResult update(const TIndex& index, TData data, std::chrono::steady_clock::time_point lastSeen) {
+            auto [it, inserted] = this->map.try_emplace(index, std::move(data), lastSeen);
+            if (inserted) {
+                this->order.insert(index);
+                this->generation++;
+                return UpdateResult::Added;
+            }
+            it->second.second = std::max(it->second.second, lastSeen);
+            if (it->second.first == data) {
+                return UpdateResult::Unchanged;
+            }
+            it->second.first = std::move(data);
+            this->generation++;
+            return UpdateResult::Changed;
+        }
+
+        //updates only last seen time of existing entry, returns false if index isn't present
+        bool refresh(const TIndex& index) {
+            return this->refresh(index, std::chrono::steady_clock::now());
+        }
+
+        bool refresh(const TIndex& index, std::chrono::steady_clock::time_point lastSeen) {
+            auto it = this->map.find(index);
+            if (it == this->map.end()) {
+                return false;
+            }
+            it->second.second = std::max(it->second.second, lastSeen);
+            return true;
         }
 
         void remove(const TIndex& index) {
-            this->map.erase(index);
+            if (this->map.erase(index) > 0) {
+                this->order.erase(index);
+                this->generation++;
+            }
         }
 
-        void remove(const std::chrono::steady_clock::duration& maxDuration) {
+        //removes entries not updated for longer than maxDuration, returns indexes of removed entries
+        std::vector<TIndex> remove(const std::chrono::steady_clock::duration& maxDuration) {
             auto now = std::chrono::steady_clock::now();
+            std::vector<TIndex> removed;
             for (auto it = this->map.begin(); it != this->map.end();) {
                 if (now - it->second.second > maxDuration) {
+                    removed.push_back(it->first);
+                    this->order.erase(it->first);
                     it = map.erase(it);
                 } else {
                     ++it;
                 }
             }
+            if (!removed.empty()) {
+                this->generation++;
+            }
+            return removed;
         }
 
         std::size_t size() const {
             return this->map.size();
         }
 
+        std::uint64_t getGeneration() const {
+            return this->generation;
+        }
+
+        //visits entries in index order, starting right after passed index, until visitor returns false
+        //returns index of last visited entry, nullopt if entries ran out
+        template<typename TVisitor>
+        std::optional<TIndex> visitAfter(const std::optional<TIndex>& after, TVisitor&& visitor) const {
+            auto it = after.has_value() ? this->order.upper_bound(after.value()) : this->order.begin();
+            for (; it != this->order.end(); ++it) {
+                const auto& entry = this->map.at(*it);
+                if (!visitor(*it, entry.first, entry.second)) {
+                    return *it;
+                }
+            }
+            return std::nullopt;
+        }
+
+        //iteration over index -> (data, last seen time) pairs
+        auto begin() const {
+            return this->map.begin();
+        }
+
+        auto end() const {
+            return this->map.end();
+        }
+
         std::vector<TData> data() const {
             auto view = this->map | std::views::values | std::views::transform([](auto& p){ return p.first; });
             return std::vector<TData>(view.begin(), view.end());
@@ -0,0 +1,103 @@
+#include "Reactor.hpp"
+
+#include <algorithm>
+#include <cerrno>
+
+using Coroutines::Reactor;
+using Coroutines::Task;
+
+Reactor::~Reactor() {
+    for (auto handle : this->tasks) {
+        handle.destroy();
+    }
+}
+
+void Reactor::spawn(Task task) {
+    auto handle = task.release();
+    this->tasks.push_back(handle);
+    this->ready.push_back(handle);
+}
+
+void Reactor::resume(std::coroutine_handle<> handle) {
+    handle.resume();
+    if (handle.done()) {
+        std::erase(this->tasks, handle);
+        handle.destroy();
+    }
+}
+
+std::optional<Reactor::Clock::time_point> Reactor::expireWaits(Clock::time_point now) {
+    while (!this->timers.empty() && this->timers.begin()->first <= now) {
+        this->ready.push_back(this->timers.begin()->second);
+        this->timers.erase(this->timers.begin());
+    }
+
+    std::optional<Clock::time_point> closest{};
+    if (!this->timers.empty()) {
+        closest = this->timers.begin()->first;
+    }
+
+    //timed out descriptor waits resume with false
+    std::erase_if(this->descriptorWaiters, [&](const DescriptorWaiter& waiter) {
+        if (!waiter.deadline.has_value()) {
+            return false;
+        }
+        if (waiter.deadline.value() <= now) {
+            this->ready.push_back(waiter.handle);
+            return true;
+        }
+        closest = closest.has_value() ? std::min(closest.value(), waiter.deadline.value()) : waiter.deadline.value();
+        return false;
+    });
+
+    return closest;
+}
+
+void Reactor::pollDescriptors(int timeoutMs) {
+    std::vector<::pollfd> fds{};
+    for (const auto& waiter : this->descriptorWaiters) {
+        fds.push_back(::pollfd{waiter.fd, waiter.events, 0});
+    }
+
+    int count = ::poll(fds.data(), fds.size(), timeoutMs);
+    if (count <= 0) {
+        return;
+    }
+
+    //waiters and descriptors share indexes, hang ups and errors wake waiter too so that it notices them
+    std::vector<DescriptorWaiter> waiting{};
+    for (std::size_t i = 0; i < fds.size(); i++) {
+        if (fds[i].revents != 0) {
+            *this->descriptorWaiters[i].ready = true;
+            this->ready.push_back(this->descriptorWaiters[i].handle);
+        } else {
+            waiting.push_back(this->descriptorWaiters[i]);
+        }
+    }
+    this->descriptorWaiters = std::move(waiting);
+}
+
+void Reactor::runUntil(Clock::time_point deadline) {
+    while (true) {
+        //only tasks ready before this round run in it, yielding ones wait for next round
+        std::deque<std::coroutine_handle<>> round{};
+        round.swap(this->ready);
+        for (auto handle : round) {
+            this->resume(handle);
+        }
+
+        auto now = Clock::now();
+        auto closest = this->expireWaits(now);
+        if (now >= deadline || this->stopping) {
+            this->stopping = false;
+            break;
+        }
+
+        int timeoutMs = 0;
+        if (this->ready.empty()) {
+            auto wakeTime = closest.has_value() ? std::min(deadline, closest.value()) : deadline;
+            timeoutMs = static_cast<int>(std::chrono::ceil<std::chrono::milliseconds>(wakeTime - now).count());
+        }
+        this->pollDescriptors(timeoutMs);
+    }
+}
@@ -0,0 +1,151 @@
+#pragma once
+#ifndef REACTOR_HPP
+#define REACTOR_HPP
+
+#include "Task.hpp"
+
+#include <poll.h>
+
+#include <coroutine>
+#include <chrono>
+#include <deque>
+#include <map>
+#include <vector>
+#include <optional>
+
+namespace Coroutines {
+    //single threaded scheduler of Tasks, suspended tasks wait for timers or descriptor readiness reported by poll()
+    class Reactor {
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct DescriptorWaiter {
+            int fd{-1};
+            short events{};
+            std::optional<Clock::time_point> deadline{};
+            std::coroutine_handle<> handle{};
+            bool* ready = nullptr;
+        };
+
+        std::vector<std::coroutine_handle<>> tasks{};
+        std::deque<std::coroutine_handle<>> ready{};
+        std::multimap<Clock::time_point, std::coroutine_handle<>> timers{};
+        std::vector<DescriptorWaiter> descriptorWaiters{};
+        bool stopping = false;
+
+        void resume(std::coroutine_handle<> handle);
+        //moves tasks with passed deadlines to ready queue, returns closest deadline still pending
+        std::optional<Clock::time_point> expireWaits(Clock::time_point now);
+        void pollDescriptors(int timeoutMs);
+
+    public:
+        class SleepAwaiter {
+        private:
+            Reactor& reactor;
+            Clock::time_point wakeTime;
+
+        public:
+            SleepAwaiter(Reactor& reactor, Clock::time_point wakeTime)
+                : reactor{reactor}, wakeTime{wakeTime} {}
+
+            bool await_ready() const {
+                return false;
+            }
+
+            void await_suspend(std::coroutine_handle<> handle) {
+                this->reactor.timers.emplace(this->wakeTime, handle);
+            }
+
+            void await_resume() const {}
+        };
+
+        class YieldAwaiter {
+        private:
+            Reactor& reactor;
+
+        public:
+            explicit YieldAwaiter(Reactor& reactor)
+                : reactor{reactor} {}
+
+            bool await_ready() const {
+                return false;
+            }
+
+            void await_suspend(std::coroutine_handle<> handle) {
+                this->reactor.ready.push_back(handle);
+            }
+
+            void await_resume() const {}
+        };
+
+        //resumes with true once descriptor is readable or writable, false if timeout passed first
+        class DescriptorAwaiter {
+        private:
+            Reactor& reactor;
+            int fd;
+            short events;
+            std::optional<Clock::time_point> deadline;
+            bool isReady = false;
+
+        public:
+            DescriptorAwaiter(Reactor& reactor, int fd, short events, std::optional<Clock::time_point> deadline)
+                : reactor{reactor}, fd{fd}, events{events}, deadline{deadline} {}
+
+            bool await_ready() const {
+                return false;
+            }
+
+            void await_suspend(std::coroutine_handle<> handle) {
+                this->reactor.descriptorWaiters.push_back(DescriptorWaiter{this->fd, this->events, this->deadline, handle, &this->isReady});
+            }
+
+            bool await_resume() const {
+                return this->isReady;
+            }
+        };
+
+        Reactor() = default;
+        //frames of unfinished tasks are destroyed without resuming them
+        ~Reactor();
+
+        Reactor(const Reactor&) = delete;
+        Reactor& operator=(const Reactor&) = delete;
+
+        //task starts on next run of reactor
+        void spawn(Task task);
+
+        //runs tasks until deadline passes, tasks still ready then continue on next run
+        void runUntil(Clock::time_point deadline);
+        //makes running runUntil return after current round instead of at its deadline
+        void stop() {
+            this->stopping = true;
+        }
+
+        SleepAwaiter sleepUntil(Clock::time_point wakeTime) {
+            return SleepAwaiter{*this, wakeTime};
+        }
+
+        SleepAwaiter sleepFor(Clock::duration duration) {
+            return SleepAwaiter{*this, Clock::now() + duration};
+        }
+
+        //lets other ready tasks and descriptor events go first
+        YieldAwaiter yield() {
+            return YieldAwaiter{*this};
+        }
+
+        DescriptorAwaiter readable(int fd) {
+            return DescriptorAwaiter{*this, fd, POLLIN, std::nullopt};
+        }
+
+        DescriptorAwaiter readable(int fd, Clock::duration timeout) {
+            return DescriptorAwaiter{*this, fd, POLLIN, Clock::now() + timeout};
+        }
+
+        DescriptorAwaiter writable(int fd, Clock::duration timeout) {
+            return DescriptorAwaiter{*this, fd, POLLOUT, Clock::now() + timeout};
+        }
+    };
+}
+
+#endif
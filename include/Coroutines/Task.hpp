@@ -0,0 +1,71 @@
+#pragma once
+#ifndef TASK_HPP
+#define TASK_HPP
+
+#include <coroutine>
+#include <exception>
+#include <utility>
+
+namespace Coroutines {
+    //coroutine that runs independently once spawned on Reactor, suspended before first statement until then
+    class Task {
+    public:
+        struct promise_type {
+            Task get_return_object() {
+                return Task{std::coroutine_handle<promise_type>::from_promise(*this)};
+            }
+
+            std::suspend_always initial_suspend() noexcept {
+                return {};
+            }
+
+            //frame is kept until reactor sees task is done and destroys it
+            std::suspend_always final_suspend() noexcept {
+                return {};
+            }
+
+            void return_void() {}
+
+            //errors are returned through Result, exception leaving task is a bug
+            void unhandled_exception() {
+                std::terminate();
+            }
+        };
+
+    private:
+        std::coroutine_handle<promise_type> handle{};
+
+        explicit Task(std::coroutine_handle<promise_type> handle)
+            : handle{handle} {}
+
+    public:
+        ~Task() {
+            if (this->handle) {
+                this->handle.destroy();
+            }
+        }
+
+        Task(const Task&) = delete;
+        Task& operator=(const Task&) = delete;
+
+        Task(Task&& other) noexcept
+            : handle{std::exchange(other.handle, {})} {}
+
+        Task& operator=(Task&& other) noexcept {
+            if (this != &other) {
+                if (this->handle) {
+                    this->handle.destroy();
+                }
+                this->handle = std::exchange(other.handle, {});
+            }
+            return *this;
+        }
+
+        //passes ownership of coroutine frame to caller
+        std::coroutine_handle<> release() {
+            return std::exchange(this->handle, {});
+        }
+    };
+}
+
+#endif
@@ -2,13 +2,13 @@
 #ifndef FILEREADER_HPP
 #define FILEREADER_HPP
 
-#include "Utility/FunctionReturn.hpp"
+#include "Utility/Result.hpp"
 
 #include <string>
 #include <vector>
 #include <cstdint>
 
-using Utility::FunctionReturn;
+using Utility::Result;
 
 namespace File {
     class FileReader {
@@ -17,7 +17,7 @@ namespace File {
     public:
         FileReader() = delete;
         FileReader(const std::string path) : path{path} {}
-        FunctionReturn<std::vector<std::uint8_t>> read();
+        Result<std::vector<std::uint8_t>> read();
     };
 }
 
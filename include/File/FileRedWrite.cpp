@@ -1,2 +1,105 @@
 #include "FileReader.hpp"
-#include "FileWriter.hpp"
\ No newline at end of file
+#include "FileWriter.hpp"
+#include "MappedFile.hpp"
+
+#include "Utility/Result.hpp"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cerrno>
+
+using File::FileReader;
+using File::FileWriter;
+using File::MappedFile;
+using Utility::Result;
+using Utility::Error;
+
+Result<std::vector<std::uint8_t>> FileReader::read() {
+    auto mapReturn = MappedFile::open(this->path);
+    if (!mapReturn.isOk()) {
+        return mapReturn.error();
+    }
+
+    auto data = mapReturn.value().data();
+    return Result<std::vector<std::uint8_t>>{std::vector<std::uint8_t>(data.begin(), data.end())};
+}
+
+Result<> FileWriter::write(const std::vector<std::uint8_t>& data) {
+    std::string tmpPath = this->path + ".tmp";
+
+    int fd = ::open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return Error::system("open() failed for", tmpPath);
+    }
+
+    const std::uint8_t* p = data.data();
+    std::size_t left = data.size();
+    while (left > 0) {
+        ssize_t n = ::write(fd, p, left);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            auto error = Error::system("write() failed for", tmpPath);
+            ::close(fd);
+            ::unlink(tmpPath.c_str());
+            return error;
+        }
+        p += n;
+        left -= static_cast<std::size_t>(n);
+    }
+
+    //data has to reach disk before rename makes it visible
+    if (::fdatasync(fd) < 0) {
+        auto error = Error::system("fdatasync() failed for", tmpPath);
+        ::close(fd);
+        ::unlink(tmpPath.c_str());
+        return error;
+    }
+    ::close(fd);
+
+    if (::rename(tmpPath.c_str(), this->path.c_str()) < 0) {
+        auto error = Error::system("rename() failed for", this->path);
+        ::unlink(tmpPath.c_str());
+        return error;
+    }
+
+    return Result<>{};
+}
+
+Result<MappedFile> MappedFile::open(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return Error::system("open() failed for", path);
+    }
+
+    struct ::stat st{};
+    if (::fstat(fd, &st) < 0) {
+        auto error = Error::system("fstat() failed for", path);
+        ::close(fd);
+        return error;
+    }
+
+    std::size_t length = static_cast<std::size_t>(st.st_size);
+    if (length == 0) {
+        ::close(fd);
+        return Result<MappedFile>{MappedFile{nullptr, 0}};
+    }
+
+    void* address = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (address == MAP_FAILED) {
+        auto error = Error::system("mmap() failed for", path);
+        ::close(fd);
+        return error;
+    }
+    //mapping stays valid after descriptor is closed
+    ::close(fd);
+
+    return Result<MappedFile>{MappedFile{address, length}};
+}
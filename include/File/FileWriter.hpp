@@ -2,13 +2,13 @@
 #ifndef FILEWRITER_HPP
 #define FILEWRITER_HPP
 
-#include "Utility/FunctionReturn.hpp"
+#include "Utility/Result.hpp"
 
 #include <string>
 #include <vector>
 #include <cstdint>
 
-using Utility::FunctionReturn;
+using Utility::Result;
 
 namespace File {
     class FileWriter {
@@ -17,8 +17,9 @@ namespace File {
     public:
         FileWriter() = delete;
         FileWriter(const std::string path) : path{path} {}
-        FunctionReturn<std::vector<std::uint8_t>> read();
+        //replaces file contents atomically, data is written to temporary file which is renamed over path
+        Result<> write(const std::vector<std::uint8_t>& data);
     };
 }
 
-#endif
\ No newline at end of file
+#endif
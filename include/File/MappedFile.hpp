@@ -0,0 +1,61 @@
+#pragma once
+#ifndef MAPPEDFILE_HPP
+#define MAPPEDFILE_HPP
+
+#include "Utility/Result.hpp"
+
+#include <sys/mman.h>
+
+#include <string>
+#include <span>
+#include <cstdint>
+#include <cstddef>
+
+using Utility::Result;
+
+namespace File {
+    //read only memory mapping of a whole file, unmapped on destruction
+    class MappedFile {
+    private:
+        void* address{nullptr};
+        std::size_t length{0};
+
+        MappedFile(void* address, std::size_t length) : address{address}, length{length} {}
+
+    public:
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        MappedFile(MappedFile&& other) noexcept : address{other.address}, length{other.length} {
+            other.address = nullptr;
+            other.length = 0;
+        }
+
+        MappedFile& operator=(MappedFile&& other) noexcept {
+            if (this != &other) {
+                if (this->address != nullptr) {
+                    ::munmap(this->address, this->length);
+                }
+                this->address = other.address;
+                this->length = other.length;
+                other.address = nullptr;
+                other.length = 0;
+            }
+            return *this;
+        }
+
+        ~MappedFile() {
+            if (this->address != nullptr) {
+                ::munmap(this->address, this->length);
+            }
+        }
+
+        std::span<const std::uint8_t> data() const {
+            return {static_cast<const std::uint8_t*>(this->address), this->length};
+        }
+
+        static Result<MappedFile> open(const std::string& path);
+    };
+}
+
+#endif
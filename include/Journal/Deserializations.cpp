@@ -0,0 +1,37 @@
+#include "JournalEvent.hpp"
+#include "Utility/Serialization/Deserializer.hpp"
+#include "Utility/Result.hpp"
+
+#include <vector>
+#include <span>
+#include <cstdint>
+
+using Journal::JournalEvent;
+using Journal::JournalEventType;
+using Network::NetInterfaces::NetInterface;
+using Utility::Serialization::Deserializer;
+using Utility::Result;
+
+Result<JournalEvent> JournalEvent::deserializeImpl(std::span<const std::uint8_t> buff, std::size_t& offset) {
+    JournalEvent event;
+
+    auto funcReturn = Deserializer::deserialize<std::int64_t>(buff, offset);
+    if (!funcReturn.isOk()) {
+        return funcReturn.within("Couldn't deserialize journal event time");
+    }
+    event.timeMs = funcReturn.value();
+
+    auto funcReturn1 = Deserializer::deserialize<JournalEventType>(buff, offset);
+    if (!funcReturn1.isOk()) {
+        return funcReturn1.within("Couldn't deserialize journal event type");
+    }
+    event.type = funcReturn1.value();
+
+    auto funcReturn2 = NetInterface::deserialize(buff, offset);
+    if (!funcReturn2.isOk()) {
+        return funcReturn2.within("Couldn't deserialize journal event network interface");
+    }
+    event.nif = std::move(funcReturn2).value();
+
+    return Result<JournalEvent>{std::move(event)};
+}
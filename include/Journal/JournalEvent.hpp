@@ -0,0 +1,41 @@
+#pragma once
+#ifndef JOURNALEVENT_HPP
+#define JOURNALEVENT_HPP
+
+#include "Network/NetInterfaces/NetInterface.hpp"
+#include "Utility/Serialization/ISerializable.hpp"
+#include "Utility/Serialization/IDeserializable.hpp"
+#include "Utility/Result.hpp"
+
+#include <string>
+#include <vector>
+#include <span>
+#include <cstdint>
+
+using Utility::Serialization::ISerializable;
+using Utility::Serialization::IDeserializable;
+using Utility::Result;
+using Network::NetInterfaces::NetInterface;
+
+namespace Journal {
+    enum class JournalEventType : std::uint8_t {
+        Added = 0,
+        Updated = 1,
+        Expired = 2
+    };
+
+    //change of neighbor table, expired events carry only MAC of the neighbor
+    struct JournalEvent : public ISerializable, public IDeserializable<JournalEvent> {
+        std::int64_t timeMs{}; //wall clock, ms since epoch
+        JournalEventType type{};
+        NetInterface nif{};
+
+        ~JournalEvent() = default;
+
+        void serialize(std::vector<std::uint8_t>& buff) const;
+        //used by IDeserializable interface to handle deserialization statically
+        static Result<JournalEvent> deserializeImpl(std::span<const std::uint8_t> buff, std::size_t& offset);
+    };
+}
+
+#endif
@@ -0,0 +1,356 @@
+#include "NeighborJournal.hpp"
+
+#include "JournalEvent.hpp"
+#include "File/MappedFile.hpp"
+#include "Utility/Result.hpp"
+#include "Utility/Serialization/Deserializer.hpp"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+#include <span>
+#include <algorithm>
+#include <filesystem>
+#include <chrono>
+#include <charconv>
+#include <format>
+#include <cstring>
+#include <cerrno>
+
+using Journal::NeighborJournal;
+using Journal::JournalEvent;
+using File::MappedFile;
+using Utility::Result;
+using Utility::Error;
+using Utility::ErrorCode;
+using Utility::Serialization::Deserializer;
+
+namespace {
+    constexpr std::size_t VERSION_OFFSET = 4u;
+    constexpr std::size_t FIRST_TIME_OFFSET = 8u;
+    constexpr std::size_t LAST_TIME_OFFSET = 16u;
+    constexpr std::size_t DATA_END_OFFSET = 24u;
+    constexpr std::size_t INDEX_COUNT_OFFSET = 32u;
+    constexpr std::size_t INDEX_CAPACITY_OFFSET = 36u;
+    constexpr std::size_t RECORD_SIZE_SIZE = 4u;
+
+    constexpr char SEGMENT_PREFIX[] = "segment-";
+    constexpr char SEGMENT_SUFFIX[] = ".ndj";
+
+    template<typename T>
+    T load(const std::uint8_t* p) {
+        T val;
+        std::memcpy(&val, p, sizeof(T));
+        return val;
+    }
+
+    template<typename T>
+    void store(std::uint8_t* p, T val) {
+        std::memcpy(p, &val, sizeof(T));
+    }
+}
+
+NeighborJournal::NeighborJournal(NeighborJournal&& other) noexcept
+    : directory{std::move(other.directory)}, segmentSize{other.segmentSize}, maxSegments{other.maxSegments},
+      fd{other.fd}, address{other.address}, segmentPath{std::move(other.segmentPath)},
+      indexCapacity{other.indexCapacity}, lastIndexedOffset{other.lastIndexedOffset}, pending{std::move(other.pending)} {
+    other.fd = -1;
+    other.address = nullptr;
+}
+
+NeighborJournal& NeighborJournal::operator=(NeighborJournal&& other) noexcept {
+    if (this != &other) {
+        this->closeSegment();
+        this->directory = std::move(other.directory);
+        this->segmentSize = other.segmentSize;
+        this->maxSegments = other.maxSegments;
+        this->fd = other.fd;
+        this->address = other.address;
+        this->segmentPath = std::move(other.segmentPath);
+        this->indexCapacity = other.indexCapacity;
+        this->lastIndexedOffset = other.lastIndexedOffset;
+        this->pending = std::move(other.pending);
+        other.fd = -1;
+        other.address = nullptr;
+    }
+    return *this;
+}
+
+NeighborJournal::~NeighborJournal() {
+    //destructor has nowhere to report failed flush
+    (void)this->flush();
+    this->closeSegment();
+}
+
+Result<NeighborJournal> NeighborJournal::factory(const std::string& directory, std::size_t segmentSize, std::size_t maxSegments) {
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    if (ec) {
+        return Error{ErrorCode::Failed, "Couldn't create journal directory", directory + ": " + ec.message()};
+    }
+
+    NeighborJournal journal{directory, segmentSize, std::max<std::size_t>(maxSegments, 1u)};
+    auto nowMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    auto openReturn = journal.openSegment(nowMs);
+    if (!openReturn.isOk()) {
+        return openReturn.within("Couldn't open journal segment");
+    }
+    journal.removeOldSegments();
+
+    return Result<NeighborJournal>{std::move(journal)};
+}
+
+Result<> NeighborJournal::openSegment(std::int64_t firstTimeMs) {
+    //index has to cover every INDEX_INTERVAL_BYTES of data area
+    this->indexCapacity = this->segmentSize / INDEX_INTERVAL_BYTES + 1u;
+    std::size_t dataStart = HEADER_SIZE + this->indexCapacity * INDEX_ENTRY_SIZE;
+    if (dataStart >= this->segmentSize) {
+        return Error{ErrorCode::Failed, "Journal segment can't hold its index with size", static_cast<std::int64_t>(this->segmentSize)};
+    }
+
+    //names sort in time order, collisions within same ms get following name
+    int segmentFd = -1;
+    std::string path;
+    for (std::int64_t nameTime = firstTimeMs; segmentFd < 0; ++nameTime) {
+        path = std::format("{}/{}{:020}{}", this->directory, SEGMENT_PREFIX, nameTime, SEGMENT_SUFFIX);
+        segmentFd = ::open(path.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+        if (segmentFd < 0 && errno != EEXIST) {
+            return Error::system("open() failed for", path);
+        }
+    }
+
+    if (::ftruncate(segmentFd, static_cast<off_t>(this->segmentSize)) < 0) {
+        auto error = Error::system("ftruncate() failed for", path);
+        ::close(segmentFd);
+        ::unlink(path.c_str());
+        return error;
+    }
+
+    void* mapped = ::mmap(nullptr, this->segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, segmentFd, 0);
+    if (mapped == MAP_FAILED) {
+        auto error = Error::system("mmap() failed for", path);
+        ::close(segmentFd);
+        ::unlink(path.c_str());
+        return error;
+    }
+
+    this->fd = segmentFd;
+    this->address = static_cast<std::uint8_t*>(mapped);
+    this->segmentPath = path;
+    this->lastIndexedOffset = 0;
+
+    store<std::uint32_t>(this->address, MAGIC);
+    this->address[VERSION_OFFSET] = VERSION;
+    store<std::int64_t>(this->address + FIRST_TIME_OFFSET, firstTimeMs);
+    store<std::int64_t>(this->address + LAST_TIME_OFFSET, firstTimeMs);
+    store<std::uint64_t>(this->address + DATA_END_OFFSET, dataStart);
+    store<std::uint32_t>(this->address + INDEX_COUNT_OFFSET, 0u);
+    store<std::uint32_t>(this->address + INDEX_CAPACITY_OFFSET, static_cast<std::uint32_t>(this->indexCapacity));
+
+    return Result<>{};
+}
+
+void NeighborJournal::closeSegment() {
+    if (this->address == nullptr) {
+        return;
+    }
+
+    //finished segment is shrunk to its data, readers rely on data end stored in header
+    std::uint64_t dataEnd = load<std::uint64_t>(this->address + DATA_END_OFFSET);
+    ::msync(this->address, this->segmentSize, MS_ASYNC);
+    ::munmap(this->address, this->segmentSize);
+    //failure is nonfatal, segment keeps its preallocated size then
+    [[maybe_unused]] int truncated = ::ftruncate(this->fd, static_cast<off_t>(dataEnd));
+    ::close(this->fd);
+
+    this->address = nullptr;
+    this->fd = -1;
+    this->segmentPath.clear();
+}
+
+Result<> NeighborJournal::append(const JournalEvent& event, const std::vector<std::uint8_t>& record) {
+    std::size_t recordSize = RECORD_SIZE_SIZE + record.size();
+    std::uint64_t dataEnd = load<std::uint64_t>(this->address + DATA_END_OFFSET);
+
+    if (dataEnd + recordSize > this->segmentSize) {
+        this->closeSegment();
+        auto openReturn = this->openSegment(event.timeMs);
+        if (!openReturn.isOk()) {
+            return openReturn;
+        }
+        this->removeOldSegments();
+
+        dataEnd = load<std::uint64_t>(this->address + DATA_END_OFFSET);
+        if (dataEnd + recordSize > this->segmentSize) {
+            return Error{ErrorCode::Overflow, "Journal record doesn't fit into segment, size", static_cast<std::int64_t>(recordSize)};
+        }
+    }
+
+    std::uint32_t indexCount = load<std::uint32_t>(this->address + INDEX_COUNT_OFFSET);
+    if ((indexCount == 0 || dataEnd - this->lastIndexedOffset >= INDEX_INTERVAL_BYTES) && indexCount < this->indexCapacity) {
+        std::uint8_t* entry = this->address + HEADER_SIZE + indexCount * INDEX_ENTRY_SIZE;
+        store<std::int64_t>(entry, event.timeMs);
+        store<std::uint64_t>(entry + sizeof(std::int64_t), dataEnd);
+        store<std::uint32_t>(this->address + INDEX_COUNT_OFFSET, indexCount + 1u);
+        this->lastIndexedOffset = dataEnd;
+    }
+
+    store<std::uint32_t>(this->address + dataEnd, static_cast<std::uint32_t>(record.size()));
+    std::memcpy(this->address + dataEnd + RECORD_SIZE_SIZE, record.data(), record.size());
+
+    //header is updated last, record becomes visible to queries only after it's complete
+    if (event.timeMs > load<std::int64_t>(this->address + LAST_TIME_OFFSET)) {
+        store<std::int64_t>(this->address + LAST_TIME_OFFSET, event.timeMs);
+    }
+    store<std::uint64_t>(this->address + DATA_END_OFFSET, dataEnd + recordSize);
+
+    return Result<>{};
+}
+
+Result<> NeighborJournal::flush() {
+    if (this->pending.empty()) {
+        return Result<>{};
+    }
+    if (this->address == nullptr) {
+        this->pending.clear();
+        return Error{ErrorCode::Failed, "Journal has no open segment"};
+    }
+
+    std::vector<std::uint8_t> record;
+    for (const auto& event : this->pending) {
+        record.clear();
+        event.serialize(record);
+        auto appendReturn = this->append(event, record);
+        if (!appendReturn.isOk()) {
+            this->pending.clear();
+            return appendReturn;
+        }
+    }
+    this->pending.clear();
+
+    if (this->address != nullptr) {
+        ::msync(this->address, this->segmentSize, MS_ASYNC);
+    }
+    return Result<>{};
+}
+
+std::vector<std::string> NeighborJournal::segmentPaths() const {
+    std::vector<std::string> paths;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(this->directory, ec)) {
+        std::string name = entry.path().filename().string();
+        if (name.starts_with(SEGMENT_PREFIX) && name.ends_with(SEGMENT_SUFFIX)) {
+            paths.push_back(entry.path().string());
+        }
+    }
+    std::ranges::sort(paths);
+    return paths;
+}
+
+void NeighborJournal::removeOldSegments() {
+    auto paths = this->segmentPaths();
+    for (std::size_t i = 0; i + this->maxSegments < paths.size(); ++i) {
+        if (paths[i] != this->segmentPath) {
+            ::unlink(paths[i].c_str());
+        }
+    }
+}
+
+void NeighborJournal::querySegment(std::span<const std::uint8_t> segment, std::int64_t fromMs, std::int64_t toMs, std::vector<JournalEvent>& events) {
+    if (segment.size() < HEADER_SIZE
+        || load<std::uint32_t>(segment.data()) != MAGIC
+        || segment[VERSION_OFFSET] != VERSION) {
+        return;
+    }
+
+    std::int64_t firstTimeMs = load<std::int64_t>(segment.data() + FIRST_TIME_OFFSET);
+    std::int64_t lastTimeMs = load<std::int64_t>(segment.data() + LAST_TIME_OFFSET);
+    if (lastTimeMs < fromMs || firstTimeMs > toMs) {
+        return;
+    }
+
+    std::uint64_t dataEnd = load<std::uint64_t>(segment.data() + DATA_END_OFFSET);
+    std::uint32_t indexCount = load<std::uint32_t>(segment.data() + INDEX_COUNT_OFFSET);
+    std::uint32_t indexCapacity = load<std::uint32_t>(segment.data() + INDEX_CAPACITY_OFFSET);
+    std::size_t dataStart = HEADER_SIZE + static_cast<std::size_t>(indexCapacity) * INDEX_ENTRY_SIZE;
+    if (dataEnd > segment.size() || dataStart > dataEnd || indexCount > indexCapacity) {
+        return;
+    }
+
+    //last indexed record older than fromMs, everything before it is out of range
+    auto indexTime = [&](std::uint32_t i) {
+        return load<std::int64_t>(segment.data() + HEADER_SIZE + i * INDEX_ENTRY_SIZE);
+    };
+    std::uint32_t lo = 0, hi = indexCount;
+    while (lo < hi) {
+        std::uint32_t mid = lo + (hi - lo) / 2;
+        if (indexTime(mid) < fromMs) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    std::size_t offset = dataStart;
+    if (lo > 0) {
+        offset = load<std::uint64_t>(segment.data() + HEADER_SIZE + (lo - 1) * INDEX_ENTRY_SIZE + sizeof(std::int64_t));
+    }
+
+    std::span<const std::uint8_t> data = segment.first(dataEnd);
+    while (offset + RECORD_SIZE_SIZE <= dataEnd) {
+        std::uint32_t recordSize = load<std::uint32_t>(data.data() + offset);
+        offset += RECORD_SIZE_SIZE;
+        if (offset + recordSize > dataEnd) {
+            return;
+        }
+
+        std::size_t recordOffset = offset;
+        auto eventReturn = JournalEvent::deserialize(data.first(offset + recordSize), recordOffset);
+        offset += recordSize;
+        if (!eventReturn.isOk()) {
+            continue;
+        }
+
+        JournalEvent& event = eventReturn.value();
+        if (event.timeMs > toMs) {
+            return;
+        }
+        if (event.timeMs >= fromMs) {
+            events.push_back(std::move(event));
+        }
+    }
+}
+
+Result<std::vector<JournalEvent>> NeighborJournal::query(std::int64_t fromMs, std::int64_t toMs) const {
+    std::vector<JournalEvent> events;
+
+    auto paths = this->segmentPaths();
+    for (std::size_t i = 0; i < paths.size(); ++i) {
+        //next segment starts after this one ended
+        if (i + 1 < paths.size()) {
+            auto name = std::filesystem::path(paths[i + 1]).filename().string();
+            const char* first = name.data() + sizeof(SEGMENT_PREFIX) - 1;
+            std::int64_t nextFirstTimeMs = 0;
+            auto [ptr, ec] = std::from_chars(first, name.data() + name.size(), nextFirstTimeMs);
+            if (ec == std::errc{} && nextFirstTimeMs < fromMs) {
+                continue;
+            }
+        }
+
+        if (paths[i] == this->segmentPath && this->address != nullptr) {
+            querySegment({this->address, this->segmentSize}, fromMs, toMs, events);
+            continue;
+        }
+
+        auto mapReturn = MappedFile::open(paths[i]);
+        if (!mapReturn.isOk()) {
+            continue;
+        }
+        querySegment(mapReturn.value().data(), fromMs, toMs, events);
+    }
+
+    return Result<std::vector<JournalEvent>>{std::move(events)};
+}
@@ -0,0 +1,83 @@
+#pragma once
+#ifndef NEIGHBORJOURNAL_HPP
+#define NEIGHBORJOURNAL_HPP
+
+#include "JournalEvent.hpp"
+#include "Utility/Result.hpp"
+
+#include <string>
+#include <vector>
+#include <span>
+#include <cstdint>
+#include <cstddef>
+
+using Utility::Result;
+
+namespace Journal {
+    //append only journal of neighbor table events stored in memory mapped, fixed size segment files
+    //segment layout: header (64B), sparse time index, records (4B size + serialized JournalEvent)
+    //index gets an entry every INDEX_INTERVAL_BYTES of records, so time range queries seek instead of scanning whole files
+    //events are buffered by record() and written in batches by flush()
+    class NeighborJournal {
+    public:
+        static constexpr std::uint32_t MAGIC = 0x314A444Eu; //"NDJ1" in memory on little endian hosts
+        static constexpr std::uint8_t VERSION = 1u;
+        static constexpr std::size_t HEADER_SIZE = 64u;
+        static constexpr std::size_t INDEX_ENTRY_SIZE = 16u;
+        static constexpr std::size_t INDEX_INTERVAL_BYTES = 1024u;
+
+    private:
+        std::string directory;
+        std::size_t segmentSize;
+        std::size_t maxSegments;
+
+        //currently written segment
+        int fd{-1};
+        std::uint8_t* address{nullptr};
+        std::string segmentPath{};
+        std::size_t indexCapacity{0};
+        std::size_t lastIndexedOffset{0};
+
+        std::vector<JournalEvent> pending{};
+
+        NeighborJournal(const std::string& directory, std::size_t segmentSize, std::size_t maxSegments)
+            : directory{directory}, segmentSize{segmentSize}, maxSegments{maxSegments} {}
+
+        Result<> openSegment(std::int64_t firstTimeMs);
+        void closeSegment();
+        Result<> append(const JournalEvent& event, const std::vector<std::uint8_t>& record);
+        void removeOldSegments();
+        std::vector<std::string> segmentPaths() const;
+
+        static void querySegment(std::span<const std::uint8_t> segment, std::int64_t fromMs, std::int64_t toMs, std::vector<JournalEvent>& events);
+
+    public:
+        NeighborJournal(const NeighborJournal&) = delete;
+        NeighborJournal& operator=(const NeighborJournal&) = delete;
+
+        NeighborJournal(NeighborJournal&& other) noexcept;
+        NeighborJournal& operator=(NeighborJournal&& other) noexcept;
+
+        ~NeighborJournal();
+
+        //creates directory if needed and starts new segment in it
+        static Result<NeighborJournal> factory(const std::string& directory, std::size_t segmentSize, std::size_t maxSegments);
+
+        //buffers event, nothing is written until flush
+        void record(JournalEvent event) {
+            this->pending.push_back(std::move(event));
+        }
+
+        std::size_t pendingCount() const {
+            return this->pending.size();
+        }
+
+        //appends buffered events to segments, rotating them as they fill up
+        Result<> flush();
+
+        //returns events with time in [fromMs, toMs], ordered as they were recorded
+        Result<std::vector<JournalEvent>> query(std::int64_t fromMs, std::int64_t toMs) const;
+    };
+}
+
+#endif
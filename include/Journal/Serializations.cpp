@@ -0,0 +1,14 @@
+#include "JournalEvent.hpp"
+#include "Utility/Serialization/Serializer.hpp"
+
+#include <vector>
+#include <cstdint>
+
+using Journal::JournalEvent;
+using Utility::Serialization::Serializer;
+
+void JournalEvent::serialize(std::vector<std::uint8_t>& buff) const {
+    Serializer::serialize(buff, this->timeMs);
+    Serializer::serialize(buff, this->type);
+    this->nif.serialize(buff);
+}
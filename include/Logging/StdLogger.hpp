@@ -21,12 +21,13 @@ namespace Logging {
 
         inline void info(const std::string& message) {
             auto time = std::chrono::zoned_time{std::chrono::current_zone(), std::chrono::system_clock::now()}; 
-            std::cout <<  std::format("[{:%F %T}] | INFO: ", time)  << message << std::endl;
+            //single write keeps lines of concurrent threads from interleaving
+            std::cout << (std::format("[{:%F %T}] | INFO: ", time) + message + "\n") << std::flush;
         }
 
         inline void error(const std::string& message) {
             auto time = std::chrono::zoned_time{std::chrono::current_zone(), std::chrono::system_clock::now()}; 
-            std::cout <<  std::format("[{:%F %T}] | ERROR: ", time)  << message << std::endl;
+            std::cout << (std::format("[{:%F %T}] | ERROR: ", time) + message + "\n") << std::flush;
         }
 
         static std::shared_ptr<StdLogger> getInstance() {
@@ -0,0 +1,276 @@
+#include "DaemonHandoff.hpp"
+
+#include "Protocol/Frame.hpp"
+#include "Protocol/HandoffMessage.hpp"
+#include "Unix/UnixSocket.hpp"
+#include "Utility/Result.hpp"
+#include "Utility/Serialization/Serializer.hpp"
+#include "Utility/Serialization/Deserializer.hpp"
+
+#include <poll.h>
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+#include <span>
+#include <chrono>
+#include <cerrno>
+#include <format>
+#include <sstream>
+
+using Network::DaemonHandoff;
+using Network::HandoffState;
+using Network::Protocol::Frame;
+using Network::Protocol::HandoffMessage;
+using Network::Protocol::HandoffRole;
+using Unix::UnixSocket;
+using Utility::Result;
+using Utility::Error;
+using Utility::ErrorCode;
+using Utility::Serialization::Serializer;
+using Utility::Serialization::Deserializer;
+
+namespace {
+    constexpr std::size_t RECEIVE_CHUNK_SIZE = 64u * 1024u;
+
+    void closeDescriptors(const std::vector<int>& fds) {
+        for (int fd : fds) {
+            ::close(fd);
+        }
+    }
+
+    //false once deadline passes
+    Result<bool> waitFor(int fd, short events, std::chrono::steady_clock::time_point deadline) {
+        auto left = std::chrono::ceil<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+        if (left.count() <= 0) {
+            return Result<bool>{false};
+        }
+        ::pollfd pfd{fd, events, 0};
+        if (::poll(&pfd, 1, static_cast<int>(left.count())) < 0 && errno != EINTR) {
+            return Error::system("poll() failed on socket", fd);
+        }
+        return Result<bool>{true};
+    }
+}
+
+HandoffState& HandoffState::operator=(HandoffState&& other) noexcept {
+    if (this != &other) {
+        for (const auto& [role, fd] : this->descriptors) {
+            ::close(fd);
+        }
+        this->descriptors = std::move(other.descriptors);
+        this->neighborSnapshot = std::move(other.neighborSnapshot);
+        other.descriptors.clear();
+    }
+    return *this;
+}
+
+HandoffState::~HandoffState() {
+    for (const auto& [role, fd] : this->descriptors) {
+        ::close(fd);
+    }
+}
+
+int HandoffState::take(HandoffRole role) {
+    for (auto it = this->descriptors.begin(); it != this->descriptors.end(); ++it) {
+        if (it->first == role) {
+            int fd = it->second;
+            this->descriptors.erase(it);
+            return fd;
+        }
+    }
+    return -1;
+}
+
+std::string DaemonHandoff::requestLine(const DiscoverySettings& settings, const UnixDomainSettings& localSettings) {
+    //handed over receivers are bound to port and joined to groups of shards, table and journal continue where running daemon stopped
+    return std::format("{} port={} multicast_shard_count={} multicast_subscribed_shards={} single_message_max_size_bytes={} checksum_enabled={} "
+        "socket_filter_enabled={} receive_worker_count={} unix_domain_socket_path={} snapshot_path={} journal_directory={}\n",
+        REQUEST_COMMAND, settings.port, settings.shardCount, settings.subscribedShards, settings.maxBufferSize, settings.useChecksum,
+        settings.useSocketFilter, settings.receiveWorkers, localSettings.socketPath, settings.snapshotPath, settings.journalDirectory);
+}
+
+Result<> DaemonHandoff::checkRequest(const std::string& line, const DiscoverySettings& settings, const UnixDomainSettings& localSettings) {
+    std::string expected = requestLine(settings, localSettings);
+    expected.pop_back();
+    if (line == expected) {
+        return Result<>{};
+    }
+
+    auto tokens = [](const std::string& text) {
+        std::vector<std::string> split{};
+        std::istringstream stream{text};
+        for (std::string token; stream >> token;) {
+            split.push_back(token);
+        }
+        return split;
+    };
+    std::vector<std::string> requested = tokens(line);
+    std::vector<std::string> own = tokens(expected);
+    if (requested.empty() || requested.front() != REQUEST_COMMAND) {
+        return Error{ErrorCode::Failed, "Malformed handoff request"};
+    }
+
+    //keys are reported, values may be paths of other user
+    std::string differing{};
+    for (std::size_t i = 1; i < own.size(); i++) {
+        if (i >= requested.size() || requested[i] != own[i]) {
+            differing += (differing.empty() ? "" : ", ") + own[i].substr(0, own[i].find('='));
+        }
+    }
+    return Error{ErrorCode::Failed, "Settings differ from running daemon:", differing.empty() ? std::string("unknown keys") : differing};
+}
+
+Result<std::optional<HandoffState>> DaemonHandoff::request(const DiscoverySettings& settings, const UnixDomainSettings& localSettings) {
+    using Return = Result<std::optional<HandoffState>>;
+
+    //missing path or stale one left by crashed daemon both mean there's nobody to take over from
+    auto clientReturn = UnixSocket::clientFactory(settings.handoffSocketPath);
+    if (!clientReturn.isOk()) {
+        return Return{std::optional<HandoffState>{}};
+    }
+    UnixSocket client = std::move(clientReturn).value();
+
+    //handoff path lies in world writable directory, socket bound there by other user would hand over its own listener and table
+    auto uidReturn = client.peerUid();
+    if (!uidReturn.isOk()) {
+        return uidReturn.within("Couldn't check running daemon");
+    }
+    if (uidReturn.value() != ::geteuid()) {
+        return Error{ErrorCode::Failed, "Handoff socket belongs to process of other user", std::format("{}, user {}", settings.handoffSocketPath, uidReturn.value())};
+    }
+
+    std::string request = requestLine(settings, localSettings);
+    auto sendReturn = client.sendSome(std::span<const std::uint8_t>(reinterpret_cast<const std::uint8_t*>(request.data()), request.size()));
+    if (!sendReturn.isOk()) {
+        return sendReturn.within("Couldn't send handoff request");
+    }
+    if (sendReturn.value() != request.size()) {
+        return Error{ErrorCode::Overflow, "Couldn't send handoff request, socket buffer full on socket", client.fd()};
+    }
+
+    //descriptors arrive with first bytes of frame, the rest of neighbor table follows as plain stream
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(settings.handoffTimeoutMs);
+    std::vector<std::uint8_t> frame{};
+    std::vector<std::uint8_t> chunk(RECEIVE_CHUNK_SIZE);
+    std::vector<int> fds{};
+    while (!Frame::size(frame).has_value() || frame.size() < Frame::size(frame).value()) {
+        if (Frame::size(frame).has_value() && Frame::size(frame).value() > Frame::HEADER_SIZE + Frame::MAX_PAYLOAD_SIZE + Frame::TRAILER_SIZE) {
+            closeDescriptors(fds);
+            return Error{ErrorCode::Overflow, "Handoff frame exceeds maximum size"};
+        }
+
+        auto waitReturn = waitFor(client.fd(), POLLIN, deadline);
+        if (!waitReturn.isOk()) {
+            closeDescriptors(fds);
+            return waitReturn.within("Couldn't wait for handoff");
+        }
+        if (!waitReturn.value()) {
+            closeDescriptors(fds);
+            return Error{ErrorCode::Failed, "Running daemon didn't hand over in time"};
+        }
+
+        auto receiveReturn = client.receiveSomeWithDescriptors(chunk, fds);
+        if (!receiveReturn.isOk()) {
+            closeDescriptors(fds);
+            return receiveReturn.within("Couldn't receive handoff");
+        }
+        frame.insert(frame.end(), chunk.begin(), chunk.begin() + receiveReturn.value());
+    }
+
+    Frame::MessageType type = Frame::messageType(frame);
+    auto openReturn = Frame::open(frame, true);
+    if (!openReturn.isOk()) {
+        closeDescriptors(fds);
+        return openReturn.within("Couldn't open handoff frame");
+    }
+    std::size_t offset = openReturn.value().offset;
+
+    if (type == Frame::MessageType::Error) {
+        closeDescriptors(fds);
+        auto reasonReturn = Deserializer::deserialize(frame, offset);
+        return Error{ErrorCode::Failed, "Running daemon refused handoff:", reasonReturn.isOk() ? std::move(reasonReturn).value() : std::string("no reason given")};
+    }
+    if (type != Frame::MessageType::Handoff) {
+        closeDescriptors(fds);
+        return Error{ErrorCode::Unsupported, "Unexpected handoff frame type", type};
+    }
+
+    auto messageReturn = HandoffMessage::deserialize(frame, offset);
+    if (!messageReturn.isOk()) {
+        closeDescriptors(fds);
+        return messageReturn.within("Couldn't decode handoff message");
+    }
+    if (messageReturn.value().roles.size() != fds.size()) {
+        closeDescriptors(fds);
+        return Error{ErrorCode::Failed, "Handoff message doesn't match received descriptors, count", static_cast<std::int64_t>(fds.size())};
+    }
+
+    HandoffMessage message = std::move(messageReturn).value();
+    std::vector<std::pair<HandoffRole, int>> descriptors{};
+    for (std::size_t i = 0; i < fds.size(); i++) {
+        descriptors.emplace_back(static_cast<HandoffRole>(message.roles[i]), fds[i]);
+    }
+    return Return{std::optional<HandoffState>{HandoffState{std::move(descriptors), std::move(message.neighborSnapshot)}}};
+}
+
+Result<> DaemonHandoff::sendFrame(UnixSocket& client, const std::vector<std::uint8_t>& frame, const std::vector<int>& fds, std::chrono::milliseconds timeout) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    std::span<const std::uint8_t> unsent = frame;
+    bool descriptorsSent = false;
+    while (!unsent.empty()) {
+        auto sendReturn = descriptorsSent ? client.sendSome(unsent) : client.sendSomeWithDescriptors(unsent, fds);
+        if (!sendReturn.isOk()) {
+            return sendReturn.within("Couldn't send handoff");
+        }
+        if (sendReturn.value() > 0) {
+            descriptorsSent = true;
+            unsent = unsent.subspan(sendReturn.value());
+            continue;
+        }
+
+        auto waitReturn = waitFor(client.fd(), POLLOUT, deadline);
+        if (!waitReturn.isOk()) {
+            return waitReturn.within("Couldn't wait for replacing daemon");
+        }
+        if (!waitReturn.value()) {
+            return Error{ErrorCode::Failed, "Replacing daemon didn't take handoff in time"};
+        }
+    }
+    return Result<>{};
+}
+
+Result<> DaemonHandoff::send(UnixSocket& client, const std::vector<std::pair<HandoffRole, int>>& descriptors,
+    std::vector<std::uint8_t> neighborSnapshot, std::chrono::milliseconds timeout) {
+    //whoever gets the sockets can read and answer in place of daemon
+    auto uidReturn = client.peerUid();
+    if (!uidReturn.isOk()) {
+        return uidReturn.within("Couldn't check handoff requestor");
+    }
+    if (uidReturn.value() != ::geteuid()) {
+        return Error{ErrorCode::Failed, "Refused handoff to process of user", static_cast<std::int64_t>(uidReturn.value())};
+    }
+
+    HandoffMessage message{};
+    std::vector<int> fds{};
+    for (const auto& [role, fd] : descriptors) {
+        message.roles.push_back(static_cast<std::uint8_t>(role));
+        fds.push_back(fd);
+    }
+    message.neighborSnapshot = std::move(neighborSnapshot);
+
+    std::vector<std::uint8_t> frame{};
+    frame.reserve(Frame::HEADER_SIZE + Codec::encodedSize(message) + Frame::TRAILER_SIZE);
+    Frame::reserveHeader(frame);
+    message.serialize(frame);
+    Frame::seal(frame, true, 0, Frame::MessageType::Handoff);
+    return sendFrame(client, frame, fds, timeout);
+}
+
+Result<> DaemonHandoff::refuse(UnixSocket& client, const std::string& reason, std::chrono::milliseconds timeout) {
+    std::vector<std::uint8_t> frame{};
+    Frame::reserveHeader(frame);
+    Serializer::serialize(frame, reason);
+    Frame::seal(frame, true, 0, Frame::MessageType::Error);
+    return sendFrame(client, frame, {}, timeout);
+}
@@ -0,0 +1,88 @@
+#pragma once
+#ifndef DAEMONHANDOFF_HPP
+#define DAEMONHANDOFF_HPP
+
+#include "Utility/Result.hpp"
+#include "Unix/UnixSocket.hpp"
+#include "Protocol/HandoffMessage.hpp"
+#include "DiscoverySettings.hpp"
+#include "Unix/UnixDomainSettings.hpp"
+
+#include <string>
+#include <vector>
+#include <optional>
+#include <utility>
+#include <chrono>
+#include <cstdint>
+
+using Utility::Result;
+using Unix::UnixSocket;
+using Network::Protocol::HandoffRole;
+using Network::DiscoverySettings;
+using Unix::UnixDomainSettings;
+
+namespace Network {
+    //descriptors and neighbor table replacing daemon took over, descriptors it doesn't take are closed with it
+    class HandoffState {
+    private:
+        std::vector<std::pair<HandoffRole, int>> descriptors{};
+
+    public:
+        //NeighborSnapshot encoding, restored instead of snapshot file
+        std::vector<std::uint8_t> neighborSnapshot{};
+
+        HandoffState() = default;
+        HandoffState(std::vector<std::pair<HandoffRole, int>> descriptors, std::vector<std::uint8_t> neighborSnapshot)
+            : descriptors{std::move(descriptors)}, neighborSnapshot{std::move(neighborSnapshot)} {}
+
+        HandoffState(const HandoffState&) = delete;
+        HandoffState& operator=(const HandoffState&) = delete;
+
+        HandoffState(HandoffState&& other) noexcept
+            : descriptors{std::move(other.descriptors)}, neighborSnapshot{std::move(other.neighborSnapshot)} {
+            other.descriptors.clear();
+        }
+
+        HandoffState& operator=(HandoffState&& other) noexcept;
+
+        ~HandoffState();
+
+        //caller owns returned descriptor, -1 if running daemon had no socket of that role
+        int take(HandoffRole role);
+
+        std::size_t descriptorCount() const {
+            return this->descriptors.size();
+        }
+    };
+
+    //zero downtime restart: started daemon connects to handoff socket of running one and sends request line with its restart only settings,
+    //running daemon with the same settings answers with handoff frame carrying its listening UNIX domain socket and multicast receivers as SCM_RIGHTS
+    //along with its neighbor table, then stops without unlinking socket paths
+    //sockets stay bound and joined to multicast groups meanwhile, so neither CLI clients nor peers see them go away
+    //daemon with other settings gets error frame instead and running daemon keeps running
+    class DaemonHandoff {
+    private:
+        static Result<> sendFrame(UnixSocket& client, const std::vector<std::uint8_t>& frame, const std::vector<int>& fds, std::chrono::milliseconds timeout);
+
+    public:
+        static constexpr char REQUEST_COMMAND[] = "handoff";
+        static constexpr std::size_t MAX_REQUEST_SIZE = 4096u;
+
+        //"handoff key=value ...\n" with settings file keys of settings handed over sockets and neighbor table depend on
+        static std::string requestLine(const DiscoverySettings& settings, const UnixDomainSettings& localSettings);
+        //fails naming keys whose values differ from passed settings, request line is passed without newline
+        static Result<> checkRequest(const std::string& line, const DiscoverySettings& settings, const UnixDomainSettings& localSettings);
+
+        //started daemon side, empty if no daemon listens on handoff socket of settings
+        //only daemon of the same user is trusted, fails if running daemon refused or couldn't hand over
+        static Result<std::optional<HandoffState>> request(const DiscoverySettings& settings, const UnixDomainSettings& localSettings);
+
+        //running daemon side, answers client whose request passed checkRequest, only processes of the same user are answered
+        static Result<> send(UnixSocket& client, const std::vector<std::pair<HandoffRole, int>>& descriptors,
+            std::vector<std::uint8_t> neighborSnapshot, std::chrono::milliseconds timeout);
+        //tells client why it gets no sockets
+        static Result<> refuse(UnixSocket& client, const std::string& reason, std::chrono::milliseconds timeout);
+    };
+}
+
+#endif
@@ -0,0 +1,129 @@
+#include "NeighborPage.hpp"
+#include "NeighborLatency.hpp"
+#include "NeighborLoss.hpp"
+#include "Utility/Serialization/Deserializer.hpp"
+#include "Utility/Result.hpp"
+
+#include <vector>
+#include <span>
+#include <cstdint>
+
+using Network::NeighborPage;
+using Network::NeighborLatency;
+using Network::NeighborLoss;
+using Network::LossReport;
+using Network::NetInterfaces::NetInterface;
+using Utility::Serialization::Deserializer;
+using Utility::Result;
+
+Result<NeighborPage> NeighborPage::deserializeImpl(std::span<const std::uint8_t> buff, std::size_t& offset) {
+    NeighborPage page;
+
+    auto funcReturn = Deserializer::deserialize<std::uint64_t>(buff, offset);
+    if (!funcReturn.isOk()) {
+        return funcReturn.within("Couldn't deserialize neighbor page generation");
+    }
+    page.generation = funcReturn.value();
+
+    auto funcReturn1 = Deserializer::deserialize(buff, offset);
+    if (!funcReturn1.isOk()) {
+        return funcReturn1.within("Couldn't deserialize neighbor page cursor");
+    }
+    page.cursor = std::move(funcReturn1).value();
+
+    auto funcReturn2 = Deserializer::deserialize<NetInterface>(buff, offset);
+    if (!funcReturn2.isOk()) {
+        return funcReturn2.within("Couldn't deserialize neighbor page neighbors");
+    }
+    page.neighbors = std::move(funcReturn2).value();
+
+    return Result<NeighborPage>{std::move(page)};
+}
+
+Result<NeighborLatency> NeighborLatency::deserializeImpl(std::span<const std::uint8_t> buff, std::size_t& offset) {
+    NeighborLatency latency;
+
+    auto funcReturn = Deserializer::deserialize(buff, offset);
+    if (!funcReturn.isOk()) {
+        return funcReturn.within("Couldn't deserialize neighbor latency MAC");
+    }
+    latency.mac = std::move(funcReturn).value();
+
+    //remaining fields are counters of the same width, in declaration order
+    for (std::uint32_t* field : {&latency.samples, &latency.smoothedRttUs, &latency.jitterUs, &latency.p50RttUs,
+        &latency.p90RttUs, &latency.p99RttUs, &latency.lossPermille}) {
+        auto funcReturn1 = Deserializer::deserialize<std::uint32_t>(buff, offset);
+        if (!funcReturn1.isOk()) {
+            return funcReturn1.within("Couldn't deserialize neighbor latency");
+        }
+        *field = funcReturn1.value();
+    }
+
+    return Result<NeighborLatency>{std::move(latency)};
+}
+
+Result<NeighborLoss> NeighborLoss::deserializeImpl(std::span<const std::uint8_t> buff, std::size_t& offset) {
+    NeighborLoss loss;
+
+    for (std::string* field : {&loss.sender, &loss.macs}) {
+        auto funcReturn = Deserializer::deserialize(buff, offset);
+        if (!funcReturn.isOk()) {
+            return funcReturn.within("Couldn't deserialize neighbor loss sender");
+        }
+        *field = std::move(funcReturn).value();
+    }
+
+    auto funcReturn1 = Deserializer::deserialize<std::uint64_t>(buff, offset);
+    if (!funcReturn1.isOk()) {
+        return funcReturn1.within("Couldn't deserialize neighbor loss epoch");
+    }
+    loss.epoch = funcReturn1.value();
+
+    auto funcReturn2 = Deserializer::deserialize<std::uint32_t>(buff, offset);
+    if (!funcReturn2.isOk()) {
+        return funcReturn2.within("Couldn't deserialize neighbor loss restarts");
+    }
+    loss.restarts = funcReturn2.value();
+
+    for (std::uint64_t* field : {&loss.received, &loss.lost, &loss.reordered, &loss.duplicates}) {
+        auto funcReturn3 = Deserializer::deserialize<std::uint64_t>(buff, offset);
+        if (!funcReturn3.isOk()) {
+            return funcReturn3.within("Couldn't deserialize neighbor loss counters");
+        }
+        *field = funcReturn3.value();
+    }
+
+    for (std::uint32_t* field : {&loss.intervalMs, &loss.intervalJitterMs}) {
+        auto funcReturn4 = Deserializer::deserialize<std::uint32_t>(buff, offset);
+        if (!funcReturn4.isOk()) {
+            return funcReturn4.within("Couldn't deserialize neighbor loss interval");
+        }
+        *field = funcReturn4.value();
+    }
+
+    return Result<NeighborLoss>{std::move(loss)};
+}
+
+Result<LossReport> LossReport::deserializeImpl(std::span<const std::uint8_t> buff, std::size_t& offset) {
+    LossReport report;
+
+    auto funcReturn = Deserializer::deserialize<std::uint64_t>(buff, offset);
+    if (!funcReturn.isOk()) {
+        return funcReturn.within("Couldn't deserialize loss report kernel drops");
+    }
+    report.kernelDrops = funcReturn.value();
+
+    auto funcReturn1 = NeighborLoss::deserialize(buff, offset);
+    if (!funcReturn1.isOk()) {
+        return funcReturn1.within("Couldn't deserialize loss report total");
+    }
+    report.total = std::move(funcReturn1).value();
+
+    auto funcReturn2 = Deserializer::deserialize<NeighborLoss>(buff, offset);
+    if (!funcReturn2.isOk()) {
+        return funcReturn2.within("Couldn't deserialize loss report senders");
+    }
+    report.senders = std::move(funcReturn2).value();
+
+    return Result<LossReport>{std::move(report)};
+}
@@ -3,14 +3,40 @@
 #define DISCOVERYSETTINGS_HPP
 
 #include <cstdint>
+#include <string>
 
 namespace Network {
     class DiscoverySettings {
     public:
         std::uint16_t port;
+        unsigned int shardCount;
+        std::string subscribedShards;
         unsigned int sendingPeriodS;
         unsigned int neighborActivityPeriodS;
+        unsigned int solicitResponseMaxDelayMs;
+        unsigned int solicitResponseMinIntervalMs;
         unsigned int maxBufferSize;
+        bool useChecksum;
+        bool useSocketFilter;
+        unsigned int receiveBufferSize;
+        unsigned int maxReceiveBufferSize;
+        unsigned int sendBufferSize;
+        unsigned int receiveWorkers;
+        bool useIoUring;
+        unsigned int ioUringQueueDepth;
+        unsigned int ioUringReceiveBuffers;
+        unsigned int probePeriodMs;
+        unsigned int probeMaxPerSecond;
+        unsigned int probeTimeoutMs;
+        unsigned int probeReplyMaxPerSecond;
+        unsigned int compressionThreshold;
+        std::string snapshotPath;
+        unsigned int snapshotPeriodS;
+        std::string journalDirectory;
+        unsigned int journalSegmentSize;
+        unsigned int journalMaxSegments;
+        std::string handoffSocketPath;
+        unsigned int handoffTimeoutMs;
     };
 }
 
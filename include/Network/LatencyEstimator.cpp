@@ -0,0 +1,76 @@
+#include "LatencyEstimator.hpp"
+
+#include <algorithm>
+#include <vector>
+#include <cmath>
+
+using Network::LatencyEstimator;
+using Network::NeighborLatency;
+
+namespace {
+    constexpr double RTT_GAIN = 1.0 / 8.0;
+    constexpr double JITTER_GAIN = 1.0 / 16.0;
+
+    std::uint32_t percentile(std::vector<std::uint32_t> values, unsigned int percent) {
+        if (values.empty()) {
+            return 0;
+        }
+        std::size_t rank = (values.size() - 1) * percent / 100;
+        std::ranges::nth_element(values, values.begin() + rank);
+        return values[rank];
+    }
+}
+
+void LatencyEstimator::addOutcome(bool answered) {
+    this->recentOutcomes.push_back(answered);
+    if (this->recentOutcomes.size() > WINDOW) {
+        this->recentOutcomes.pop_front();
+    }
+}
+
+void LatencyEstimator::addSample(std::chrono::microseconds rtt) {
+    double rttUs = static_cast<double>(std::max<std::int64_t>(rtt.count(), 0));
+    if (!this->smoothedRttUs.has_value()) {
+        this->smoothedRttUs = rttUs;
+    } else {
+        this->jitterUs += (std::abs(rttUs - this->smoothedRttUs.value()) - this->jitterUs) * JITTER_GAIN;
+        this->smoothedRttUs = this->smoothedRttUs.value() + (rttUs - this->smoothedRttUs.value()) * RTT_GAIN;
+    }
+    this->samples++;
+
+    this->recentRttsUs.push_back(static_cast<std::uint32_t>(std::min(rttUs, 4294967295.0)));
+    if (this->recentRttsUs.size() > WINDOW) {
+        this->recentRttsUs.pop_front();
+    }
+    this->addOutcome(true);
+}
+
+void LatencyEstimator::addLoss() {
+    this->addOutcome(false);
+}
+
+std::optional<std::chrono::microseconds> LatencyEstimator::smoothedRtt() const {
+    if (!this->smoothedRttUs.has_value()) {
+        return std::nullopt;
+    }
+    return std::chrono::microseconds(static_cast<std::int64_t>(this->smoothedRttUs.value()));
+}
+
+NeighborLatency LatencyEstimator::report(const std::string& mac) const {
+    NeighborLatency latency{};
+    latency.mac = mac;
+    latency.samples = this->samples;
+    latency.smoothedRttUs = static_cast<std::uint32_t>(this->smoothedRttUs.value_or(0.0));
+    latency.jitterUs = static_cast<std::uint32_t>(this->jitterUs);
+
+    std::vector<std::uint32_t> rtts(this->recentRttsUs.begin(), this->recentRttsUs.end());
+    latency.p50RttUs = percentile(rtts, 50);
+    latency.p90RttUs = percentile(rtts, 90);
+    latency.p99RttUs = percentile(std::move(rtts), 99);
+
+    if (!this->recentOutcomes.empty()) {
+        auto lost = std::ranges::count(this->recentOutcomes, false);
+        latency.lossPermille = static_cast<std::uint32_t>(lost * 1000 / this->recentOutcomes.size());
+    }
+    return latency;
+}
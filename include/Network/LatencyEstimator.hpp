@@ -0,0 +1,42 @@
+#pragma once
+#ifndef LATENCYESTIMATOR_HPP
+#define LATENCYESTIMATOR_HPP
+
+#include "NeighborLatency.hpp"
+
+#include <string>
+#include <deque>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <optional>
+
+namespace Network {
+    //round trip statistics of one neighbor, fed with probe outcomes in order they are resolved
+    //smoothed RTT uses TCP's 1/8 gain, jitter is mean RTT deviation with RTP's 1/16 gain
+    class LatencyEstimator {
+    public:
+        //recent outcomes percentiles and loss are computed from
+        static constexpr std::size_t WINDOW = 64u;
+
+    private:
+        std::optional<double> smoothedRttUs{};
+        double jitterUs = 0.0;
+        std::uint32_t samples = 0;
+        std::deque<std::uint32_t> recentRttsUs{};
+        //true for answered probe, false for lost one
+        std::deque<bool> recentOutcomes{};
+
+        void addOutcome(bool answered);
+
+    public:
+        void addSample(std::chrono::microseconds rtt);
+        void addLoss();
+
+        //empty until first probe is answered
+        std::optional<std::chrono::microseconds> smoothedRtt() const;
+        NeighborLatency report(const std::string& mac) const;
+    };
+}
+
+#endif
@@ -0,0 +1,88 @@
+#include "MulticastShards.hpp"
+
+#include "Utility/Result.hpp"
+#include "Utility/Hashing/PayloadFingerprint.hpp"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+
+#include <string>
+#include <vector>
+#include <sstream>
+#include <algorithm>
+#include <format>
+
+using Network::MulticastShards;
+using Utility::Result;
+using Utility::Error;
+using Utility::ErrorCode;
+using Utility::Hashing::PayloadFingerprint;
+
+unsigned int MulticastShards::shardOf(const std::string& mac, unsigned int shardCount) {
+    if (shardCount <= 1) {
+        return 0;
+    }
+    std::uint64_t hash = PayloadFingerprint::compute(reinterpret_cast<const std::uint8_t*>(mac.data()), mac.size());
+    return static_cast<unsigned int>(hash % shardCount);
+}
+
+Result<std::string> MulticastShards::group(const std::string& baseGroup, unsigned int index) {
+    if (baseGroup.find(':') == std::string::npos) {
+        ::in_addr addr{};
+        if (::inet_pton(AF_INET, baseGroup.c_str(), &addr) != 1) {
+            return Error{ErrorCode::Failed, "Invalid IPv4 multicast group", baseGroup};
+        }
+        addr.s_addr = ::htonl(::ntohl(addr.s_addr) + index);
+
+        char addrbuf[INET_ADDRSTRLEN];
+        ::inet_ntop(AF_INET, &addr, addrbuf, sizeof(addrbuf));
+        return Result<std::string>{std::string(addrbuf)};
+    }
+
+    ::in6_addr addr{};
+    if (::inet_pton(AF_INET6, baseGroup.c_str(), &addr) != 1) {
+        return Error{ErrorCode::Failed, "Invalid IPv6 multicast group", baseGroup};
+    }
+    unsigned int last = (static_cast<unsigned int>(addr.s6_addr[14]) << 8 | addr.s6_addr[15]) + index;
+    if (last > 0xFFFFu) {
+        return Error{ErrorCode::Overflow, "Multicast group can't be advanced that far", std::format("{} by {}", baseGroup, index)};
+    }
+    addr.s6_addr[14] = static_cast<std::uint8_t>(last >> 8);
+    addr.s6_addr[15] = static_cast<std::uint8_t>(last);
+
+    char addrbuf[INET6_ADDRSTRLEN];
+    ::inet_ntop(AF_INET6, &addr, addrbuf, sizeof(addrbuf));
+    return Result<std::string>{std::string(addrbuf)};
+}
+
+Result<std::vector<unsigned int>> MulticastShards::parseSubscription(const std::string& shards, unsigned int shardCount) {
+    std::vector<unsigned int> subscribed{};
+
+    std::istringstream stream(shards);
+    std::string token;
+    while (std::getline(stream, token, ',')) {
+        if (token.empty()) {
+            continue;
+        }
+        try {
+            unsigned long shard = std::stoul(token);
+            if (shard >= shardCount) {
+                return Error{ErrorCode::Failed, "Shard out of range", std::format("{}, shard count is {}", shard, shardCount)};
+            }
+            subscribed.push_back(static_cast<unsigned int>(shard));
+        } catch (const std::exception&) {
+            return Error{ErrorCode::Failed, "Invalid shard", "\"" + token + "\""};
+        }
+    }
+
+    if (subscribed.empty()) {
+        for (unsigned int shard = 0; shard < std::max(shardCount, 1u); shard++) {
+            subscribed.push_back(shard);
+        }
+    }
+
+    std::ranges::sort(subscribed);
+    auto duplicates = std::ranges::unique(subscribed);
+    subscribed.erase(duplicates.begin(), duplicates.end());
+    return Result<std::vector<unsigned int>>{std::move(subscribed)};
+}
@@ -0,0 +1,28 @@
+#pragma once
+#ifndef MULTICASTSHARDS_HPP
+#define MULTICASTSHARDS_HPP
+
+#include "Utility/Result.hpp"
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+using Utility::Result;
+
+namespace Network {
+    //announcements are spread over shardCount multicast groups that follow the configured base group
+    //every interface announces into the shard of its MAC, group right after the last shard carries shard digests
+    class MulticastShards {
+    public:
+        static unsigned int shardOf(const std::string& mac, unsigned int shardCount);
+
+        //base group advanced by index, IPv4 in the last octets, IPv6 in the last 16 bits
+        static Result<std::string> group(const std::string& baseGroup, unsigned int index);
+
+        //parses comma separated shard indexes, empty list selects all shards
+        static Result<std::vector<unsigned int>> parseSubscription(const std::string& shards, unsigned int shardCount);
+    };
+}
+
+#endif
@@ -0,0 +1,40 @@
+#pragma once
+#ifndef NEIGHBORLATENCY_HPP
+#define NEIGHBORLATENCY_HPP
+
+#include "Utility/Serialization/ISerializable.hpp"
+#include "Utility/Serialization/IDeserializable.hpp"
+#include "Utility/Result.hpp"
+
+#include <string>
+#include <vector>
+#include <span>
+#include <cstdint>
+
+using Utility::Serialization::ISerializable;
+using Utility::Serialization::IDeserializable;
+using Utility::Result;
+
+namespace Network {
+    //echo probe measurements of one neighbor, times in microseconds
+    //smoothed RTT and jitter are EWMAs, percentiles and loss cover recent probes only
+    struct NeighborLatency : public ISerializable, public IDeserializable<NeighborLatency> {
+        std::string mac{};
+        std::uint32_t samples{};
+        std::uint32_t smoothedRttUs{};
+        std::uint32_t jitterUs{};
+        std::uint32_t p50RttUs{};
+        std::uint32_t p90RttUs{};
+        std::uint32_t p99RttUs{};
+        //per mille of recent probes left unanswered
+        std::uint32_t lossPermille{};
+
+        ~NeighborLatency() = default;
+
+        void serialize(std::vector<std::uint8_t>& buff) const;
+        //used by IDeserializable interface to handle deserialization statically
+        static Result<NeighborLatency> deserializeImpl(std::span<const std::uint8_t> buff, std::size_t& offset);
+    };
+}
+
+#endif
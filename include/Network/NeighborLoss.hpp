@@ -0,0 +1,57 @@
+#pragma once
+#ifndef NEIGHBORLOSS_HPP
+#define NEIGHBORLOSS_HPP
+
+#include "Utility/Serialization/ISerializable.hpp"
+#include "Utility/Serialization/IDeserializable.hpp"
+#include "Utility/Result.hpp"
+
+#include <string>
+#include <vector>
+#include <span>
+#include <cstdint>
+
+using Utility::Serialization::ISerializable;
+using Utility::Serialization::IDeserializable;
+using Utility::Result;
+
+namespace Network {
+    //announcement sequence statistics of one sender, counters cover its current epoch only
+    struct NeighborLoss : public ISerializable, public IDeserializable<NeighborLoss> {
+        std::string sender{};
+        //MACs accepted from sender's latest decoded announcement, comma separated
+        std::string macs{};
+        //origin of sender's frames, changes when sender restarts
+        std::uint64_t epoch{};
+        std::uint32_t restarts{};
+        std::uint64_t received{};
+        //sequence gaps, decreased again when missing announcement arrives late
+        std::uint64_t lost{};
+        std::uint64_t reordered{};
+        std::uint64_t duplicates{};
+        //smoothed time between consecutive sequence numbers and its mean deviation
+        std::uint32_t intervalMs{};
+        std::uint32_t intervalJitterMs{};
+
+        ~NeighborLoss() = default;
+
+        void serialize(std::vector<std::uint8_t>& buff) const;
+        //used by IDeserializable interface to handle deserialization statically
+        static Result<NeighborLoss> deserializeImpl(std::span<const std::uint8_t> buff, std::size_t& offset);
+    };
+
+    //per sender statistics with their sum, kernel drops of own sockets tell local overflow apart from network loss
+    struct LossReport : public ISerializable, public IDeserializable<LossReport> {
+        std::uint64_t kernelDrops{};
+        NeighborLoss total{};
+        std::vector<NeighborLoss> senders{};
+
+        ~LossReport() = default;
+
+        void serialize(std::vector<std::uint8_t>& buff) const;
+        //used by IDeserializable interface to handle deserialization statically
+        static Result<LossReport> deserializeImpl(std::span<const std::uint8_t> buff, std::size_t& offset);
+    };
+}
+
+#endif
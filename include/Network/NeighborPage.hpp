@@ -0,0 +1,36 @@
+#pragma once
+#ifndef NEIGHBORPAGE_HPP
+#define NEIGHBORPAGE_HPP
+
+#include "NetInterfaces/NetInterface.hpp"
+#include "Utility/Serialization/ISerializable.hpp"
+#include "Utility/Serialization/IDeserializable.hpp"
+#include "Utility/Result.hpp"
+
+#include <string>
+#include <vector>
+#include <span>
+#include <cstdint>
+
+using Utility::Serialization::ISerializable;
+using Utility::Serialization::IDeserializable;
+using Utility::Result;
+using Network::NetInterfaces::NetInterface;
+
+namespace Network {
+    //part of neighbor table in MAC order, next page is requested with after=cursor until cursor comes back empty
+    //generation changes with every change of the table, so differing generations mean pages aren't one consistent view
+    struct NeighborPage : public ISerializable, public IDeserializable<NeighborPage> {
+        std::uint64_t generation{};
+        std::string cursor{};
+        std::vector<NetInterface> neighbors{};
+
+        ~NeighborPage() = default;
+
+        void serialize(std::vector<std::uint8_t>& buff) const;
+        //used by IDeserializable interface to handle deserialization statically
+        static Result<NeighborPage> deserializeImpl(std::span<const std::uint8_t> buff, std::size_t& offset);
+    };
+}
+
+#endif
@@ -0,0 +1,203 @@
+#include "NeighborQuery.hpp"
+
+#include "Utility/Result.hpp"
+
+#include <arpa/inet.h>
+#include <endian.h>
+
+#include <string>
+#include <sstream>
+#include <algorithm>
+#include <iterator>
+#include <cctype>
+#include <climits>
+#include <cstring>
+
+using Network::NeighborQuery;
+using Network::NetInterfaces::SubnetTable;
+using Utility::Result;
+using Utility::Error;
+using Utility::ErrorCode;
+
+namespace {
+    std::string lowercase(std::string text) {
+        std::ranges::transform(text, text.begin(), [](unsigned char c){ return static_cast<char>(std::tolower(c)); });
+        return text;
+    }
+}
+
+Result<NeighborQuery> NeighborQuery::fromRequest(const UnixRequest& request) {
+    NeighborQuery query{};
+
+    if (auto mac = request.option("mac"); mac.has_value()) {
+        query.macPrefix = lowercase(mac.value());
+    }
+
+    if (auto interfaceName = request.option("interface"); interfaceName.has_value()) {
+        query.interfaceName = interfaceName.value();
+    }
+
+    if (auto cidr = request.option("cidr"); cidr.has_value()) {
+        Subnet subnet{};
+        std::string address = cidr.value();
+        auto separator = address.find('/');
+        if (separator != std::string::npos) {
+            address = address.substr(0, separator);
+        }
+
+        if (::inet_pton(AF_INET, address.c_str(), subnet.address.data()) == 1) {
+            subnet.family = AF_INET;
+            subnet.prefixLength = 32;
+        } else if (::inet_pton(AF_INET6, address.c_str(), subnet.address.data()) == 1) {
+            subnet.family = AF_INET6;
+            subnet.prefixLength = 128;
+        } else {
+            return Error{ErrorCode::Failed, "Invalid subnet address", "\"" + cidr.value() + "\""};
+        }
+
+        //address without prefix length selects only itself
+        if (separator != std::string::npos) {
+            try {
+                unsigned long prefixLength = std::stoul(cidr.value().substr(separator + 1));
+                if (prefixLength > subnet.prefixLength) {
+                    return Error{ErrorCode::Failed, "Prefix length out of range in", "\"" + cidr.value() + "\""};
+                }
+                subnet.prefixLength = static_cast<unsigned int>(prefixLength);
+            } catch (const std::exception&) {
+                return Error{ErrorCode::Failed, "Invalid prefix length in", "\"" + cidr.value() + "\""};
+            }
+        }
+        query.subnet = subnet;
+    }
+
+    if (auto age = request.option("age"); age.has_value()) {
+        try {
+            query.maxAge = std::chrono::seconds(std::stoul(age.value()));
+        } catch (const std::exception&) {
+            return Error{ErrorCode::Failed, "Invalid age", "\"" + age.value() + "\""};
+        }
+    }
+
+    if (auto rtt = request.option("rtt"); rtt.has_value()) {
+        try {
+            query.maxRtt = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::duration<double, std::milli>(std::stod(rtt.value())));
+        } catch (const std::exception&) {
+            return Error{ErrorCode::Failed, "Invalid rtt", "\"" + rtt.value() + "\""};
+        }
+    }
+
+    if (auto fields = request.option("fields"); fields.has_value()) {
+        query.fields = 0;
+        std::istringstream stream(fields.value());
+        std::string field;
+        while (std::getline(stream, field, ',')) {
+            if (field == "name") {
+                query.fields |= Name;
+            } else if (field == "mac") {
+                query.fields |= Mac;
+            } else if (field == "ipv4") {
+                query.fields |= IPv4;
+            } else if (field == "ipv6") {
+                query.fields |= IPv6;
+            } else {
+                return Error{ErrorCode::Failed, "Unknown field", "\"" + field + "\""};
+            }
+        }
+    }
+
+    return Result<NeighborQuery>{std::move(query)};
+}
+
+bool NeighborQuery::inSubnet(int family, const std::string& address) const {
+    if (this->subnet->family != family) {
+        return false;
+    }
+
+    std::array<std::uint8_t, 16> bytes{};
+    if (::inet_pton(family, address.c_str(), bytes.data()) != 1) {
+        return false;
+    }
+
+    unsigned int fullBytes = this->subnet->prefixLength / CHAR_BIT;
+    unsigned int remainingBits = this->subnet->prefixLength % CHAR_BIT;
+    if (std::memcmp(bytes.data(), this->subnet->address.data(), fullBytes) != 0) {
+        return false;
+    }
+
+    if (remainingBits > 0) {
+        std::uint8_t mask = static_cast<std::uint8_t>(0xFF << (CHAR_BIT - remainingBits));
+        return (bytes[fullBytes] & mask) == (this->subnet->address[fullBytes] & mask);
+    }
+    return true;
+}
+
+std::optional<NetInterface> NeighborQuery::apply(const NetInterface& nif, std::chrono::steady_clock::duration age,
+    std::optional<std::chrono::microseconds> rtt) const {
+    if (this->maxAge.has_value() && age > this->maxAge.value()) {
+        return std::nullopt;
+    }
+    if (this->maxRtt.has_value() && (!rtt.has_value() || rtt.value() > this->maxRtt.value())) {
+        return std::nullopt;
+    }
+    if (!this->interfaceName.empty() && nif.name != this->interfaceName) {
+        return std::nullopt;
+    }
+    if (!this->macPrefix.empty() && !lowercase(nif.mac).starts_with(this->macPrefix)) {
+        return std::nullopt;
+    }
+
+    NetInterface selected{};
+    selected.name = nif.name;
+    selected.mac = nif.mac;
+
+    //with subnet only addresses inside of it are sent, neighbor without any is left out
+    if (this->subnet.has_value()) {
+        std::ranges::copy_if(nif.ipv4s, std::back_inserter(selected.ipv4s), [&](const auto& ipv4){ return this->inSubnet(AF_INET, ipv4.address); });
+        std::ranges::copy_if(nif.ipv6s, std::back_inserter(selected.ipv6s), [&](const auto& ipv6){ return this->inSubnet(AF_INET6, ipv6.address); });
+        if (selected.ipv4s.empty() && selected.ipv6s.empty()) {
+            return std::nullopt;
+        }
+    } else {
+        selected.ipv4s = nif.ipv4s;
+        selected.ipv6s = nif.ipv6s;
+    }
+
+    if ((this->fields & Name) == 0) {
+        selected.name.clear();
+    }
+    if ((this->fields & Mac) == 0) {
+        selected.mac.clear();
+    }
+    if ((this->fields & IPv4) == 0) {
+        selected.ipv4s.clear();
+    }
+    if ((this->fields & IPv6) == 0) {
+        selected.ipv6s.clear();
+    }
+
+    return selected;
+}
+
+bool NeighborQuery::matchSubnet(const AddressColumns& addresses, std::vector<std::uint8_t>& ipv4Matches, std::vector<std::uint8_t>& ipv6Matches) const {
+    if (!this->subnet.has_value()) {
+        return false;
+    }
+    ipv4Matches.assign(addresses.ipv4s.size(), 0);
+    ipv6Matches.assign(addresses.ipv6Highs.size(), 0);
+
+    unsigned int prefixLength = this->subnet->prefixLength;
+    if (this->subnet->family == AF_INET) {
+        std::uint32_t network = 0;
+        std::memcpy(&network, this->subnet->address.data(), sizeof(network));
+        std::uint32_t mask = prefixLength == 0 ? 0u : ~std::uint32_t{0} << (32u - prefixLength);
+        SubnetTable::matchIPv4Subnet(addresses, ::ntohl(network), mask, ipv4Matches);
+    } else {
+        std::uint64_t networkHigh = 0, networkLow = 0;
+        std::memcpy(&networkHigh, this->subnet->address.data(), sizeof(networkHigh));
+        std::memcpy(&networkLow, this->subnet->address.data() + sizeof(networkHigh), sizeof(networkLow));
+        std::uint64_t maskHigh = prefixLength == 0 ? 0u : ~std::uint64_t{0} << (64u - std::min(prefixLength, 64u));
+        std::uint64_t maskLow = prefixLength <= 64 ? 0u : ~std::uint64_t{0} << (128u - prefixLength);
+        SubnetTable::matchIPv6Subnet(addresses, ::be64toh(networkHigh), ::be64toh(networkLow), maskHigh, maskLow, ipv6Matches);
+    }
+    return true;
+}
@@ -0,0 +1,69 @@
+#pragma once
+#ifndef NEIGHBORQUERY_HPP
+#define NEIGHBORQUERY_HPP
+
+#include "Utility/Result.hpp"
+#include "Unix/UnixRequest.hpp"
+#include "NetInterfaces/NetInterface.hpp"
+#include "NetInterfaces/SubnetTable.hpp"
+
+#include <string>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+using Utility::Result;
+using Unix::UnixRequest;
+using Network::NetInterfaces::NetInterface;
+using Network::NetInterfaces::AddressColumns;
+
+namespace Network {
+    //neighbor list request options evaluated by daemon, so that only matching part of the table is serialized
+    //mac=MAC or MAC prefix, cidr=IPv4 or IPv6 subnet, interface=announced interface name, age=max seconds since last seen,
+    //fields=comma separated subset of name,mac,ipv4,ipv6, fields left out are sent empty
+    //rtt=max smoothed round trip milliseconds measured by echo probes, neighbors without measurement don't match
+    class NeighborQuery {
+    public:
+        enum Field : std::uint8_t {
+            Name = 1 << 0,
+            Mac = 1 << 1,
+            IPv4 = 1 << 2,
+            IPv6 = 1 << 3,
+            AllFields = Name | Mac | IPv4 | IPv6
+        };
+
+    private:
+        struct Subnet {
+            int family{};
+            std::array<std::uint8_t, 16> address{};
+            unsigned int prefixLength{};
+        };
+
+        //lowercase, compared against lowercased neighbor MAC
+        std::string macPrefix{};
+        std::optional<Subnet> subnet{};
+        std::string interfaceName{};
+        std::optional<std::chrono::seconds> maxAge{};
+        std::optional<std::chrono::microseconds> maxRtt{};
+        std::uint8_t fields = AllFields;
+
+        bool inSubnet(int family, const std::string& address) const;
+
+    public:
+        //request without query options selects every neighbor with all fields
+        static Result<NeighborQuery> fromRequest(const UnixRequest& request);
+
+        //neighbor narrowed to addresses inside subnet and requested fields, nullopt if it doesn't match
+        //rtt is smoothed round trip time of neighbor, empty if it wasn't measured
+        std::optional<NetInterface> apply(const NetInterface& nif, std::chrono::steady_clock::duration age,
+            std::optional<std::chrono::microseconds> rtt = std::nullopt) const;
+
+        //marks entries of address columns inside subnet in one vectorized pass, so whole table is narrowed before apply
+        //returns false and marks nothing if query has no subnet
+        bool matchSubnet(const AddressColumns& addresses, std::vector<std::uint8_t>& ipv4Matches, std::vector<std::uint8_t>& ipv6Matches) const;
+    };
+}
+
+#endif
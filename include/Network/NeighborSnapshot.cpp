@@ -0,0 +1,132 @@
+#include "NeighborSnapshot.hpp"
+
+#include "File/FileWriter.hpp"
+#include "File/MappedFile.hpp"
+#include "Utility/Result.hpp"
+#include "Utility/Hashing/Crc32c.hpp"
+#include "Utility/Serialization/Serializer.hpp"
+#include "Utility/Serialization/Deserializer.hpp"
+
+#include <string>
+#include <vector>
+#include <span>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+
+using Network::NeighborSnapshot;
+using File::FileWriter;
+using File::MappedFile;
+using Utility::Result;
+using Utility::Error;
+using Utility::ErrorCode;
+using Utility::Hashing::Crc32c;
+using Utility::Serialization::Serializer;
+using Utility::Serialization::Deserializer;
+
+namespace {
+    constexpr std::size_t VERSION_OFFSET = 4u;
+    constexpr std::size_t COUNT_OFFSET = 8u;
+    constexpr std::size_t CRC_OFFSET = 12u;
+    constexpr std::size_t BODY_SIZE_OFFSET = 16u;
+}
+
+Result<> NeighborSnapshot::save(const std::string& path, const IndexedTimedSet<std::string, NetInterface>& neighbors) {
+    auto writeReturn = FileWriter{path}.write(encode(neighbors));
+    if (!writeReturn.isOk()) {
+        return writeReturn.within("Couldn't write neighbor snapshot");
+    }
+    return Result<>{};
+}
+
+Result<std::size_t> NeighborSnapshot::restore(const std::string& path, IndexedTimedSet<std::string, NetInterface>& neighbors, std::chrono::steady_clock::duration maxAge) {
+    auto mapReturn = MappedFile::open(path);
+    if (!mapReturn.isOk()) {
+        return mapReturn.within("Couldn't map neighbor snapshot");
+    }
+    return decode(mapReturn.value().data(), neighbors, maxAge);
+}
+
+std::vector<std::uint8_t> NeighborSnapshot::encode(const IndexedTimedSet<std::string, NetInterface>& neighbors) {
+    std::vector<std::uint8_t> buff(HEADER_SIZE);
+
+    //steady clock isn't comparable across restarts, last seen times are stored as wall clock
+    auto steadyNow = std::chrono::steady_clock::now();
+    auto systemNow = std::chrono::system_clock::now();
+
+    std::uint32_t count = 0;
+    for (const auto& [mac, entry] : neighbors) {
+        auto lastSeen = systemNow - std::chrono::duration_cast<std::chrono::system_clock::duration>(steadyNow - entry.second);
+        std::int64_t lastSeenMs = std::chrono::duration_cast<std::chrono::milliseconds>(lastSeen.time_since_epoch()).count();
+        Serializer::serialize(buff, lastSeenMs);
+        entry.first.serialize(buff);
+        ++count;
+    }
+
+    std::uint32_t magic = MAGIC;
+    std::uint32_t crc = Crc32c::compute(buff.data() + HEADER_SIZE, buff.size() - HEADER_SIZE);
+    std::uint64_t bodySize = buff.size() - HEADER_SIZE;
+    std::memcpy(buff.data(), &magic, sizeof(magic));
+    buff[VERSION_OFFSET] = VERSION;
+    std::memcpy(buff.data() + COUNT_OFFSET, &count, sizeof(count));
+    std::memcpy(buff.data() + CRC_OFFSET, &crc, sizeof(crc));
+    std::memcpy(buff.data() + BODY_SIZE_OFFSET, &bodySize, sizeof(bodySize));
+    return buff;
+}
+
+Result<std::size_t> NeighborSnapshot::decode(std::span<const std::uint8_t> data, IndexedTimedSet<std::string, NetInterface>& neighbors, std::chrono::steady_clock::duration maxAge) {
+    std::uint32_t magic = 0;
+    std::uint32_t count = 0;
+    std::uint32_t crc = 0;
+    std::uint64_t bodySize = 0;
+    if (data.size() < HEADER_SIZE) {
+        return Error{ErrorCode::Overflow, "Neighbor snapshot truncated"};
+    }
+    std::memcpy(&magic, data.data(), sizeof(magic));
+    std::memcpy(&count, data.data() + COUNT_OFFSET, sizeof(count));
+    std::memcpy(&crc, data.data() + CRC_OFFSET, sizeof(crc));
+    std::memcpy(&bodySize, data.data() + BODY_SIZE_OFFSET, sizeof(bodySize));
+
+    if (magic != MAGIC || data[VERSION_OFFSET] != VERSION) {
+        return Error{ErrorCode::Unsupported, "Neighbor snapshot has unknown format"};
+    }
+    if (data.size() != HEADER_SIZE + bodySize) {
+        return Error{ErrorCode::Failed, "Neighbor snapshot size mismatch"};
+    }
+    if (Crc32c::compute(data.data() + HEADER_SIZE, bodySize) != crc) {
+        return Error{ErrorCode::Failed, "Neighbor snapshot checksum mismatch"};
+    }
+
+    auto steadyNow = std::chrono::steady_clock::now();
+    auto systemNow = std::chrono::system_clock::now();
+
+    std::size_t offset = HEADER_SIZE;
+    std::size_t restored = 0;
+    for (std::uint32_t i = 0; i < count; ++i) {
+        auto timeReturn = Deserializer::deserialize<std::int64_t>(data, offset);
+        if (!timeReturn.isOk()) {
+            return timeReturn.within("Couldn't restore neighbor snapshot entry");
+        }
+        auto nifReturn = NetInterface::deserialize(data, offset);
+        if (!nifReturn.isOk()) {
+            return nifReturn.within("Couldn't restore neighbor snapshot entry");
+        }
+
+        std::chrono::system_clock::time_point lastSeen{std::chrono::milliseconds(timeReturn.value())};
+        auto age = std::chrono::duration_cast<std::chrono::steady_clock::duration>(systemNow - lastSeen);
+        if (age > maxAge) {
+            continue;
+        }
+        //entries age out normally, as if daemon kept running
+        if (age < std::chrono::steady_clock::duration::zero()) {
+            age = std::chrono::steady_clock::duration::zero();
+        }
+
+        NetInterface& nif = nifReturn.value();
+        std::string mac = nif.mac;
+        neighbors.update(mac, std::move(nif), steadyNow - age);
+        ++restored;
+    }
+
+    return Result<std::size_t>{restored};
+}
@@ -0,0 +1,42 @@
+#pragma once
+#ifndef NEIGHBORSNAPSHOT_HPP
+#define NEIGHBORSNAPSHOT_HPP
+
+#include "Utility/Result.hpp"
+#include "Containers/IndexedTimedSet.hpp"
+#include "NetInterfaces/NetInterface.hpp"
+
+#include <string>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <span>
+
+using Utility::Result;
+using Containers::IndexedTimedSet;
+using Network::NetInterfaces::NetInterface;
+
+namespace Network {
+    //persists neighbor table with last seen times so restarted daemon doesn't begin with an empty one
+    //layout: magic (4B), version (1B), reserved (3B), entry count (4B), CRC32C of body (4B), body size (8B)
+    //body: per entry last seen wall clock time in ms since epoch (8B) followed by serialized network interface
+    class NeighborSnapshot {
+    public:
+        static constexpr std::uint32_t MAGIC = 0x3153444Eu; //"NDS1" in memory on little endian hosts
+        static constexpr std::uint8_t VERSION = 1u;
+        static constexpr std::size_t HEADER_SIZE = 24u;
+
+        //writes snapshot atomically (temporary file renamed over path)
+        static Result<> save(const std::string& path, const IndexedTimedSet<std::string, NetInterface>& neighbors);
+
+        //memory maps snapshot and restores entries that are younger than maxAge, returns count of restored entries
+        static Result<std::size_t> restore(const std::string& path, IndexedTimedSet<std::string, NetInterface>& neighbors, std::chrono::steady_clock::duration maxAge);
+
+        //snapshot in memory, also handed over to replacing daemon
+        static std::vector<std::uint8_t> encode(const IndexedTimedSet<std::string, NetInterface>& neighbors);
+        static Result<std::size_t> decode(std::span<const std::uint8_t> data, IndexedTimedSet<std::string, NetInterface>& neighbors, std::chrono::steady_clock::duration maxAge);
+    };
+}
+
+#endif
@@ -50,7 +50,7 @@ bool IPAddressManager::isSameSubnet(const IPv6Info& ip1, const IPv6Info& ip2) {
     }
 
     std::uint8_t fullBytes = ip1.prefixLength / CHAR_BIT;
-    std::uint8_t remainingBits = ip1.prefixLength & CHAR_BIT;
+    std::uint8_t remainingBits = ip1.prefixLength % CHAR_BIT;
     if (std::memcmp(addr1.s6_addr, addr2.s6_addr, fullBytes) != 0) {
         return false;
     }
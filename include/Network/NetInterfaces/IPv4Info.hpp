@@ -2,29 +2,39 @@
 #ifndef IPV4INFO_HPP
 #define IPV4INFO_HPP
 
-#include "Utility/Serialization/ISerializable.hpp"
-#include "Utility/Serialization/IDeserializable.hpp"
-#include "Utility/FunctionReturn.hpp"
+#include "Utility/Serialization/Codec.hpp"
+#include "Utility/Result.hpp"
 
 #include <string>
 #include <cstdint>
 #include <vector>
+#include <span>
+#include <tuple>
 
-using Utility::Serialization::ISerializable;
-using Utility::Serialization::IDeserializable;
-using Utility::FunctionReturn;
+using Utility::Serialization::Codec;
+using Utility::Serialization::Field;
+using Utility::Result;
 
 namespace Network::NetInterfaces {
-    struct IPv4Info : public ISerializable, public IDeserializable<IPv4Info> {
+    struct IPv4Info {
         std::string address;
         std::string netmask;
 
+        IPv4Info() = default;
         IPv4Info(std::string address, std::string netmask) : address{address}, netmask{netmask} {}
-        ~IPv4Info() = default;
 
-        void serialize(std::vector<std::uint8_t>& buff) const;
-        //used by IDeserializable interface to handle deserialization statically
-        static FunctionReturn<IPv4Info> deserializeImpl(const std::vector<std::uint8_t>& buff, std::size_t& offset);
+        //serialized members in wire order, codec is generated from it
+        static constexpr auto fields() {
+            return std::tuple{Field{"IPv4 address", &IPv4Info::address}, Field{"IPv4 netmask", &IPv4Info::netmask}};
+        }
+
+        void serialize(std::vector<std::uint8_t>& buff) const {
+            Codec::encode(*this, buff);
+        }
+
+        static Result<IPv4Info> deserialize(std::span<const std::uint8_t> buff, std::size_t& offset) {
+            return Codec::decode<IPv4Info>(buff, offset);
+        }
 
         bool operator==(const IPv4Info& other) const {
             return this->address == other.address
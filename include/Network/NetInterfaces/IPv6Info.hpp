@@ -2,29 +2,39 @@
 #ifndef IPV6INFO_HPP
 #define IPV6INFO_HPP
 
-#include "Utility/Serialization/ISerializable.hpp"
-#include "Utility/Serialization/IDeserializable.hpp"
-#include "Utility/FunctionReturn.hpp"
+#include "Utility/Serialization/Codec.hpp"
+#include "Utility/Result.hpp"
 
 #include <string>
 #include <cstdint>
 #include <vector>
+#include <span>
+#include <tuple>
 
-using Utility::Serialization::ISerializable;
-using Utility::Serialization::IDeserializable;
-using Utility::FunctionReturn;
+using Utility::Serialization::Codec;
+using Utility::Serialization::Field;
+using Utility::Result;
 
 namespace Network::NetInterfaces {
-    struct IPv6Info : public ISerializable, public IDeserializable<IPv6Info> {
+    struct IPv6Info {
         std::string address;
-        std::uint8_t prefixLength;
+        std::uint8_t prefixLength{};
 
+        IPv6Info() = default;
         IPv6Info(std::string address, std::uint8_t prefixLength) : address{address}, prefixLength{prefixLength} {}
-        ~IPv6Info() = default;
 
-        void serialize(std::vector<std::uint8_t>& buff) const;
-        //used by IDeserializable interface to handle deserialization statically
-        static FunctionReturn<IPv6Info> deserializeImpl(const std::vector<std::uint8_t>& buff, std::size_t& offset);
+        //serialized members in wire order, codec is generated from it
+        static constexpr auto fields() {
+            return std::tuple{Field{"IPv6 address", &IPv6Info::address}, Field{"IPv6 prefix", &IPv6Info::prefixLength}};
+        }
+
+        void serialize(std::vector<std::uint8_t>& buff) const {
+            Codec::encode(*this, buff);
+        }
+
+        static Result<IPv6Info> deserialize(std::span<const std::uint8_t> buff, std::size_t& offset) {
+            return Codec::decode<IPv6Info>(buff, offset);
+        }
 
         bool operator==(const IPv6Info& other) const {
             return this->address == other.address
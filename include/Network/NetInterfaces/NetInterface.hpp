@@ -4,28 +4,39 @@
 
 #include "IPv4Info.hpp"
 #include "IPv6Info.hpp"
-#include "Utility/Serialization/ISerializable.hpp"
-#include "Utility/Serialization/IDeserializable.hpp"
-#include "Utility/FunctionReturn.hpp"
+#include "Utility/Serialization/Codec.hpp"
+#include "Utility/Result.hpp"
 
 #include <string>
 #include <vector>
+#include <span>
 #include <cstdint>
+#include <tuple>
 
-using Utility::Serialization::ISerializable;
-using Utility::FunctionReturn;
+using Utility::Serialization::Codec;
+using Utility::Serialization::Field;
+using Utility::Result;
 
 namespace Network::NetInterfaces {
-    struct NetInterface : public ISerializable, public IDeserializable<NetInterface> {
+    struct NetInterface {
         std::string name;
         std::string mac;
         std::vector<IPv4Info> ipv4s;
         std::vector<IPv6Info> ipv6s;
 
-        ~NetInterface() = default;
-        void serialize(std::vector<std::uint8_t>& buff) const;
-        //used by IDeserializable interface to handle deserialization statically
-        static FunctionReturn<NetInterface> deserializeImpl(const std::vector<std::uint8_t>& buff, std::size_t& offset);
+        //serialized members in wire order, codec is generated from it
+        static constexpr auto fields() {
+            return std::tuple{Field{"network interface name", &NetInterface::name}, Field{"network interface MAC", &NetInterface::mac},
+                Field{"IPv4s", &NetInterface::ipv4s}, Field{"IPv6s", &NetInterface::ipv6s}};
+        }
+
+        void serialize(std::vector<std::uint8_t>& buff) const {
+            Codec::encode(*this, buff);
+        }
+
+        static Result<NetInterface> deserialize(std::span<const std::uint8_t> buff, std::size_t& offset) {
+            return Codec::decode<NetInterface>(buff, offset);
+        }
 
         bool operator==(const NetInterface& other) const {
             return this->name == other.name
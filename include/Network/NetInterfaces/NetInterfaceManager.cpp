@@ -1,5 +1,5 @@
 #include "NetInterfaceManager.hpp"
-#include "Utility/FunctionReturn.hpp"
+#include "Utility/Result.hpp"
 #include "Logging/SysLogger.hpp"
 #include "NetInterface.hpp"
 
@@ -17,16 +17,16 @@
 #include <bitset>
 #include <cstdint>
 
-using Utility::FunctionReturn;
-using Utility::ExitCode;
+using Utility::Result;
+using Utility::Error;
 using Network::NetInterfaces::NetInterface;
 using Network::NetInterfaces::NetInterfaceManager;
 
-FunctionReturn<std::vector<NetInterface>> NetInterfaceManager::getInterfaces() {
+Result<std::vector<NetInterface>> NetInterfaceManager::getInterfaces() {
     ::ifaddrs* ifaddr = nullptr;
 
     if (::getifaddrs(&ifaddr) == -1) {
-        return FunctionReturn<std::vector<NetInterface>>{ExitCode::Error, std::vector<NetInterface>()};
+        return Error::system("getifaddrs failed");
     }
 
     //free structures at the end of method
@@ -109,5 +109,5 @@ FunctionReturn<std::vector<NetInterface>> NetInterfaceManager::getInterfaces() {
         result.push_back(std::move(val.second));
     }
 
-    return FunctionReturn<std::vector<NetInterface>>{ExitCode::Ok, result};
+    return Result<std::vector<NetInterface>>{std::move(result)};
 }
\ No newline at end of file
@@ -0,0 +1,378 @@
+#include "SubnetTable.hpp"
+
+#include "NetInterface.hpp"
+
+#include <arpa/inet.h>
+#include <net/if.h>
+#include <endian.h>
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <vector>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+using Network::NetInterfaces::SubnetTable;
+using Network::NetInterfaces::AddressColumns;
+using Network::NetInterfaces::NetInterface;
+using Network::NetInterfaces::IPv4Info;
+using Network::NetInterfaces::IPv6Info;
+
+namespace {
+    //subnet tested against every entry of columns, checkMask also requires entry to have the same netmask
+    //tag 0 matches entries of any tag, entries tagged 0 match subnets of any tag
+    struct IPv4Subnet {
+        std::uint32_t network;
+        std::uint32_t mask;
+        bool checkMask;
+        std::uint32_t tag;
+    };
+
+    struct IPv6Subnet {
+        std::uint64_t networkHigh;
+        std::uint64_t networkLow;
+        std::uint64_t maskHigh;
+        std::uint64_t maskLow;
+        bool checkMask;
+        std::uint32_t tag;
+    };
+
+    bool tagMatches(std::uint32_t entryTag, std::uint32_t subnetTag) {
+        return subnetTag == 0 || entryTag == 0 || entryTag == subnetTag;
+    }
+
+    //scalar kernels also finish remainders of vector ones, starting at first
+    void matchIPv4Scalar(const AddressColumns& columns, const IPv4Subnet& subnet, std::uint8_t* out, std::size_t first) {
+        for (std::size_t i = first; i < columns.ipv4s.size(); i++) {
+            bool hit = (columns.ipv4s[i] & subnet.mask) == subnet.network
+                && (!subnet.checkMask || columns.ipv4Masks[i] == subnet.mask)
+                && tagMatches(columns.ipv4Tags[i], subnet.tag);
+            out[i] |= hit ? 1u : 0u;
+        }
+    }
+
+    void matchIPv6Scalar(const AddressColumns& columns, const IPv6Subnet& subnet, std::uint8_t* out, std::size_t first) {
+        for (std::size_t i = first; i < columns.ipv6Highs.size(); i++) {
+            bool hit = (columns.ipv6Highs[i] & subnet.maskHigh) == subnet.networkHigh
+                && (columns.ipv6Lows[i] & subnet.maskLow) == subnet.networkLow
+                && (!subnet.checkMask || (columns.ipv6MaskHighs[i] == subnet.maskHigh && columns.ipv6MaskLows[i] == subnet.maskLow))
+                && tagMatches(columns.ipv6Tags[i], subnet.tag);
+            out[i] |= hit ? 1u : 0u;
+        }
+    }
+
+    //vector kernels leave tags of IPv6 entries to scalar check of lanes that hit, tags are narrower than 64 bit lanes
+    void markIPv6Lanes(const AddressColumns& columns, const IPv6Subnet& subnet, unsigned int bits, std::size_t first, std::size_t lanes, std::uint8_t* out) {
+        for (std::size_t lane = 0; lane < lanes; lane++) {
+            if ((bits >> lane) & 1u) {
+                out[first + lane] |= tagMatches(columns.ipv6Tags[first + lane], subnet.tag) ? 1u : 0u;
+            }
+        }
+    }
+
+#if defined(__x86_64__)
+    __attribute__((target("avx2")))
+    void matchIPv4Avx2(const AddressColumns& columns, const IPv4Subnet& subnet, std::uint8_t* out) {
+        const __m256i network = _mm256_set1_epi32(static_cast<int>(subnet.network));
+        const __m256i mask = _mm256_set1_epi32(static_cast<int>(subnet.mask));
+        const __m256i tag = _mm256_set1_epi32(static_cast<int>(subnet.tag));
+        const __m256i zero = _mm256_setzero_si256();
+
+        std::size_t count = columns.ipv4s.size();
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            __m256i addresses = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(columns.ipv4s.data() + i));
+            __m256i hit = _mm256_cmpeq_epi32(_mm256_and_si256(addresses, mask), network);
+            if (subnet.checkMask) {
+                __m256i masks = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(columns.ipv4Masks.data() + i));
+                hit = _mm256_and_si256(hit, _mm256_cmpeq_epi32(masks, mask));
+            }
+            if (subnet.tag != 0) {
+                __m256i tags = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(columns.ipv4Tags.data() + i));
+                hit = _mm256_and_si256(hit, _mm256_or_si256(_mm256_cmpeq_epi32(tags, tag), _mm256_cmpeq_epi32(tags, zero)));
+            }
+
+            unsigned int bits = static_cast<unsigned int>(_mm256_movemask_ps(_mm256_castsi256_ps(hit)));
+            for (std::size_t lane = 0; lane < 8; lane++) {
+                out[i + lane] |= (bits >> lane) & 1u;
+            }
+        }
+        matchIPv4Scalar(columns, subnet, out, i);
+    }
+
+    __attribute__((target("avx2")))
+    void matchIPv6Avx2(const AddressColumns& columns, const IPv6Subnet& subnet, std::uint8_t* out) {
+        const __m256i networkHigh = _mm256_set1_epi64x(static_cast<long long>(subnet.networkHigh));
+        const __m256i networkLow = _mm256_set1_epi64x(static_cast<long long>(subnet.networkLow));
+        const __m256i maskHigh = _mm256_set1_epi64x(static_cast<long long>(subnet.maskHigh));
+        const __m256i maskLow = _mm256_set1_epi64x(static_cast<long long>(subnet.maskLow));
+
+        std::size_t count = columns.ipv6Highs.size();
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            __m256i highs = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(columns.ipv6Highs.data() + i));
+            __m256i lows = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(columns.ipv6Lows.data() + i));
+            __m256i hit = _mm256_and_si256(_mm256_cmpeq_epi64(_mm256_and_si256(highs, maskHigh), networkHigh),
+                _mm256_cmpeq_epi64(_mm256_and_si256(lows, maskLow), networkLow));
+            if (subnet.checkMask) {
+                __m256i masksHigh = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(columns.ipv6MaskHighs.data() + i));
+                __m256i masksLow = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(columns.ipv6MaskLows.data() + i));
+                hit = _mm256_and_si256(hit, _mm256_and_si256(_mm256_cmpeq_epi64(masksHigh, maskHigh), _mm256_cmpeq_epi64(masksLow, maskLow)));
+            }
+            markIPv6Lanes(columns, subnet, static_cast<unsigned int>(_mm256_movemask_pd(_mm256_castsi256_pd(hit))), i, 4, out);
+        }
+        matchIPv6Scalar(columns, subnet, out, i);
+    }
+
+    //SSE2 is part of x86-64 baseline, so it needs no detection
+    void matchIPv4Sse2(const AddressColumns& columns, const IPv4Subnet& subnet, std::uint8_t* out) {
+        const __m128i network = _mm_set1_epi32(static_cast<int>(subnet.network));
+        const __m128i mask = _mm_set1_epi32(static_cast<int>(subnet.mask));
+        const __m128i tag = _mm_set1_epi32(static_cast<int>(subnet.tag));
+        const __m128i zero = _mm_setzero_si128();
+
+        std::size_t count = columns.ipv4s.size();
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            __m128i addresses = _mm_loadu_si128(reinterpret_cast<const __m128i*>(columns.ipv4s.data() + i));
+            __m128i hit = _mm_cmpeq_epi32(_mm_and_si128(addresses, mask), network);
+            if (subnet.checkMask) {
+                __m128i masks = _mm_loadu_si128(reinterpret_cast<const __m128i*>(columns.ipv4Masks.data() + i));
+                hit = _mm_and_si128(hit, _mm_cmpeq_epi32(masks, mask));
+            }
+            if (subnet.tag != 0) {
+                __m128i tags = _mm_loadu_si128(reinterpret_cast<const __m128i*>(columns.ipv4Tags.data() + i));
+                hit = _mm_and_si128(hit, _mm_or_si128(_mm_cmpeq_epi32(tags, tag), _mm_cmpeq_epi32(tags, zero)));
+            }
+
+            unsigned int bits = static_cast<unsigned int>(_mm_movemask_ps(_mm_castsi128_ps(hit)));
+            for (std::size_t lane = 0; lane < 4; lane++) {
+                out[i + lane] |= (bits >> lane) & 1u;
+            }
+        }
+        matchIPv4Scalar(columns, subnet, out, i);
+    }
+
+    //SSE2 has no 64 bit compare, halves of 32 bit compare are combined instead
+    __m128i compareEqual64(__m128i a, __m128i b) {
+        __m128i equal = _mm_cmpeq_epi32(a, b);
+        return _mm_and_si128(equal, _mm_shuffle_epi32(equal, _MM_SHUFFLE(2, 3, 0, 1)));
+    }
+
+    void matchIPv6Sse2(const AddressColumns& columns, const IPv6Subnet& subnet, std::uint8_t* out) {
+        const __m128i networkHigh = _mm_set1_epi64x(static_cast<long long>(subnet.networkHigh));
+        const __m128i networkLow = _mm_set1_epi64x(static_cast<long long>(subnet.networkLow));
+        const __m128i maskHigh = _mm_set1_epi64x(static_cast<long long>(subnet.maskHigh));
+        const __m128i maskLow = _mm_set1_epi64x(static_cast<long long>(subnet.maskLow));
+
+        std::size_t count = columns.ipv6Highs.size();
+        std::size_t i = 0;
+        for (; i + 2 <= count; i += 2) {
+            __m128i highs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(columns.ipv6Highs.data() + i));
+            __m128i lows = _mm_loadu_si128(reinterpret_cast<const __m128i*>(columns.ipv6Lows.data() + i));
+            __m128i hit = _mm_and_si128(compareEqual64(_mm_and_si128(highs, maskHigh), networkHigh),
+                compareEqual64(_mm_and_si128(lows, maskLow), networkLow));
+            if (subnet.checkMask) {
+                __m128i masksHigh = _mm_loadu_si128(reinterpret_cast<const __m128i*>(columns.ipv6MaskHighs.data() + i));
+                __m128i masksLow = _mm_loadu_si128(reinterpret_cast<const __m128i*>(columns.ipv6MaskLows.data() + i));
+                hit = _mm_and_si128(hit, _mm_and_si128(compareEqual64(masksHigh, maskHigh), compareEqual64(masksLow, maskLow)));
+            }
+            markIPv6Lanes(columns, subnet, static_cast<unsigned int>(_mm_movemask_pd(_mm_castsi128_pd(hit))), i, 2, out);
+        }
+        matchIPv6Scalar(columns, subnet, out, i);
+    }
+#elif defined(__aarch64__)
+    //NEON is mandatory on ARM64, so it needs no detection
+    void matchIPv4Neon(const AddressColumns& columns, const IPv4Subnet& subnet, std::uint8_t* out) {
+        const uint32x4_t network = vdupq_n_u32(subnet.network);
+        const uint32x4_t mask = vdupq_n_u32(subnet.mask);
+        const uint32x4_t tag = vdupq_n_u32(subnet.tag);
+        const uint32x4_t zero = vdupq_n_u32(0);
+
+        std::size_t count = columns.ipv4s.size();
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            uint32x4_t hit = vceqq_u32(vandq_u32(vld1q_u32(columns.ipv4s.data() + i), mask), network);
+            if (subnet.checkMask) {
+                hit = vandq_u32(hit, vceqq_u32(vld1q_u32(columns.ipv4Masks.data() + i), mask));
+            }
+            if (subnet.tag != 0) {
+                uint32x4_t tags = vld1q_u32(columns.ipv4Tags.data() + i);
+                hit = vandq_u32(hit, vorrq_u32(vceqq_u32(tags, tag), vceqq_u32(tags, zero)));
+            }
+
+            std::uint32_t lanes[4];
+            vst1q_u32(lanes, hit);
+            for (std::size_t lane = 0; lane < 4; lane++) {
+                out[i + lane] |= lanes[lane] & 1u;
+            }
+        }
+        matchIPv4Scalar(columns, subnet, out, i);
+    }
+
+    void matchIPv6Neon(const AddressColumns& columns, const IPv6Subnet& subnet, std::uint8_t* out) {
+        const uint64x2_t networkHigh = vdupq_n_u64(subnet.networkHigh);
+        const uint64x2_t networkLow = vdupq_n_u64(subnet.networkLow);
+        const uint64x2_t maskHigh = vdupq_n_u64(subnet.maskHigh);
+        const uint64x2_t maskLow = vdupq_n_u64(subnet.maskLow);
+
+        std::size_t count = columns.ipv6Highs.size();
+        std::size_t i = 0;
+        for (; i + 2 <= count; i += 2) {
+            uint64x2_t hit = vandq_u64(vceqq_u64(vandq_u64(vld1q_u64(columns.ipv6Highs.data() + i), maskHigh), networkHigh),
+                vceqq_u64(vandq_u64(vld1q_u64(columns.ipv6Lows.data() + i), maskLow), networkLow));
+            if (subnet.checkMask) {
+                hit = vandq_u64(hit, vandq_u64(vceqq_u64(vld1q_u64(columns.ipv6MaskHighs.data() + i), maskHigh),
+                    vceqq_u64(vld1q_u64(columns.ipv6MaskLows.data() + i), maskLow)));
+            }
+            unsigned int bits = static_cast<unsigned int>((vgetq_lane_u64(hit, 0) & 1u) | ((vgetq_lane_u64(hit, 1) & 1u) << 1));
+            markIPv6Lanes(columns, subnet, bits, i, 2, out);
+        }
+        matchIPv6Scalar(columns, subnet, out, i);
+    }
+#else
+    void matchIPv4Portable(const AddressColumns& columns, const IPv4Subnet& subnet, std::uint8_t* out) {
+        matchIPv4Scalar(columns, subnet, out, 0);
+    }
+
+    void matchIPv6Portable(const AddressColumns& columns, const IPv6Subnet& subnet, std::uint8_t* out) {
+        matchIPv6Scalar(columns, subnet, out, 0);
+    }
+#endif
+
+    struct Kernels {
+        void (*ipv4)(const AddressColumns&, const IPv4Subnet&, std::uint8_t*);
+        void (*ipv6)(const AddressColumns&, const IPv6Subnet&, std::uint8_t*);
+        const char* name;
+    };
+
+    Kernels detect() {
+#if defined(__x86_64__)
+        if (__builtin_cpu_supports("avx2")) {
+            return Kernels{matchIPv4Avx2, matchIPv6Avx2, "AVX2"};
+        }
+        return Kernels{matchIPv4Sse2, matchIPv6Sse2, "SSE2"};
+#elif defined(__aarch64__)
+        return Kernels{matchIPv4Neon, matchIPv6Neon, "NEON"};
+#else
+        return Kernels{matchIPv4Portable, matchIPv6Portable, "scalar"};
+#endif
+    }
+
+    //resolved once, CPU features don't change during runtime
+    const Kernels& resolve() {
+        static const Kernels kernels = detect();
+        return kernels;
+    }
+
+    std::uint64_t loadHalf(const std::uint8_t* bytes) {
+        std::uint64_t half = 0;
+        std::memcpy(&half, bytes, sizeof(half));
+        return ::be64toh(half);
+    }
+
+    //prefix length split into masks of both halves
+    void prefixMasks(unsigned int prefixLength, std::uint64_t& high, std::uint64_t& low) {
+        high = prefixLength == 0 ? 0u : ~std::uint64_t{0} << (64u - std::min(prefixLength, 64u));
+        low = prefixLength <= 64 ? 0u : ~std::uint64_t{0} << (128u - prefixLength);
+    }
+}
+
+bool AddressColumns::addIPv4(const IPv4Info& ipv4, std::uint32_t tag) {
+    ::in_addr address{}, mask{};
+    if (::inet_pton(AF_INET, ipv4.address.c_str(), &address) != 1 || ::inet_pton(AF_INET, ipv4.netmask.c_str(), &mask) != 1) {
+        return false;
+    }
+    this->ipv4s.push_back(::ntohl(address.s_addr));
+    this->ipv4Masks.push_back(::ntohl(mask.s_addr));
+    this->ipv4Tags.push_back(tag);
+    return true;
+}
+
+bool AddressColumns::addIPv6(const IPv6Info& ipv6, std::uint32_t tag) {
+    ::in6_addr address{};
+    if (ipv6.prefixLength > 128 || ::inet_pton(AF_INET6, ipv6.address.c_str(), &address) != 1) {
+        return false;
+    }
+    std::uint64_t maskHigh = 0, maskLow = 0;
+    prefixMasks(ipv6.prefixLength, maskHigh, maskLow);
+
+    this->ipv6Highs.push_back(loadHalf(address.s6_addr));
+    this->ipv6Lows.push_back(loadHalf(address.s6_addr + 8));
+    this->ipv6MaskHighs.push_back(maskHigh);
+    this->ipv6MaskLows.push_back(maskLow);
+    this->ipv6Tags.push_back(tag);
+    return true;
+}
+
+void AddressColumns::clear() {
+    this->ipv4s.clear();
+    this->ipv4Masks.clear();
+    this->ipv4Tags.clear();
+    this->ipv6Highs.clear();
+    this->ipv6Lows.clear();
+    this->ipv6MaskHighs.clear();
+    this->ipv6MaskLows.clear();
+    this->ipv6Tags.clear();
+}
+
+SubnetTable SubnetTable::fromInterfaces(const std::vector<NetInterface>& nifs) {
+    SubnetTable table{};
+    for (const auto& nif : nifs) {
+        std::uint32_t ifindex = ::if_nametoindex(nif.name.c_str());
+        for (const auto& ipv4 : nif.ipv4s) {
+            table.subnets.addIPv4(ipv4, ifindex);
+        }
+        for (const auto& ipv6 : nif.ipv6s) {
+            table.subnets.addIPv6(ipv6, ifindex);
+        }
+    }
+
+    //stored as network addresses, so kernels compare masked entries directly
+    for (std::size_t i = 0; i < table.subnets.ipv4s.size(); i++) {
+        table.subnets.ipv4s[i] &= table.subnets.ipv4Masks[i];
+    }
+    for (std::size_t i = 0; i < table.subnets.ipv6Highs.size(); i++) {
+        table.subnets.ipv6Highs[i] &= table.subnets.ipv6MaskHighs[i];
+        table.subnets.ipv6Lows[i] &= table.subnets.ipv6MaskLows[i];
+    }
+    return table;
+}
+
+void SubnetTable::matchIPv4(const AddressColumns& addresses, std::vector<std::uint8_t>& out) const {
+    out.resize(addresses.ipv4s.size(), 0);
+    for (std::size_t i = 0; i < this->subnets.ipv4s.size(); i++) {
+        IPv4Subnet subnet{this->subnets.ipv4s[i], this->subnets.ipv4Masks[i], true, this->subnets.ipv4Tags[i]};
+        resolve().ipv4(addresses, subnet, out.data());
+    }
+}
+
+void SubnetTable::matchIPv6(const AddressColumns& addresses, std::vector<std::uint8_t>& out) const {
+    out.resize(addresses.ipv6Highs.size(), 0);
+    for (std::size_t i = 0; i < this->subnets.ipv6Highs.size(); i++) {
+        IPv6Subnet subnet{this->subnets.ipv6Highs[i], this->subnets.ipv6Lows[i], this->subnets.ipv6MaskHighs[i], this->subnets.ipv6MaskLows[i],
+            true, this->subnets.ipv6Tags[i]};
+        resolve().ipv6(addresses, subnet, out.data());
+    }
+}
+
+void SubnetTable::matchIPv4Subnet(const AddressColumns& addresses, std::uint32_t network, std::uint32_t mask, std::vector<std::uint8_t>& out) {
+    out.resize(addresses.ipv4s.size(), 0);
+    resolve().ipv4(addresses, IPv4Subnet{network & mask, mask, false, 0}, out.data());
+}
+
+void SubnetTable::matchIPv6Subnet(const AddressColumns& addresses, std::uint64_t networkHigh, std::uint64_t networkLow,
+    std::uint64_t maskHigh, std::uint64_t maskLow, std::vector<std::uint8_t>& out) {
+    out.resize(addresses.ipv6Highs.size(), 0);
+    resolve().ipv6(addresses, IPv6Subnet{networkHigh & maskHigh, networkLow & maskLow, maskHigh, maskLow, false, 0}, out.data());
+}
+
+const char* SubnetTable::kernel() {
+    return resolve().name;
+}
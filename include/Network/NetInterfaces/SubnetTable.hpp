@@ -0,0 +1,60 @@
+#pragma once
+#ifndef SUBNETTABLE_HPP
+#define SUBNETTABLE_HPP
+
+#include "NetInterface.hpp"
+#include "IPv4Info.hpp"
+#include "IPv6Info.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <string>
+
+namespace Network::NetInterfaces {
+    //addresses kept as structure of arrays, so subnet tests run over contiguous columns several entries per instruction
+    //IPv4 is in host order, IPv6 is split into most and least significant halves in host order
+    //tag is owner of an entry chosen by caller, e.g. interface index or position in another container
+    struct AddressColumns {
+        std::vector<std::uint32_t> ipv4s{};
+        std::vector<std::uint32_t> ipv4Masks{};
+        std::vector<std::uint32_t> ipv4Tags{};
+        std::vector<std::uint64_t> ipv6Highs{};
+        std::vector<std::uint64_t> ipv6Lows{};
+        std::vector<std::uint64_t> ipv6MaskHighs{};
+        std::vector<std::uint64_t> ipv6MaskLows{};
+        std::vector<std::uint32_t> ipv6Tags{};
+
+        //returns false and adds nothing if address or netmask doesn't parse
+        bool addIPv4(const IPv4Info& ipv4, std::uint32_t tag);
+        bool addIPv6(const IPv6Info& ipv6, std::uint32_t tag);
+        void clear();
+    };
+
+    //subnet membership kernels over AddressColumns, AVX2 or SSE2 on x86-64, NEON on ARM64, scalar elsewhere
+    //matched entries get their byte in out set to 1, other bytes are left as they are, so results of several subnets accumulate
+    class SubnetTable {
+    private:
+        //subnets stored with network address in address columns
+        AddressColumns subnets{};
+
+    public:
+        //one subnet per local address, tagged with interface index of its interface
+        static SubnetTable fromInterfaces(const std::vector<NetInterface>& nifs);
+
+        //entry matches if it's in one of subnets with the same netmask or prefix length,
+        //and its tag is 0 or equal to tag of that subnet
+        void matchIPv4(const AddressColumns& addresses, std::vector<std::uint8_t>& out) const;
+        void matchIPv6(const AddressColumns& addresses, std::vector<std::uint8_t>& out) const;
+
+        //entries inside passed subnet whatever their own netmask, tags are ignored
+        static void matchIPv4Subnet(const AddressColumns& addresses, std::uint32_t network, std::uint32_t mask, std::vector<std::uint8_t>& out);
+        static void matchIPv6Subnet(const AddressColumns& addresses, std::uint64_t networkHigh, std::uint64_t networkLow,
+            std::uint64_t maskHigh, std::uint64_t maskLow, std::vector<std::uint8_t>& out);
+
+        //name of kernels picked for this CPU
+        static const char* kernel();
+    };
+}
+
+#endif
@@ -4,14 +4,35 @@
 #include "Sockets/IPMulticastSender.hpp"
 #include "Sockets/IPMulticastReceiver.hpp"
 #include "Sockets/Constants/IPAddresses.hpp"
+#include "Utility/Result.hpp"
 #include "Utility/Serialization/Deserializer.hpp"
 #include "Utility/Serialization/Serializer.hpp"
-#include "Network/NetInterfaces/IPAddressManager.hpp"
+#include "Network/NetInterfaces/SubnetTable.hpp"
 #include "Network/NetInterfaces/IPv4Info.hpp"
 #include "Network/NetInterfaces/IPv6Info.hpp"
+#include "Utility/Hashing/PayloadFingerprint.hpp"
+#include "Protocol/Frame.hpp"
+#include "Unix/UnixRequest.hpp"
+#include "NeighborSnapshot.hpp"
+#include "NeighborQuery.hpp"
+#include "NeighborPage.hpp"
+#include "Journal/JournalEvent.hpp"
+#include "Journal/NeighborJournal.hpp"
+#include "MulticastShards.hpp"
+#include "Protocol/ShardDigest.hpp"
+#include "Protocol/FrameFilter.hpp"
+#include "Protocol/ProbeMessage.hpp"
+#include "NeighborLatency.hpp"
+#include "DaemonHandoff.hpp"
+#include "Protocol/HandoffMessage.hpp"
 
 #include <net/if.h>
 #include <syslog.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/signalfd.h>
+#include <signal.h>
+#include <unistd.h>
 
 #include <cstdint>
 #include <chrono>
@@ -19,9 +40,13 @@
 #include <vector>
 #include <ranges>
 #include <algorithm>
+#include <iterator>
 #include <string>
 #include <sstream>
 #include <unordered_map>
+#include <thread>
+#include <cerrno>
+#include <cstring>
 
 using Network::NetworkNeighborDiscoverer;
 using Network::NetInterfaces::IPv4Info;
@@ -32,286 +57,1841 @@ using Network::Sockets::IPMulticastSender;
 using Network::Sockets::IPMulticastReceiver;
 using Unix::UnixSocket;
 using Network::NetInterfaces::NetInterface;
-using Network::NetInterfaces::IPAddressManager;
+using Network::NetInterfaces::SubnetTable;
+using Network::NetInterfaces::AddressColumns;
 using Utility::Serialization::Deserializer;
 using Utility::Serialization::Serializer;
+using Utility::Serialization::Codec;
+using Utility::Hashing::PayloadFingerprint;
+using Network::Protocol::Frame;
+using Unix::UnixRequest;
+using Containers::UpdateResult;
+using Journal::JournalEvent;
+using Journal::JournalEventType;
+using Journal::NeighborJournal;
+using Network::MulticastShards;
+using Network::NeighborQuery;
+using Network::NeighborPage;
+using Network::Protocol::ShardDigest;
+using Network::Protocol::FrameFilter;
+using Network::Protocol::ProbeMessage;
+using Network::NeighborLatency;
+using Network::DaemonHandoff;
+using Network::Protocol::HandoffRole;
+using Network::NeighborLoss;
+using Network::LossReport;
+using Utility::Result;
+using Utility::Error;
+using Utility::ErrorCode;
 
+namespace {
+    std::int64_t wallClockMs() {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    //bounds time before received datagrams are applied and other work gets its turn under sustained load
+    constexpr int MAX_DATAGRAMS_PER_BATCH = 256;
+    //neighbors expire, journal is flushed and snapshot considered this often
+    constexpr auto MAINTENANCE_PERIOD = std::chrono::seconds(1);
+
+    //kernel stamps datagrams with realtime clock, neighbor table runs on steady clock
+    std::chrono::steady_clock::time_point steadyArrival(std::chrono::system_clock::time_point arrival) {
+        auto queued = std::max(std::chrono::system_clock::now() - arrival, std::chrono::system_clock::duration::zero());
+        return std::chrono::steady_clock::now() - std::chrono::duration_cast<std::chrono::steady_clock::duration>(queued);
+    }
+
+    //time datagram waited since kernel queued it, logged along with every received datagram
+    long long queuedMicroseconds(std::chrono::steady_clock::time_point arrival) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - arrival).count();
+    }
+
+    std::string scopedAddress(const ::sockaddr_in6& sender, unsigned int ifindex) {
+        char addrbuf[INET6_ADDRSTRLEN];
+        ::inet_ntop(AF_INET6, &sender.sin6_addr, addrbuf, sizeof(addrbuf));
+        return std::format("{}%{}", addrbuf, ifindex);
+    }
+
+    std::string scopedAddress(const ::sockaddr_in& sender, unsigned int ifindex) {
+        char addrbuf[INET_ADDRSTRLEN];
+        ::inet_ntop(AF_INET, &sender.sin_addr, addrbuf, sizeof(addrbuf));
+        return std::format("{}%{}", addrbuf, ifindex);
+    }
+}
+
+
+bool NetworkNeighborDiscoverer::ReceivedBatch::empty() const {
+    return this->nifs.empty() && this->unchangedSenders.empty() && this->solicitingMacs.empty() && this->summaries.empty()
+        && this->probes.empty() && this->probeReplies.empty() && this->sequences.empty();
+}
+
+void NetworkNeighborDiscoverer::ReceivedBatch::merge(ReceivedBatch&& other) {
+    //other batch was received later, its entries win
+    for (auto& [mac, nif] : other.nifs) {
+        this->nifs[mac] = std::move(nif);
+    }
+    for (auto& [mac, sender] : other.nifSenders) {
+        this->nifSenders[mac] = std::move(sender);
+    }
+    for (auto& [mac, ifindex] : other.nifIfindexes) {
+        this->nifIfindexes[mac] = ifindex;
+    }
+    for (auto& [mac, arrival] : other.nifArrivals) {
+        this->nifArrivals[mac] = arrival;
+    }
+    for (auto& [sender, fingerprint] : other.fingerprints) {
+        this->fingerprints[sender] = std::move(fingerprint);
+    }
+    for (auto& [sender, arrival] : other.unchangedSenders) {
+        auto [it, inserted] = this->unchangedSenders.try_emplace(sender, arrival);
+        it->second = std::max(it->second, arrival);
+    }
+    std::ranges::move(other.solicitingMacs, std::back_inserter(this->solicitingMacs));
+    std::ranges::move(other.summaries, std::back_inserter(this->summaries));
+    std::ranges::move(other.probes, std::back_inserter(this->probes));
+    std::ranges::move(other.probeReplies, std::back_inserter(this->probeReplies));
+    std::ranges::move(other.sequences, std::back_inserter(this->sequences));
+}
+
+template<typename T>
+void NetworkNeighborDiscoverer::updateMembership(const NetInterface& nif, bool enable, const std::string& baseGroup,
+    IPMulticastReceiver<T>* receiver, IPMulticastSender<T>* sender, IPMulticastSender<T>* summarySender) {
+    constexpr const char* family = std::is_same_v<T, ::sockaddr_in6> ? "IPv6" : "IPv4";
+    const char* action = enable ? "enable" : "disable";
+    unsigned int ifindex = ::if_nametoindex(nif.name.c_str());
+
+    if (receiver != nullptr) {
+        for (unsigned int index : this->receivedGroups) {
+            std::string group = this->shardGroup(baseGroup, index);
+            auto funcReturn = enable ? receiver->enableMulticastGroup(group, ifindex) : receiver->disableMulticastGroup(group, ifindex);
+            if (this->logger != nullptr && !funcReturn.isOk()) {
+                this->logger->error(std::format("Couldn't {} {} multicast receival of {} on {}", action, family, group, nif.name) + ": " + funcReturn.message());
+            }
+        }
+    }
+
+    if (sender != nullptr) {
+        std::string group = this->shardGroup(baseGroup, MulticastShards::shardOf(nif.mac, this->settings.shardCount));
+        auto funcReturn = enable ? sender->addMulticastAddress(group, this->settings.port, ifindex) : sender->removeMulticastAddress(group, this->settings.port, ifindex);
+        if (this->logger != nullptr && !funcReturn.isOk()) {
+            this->logger->error(std::format("Couldn't {} {} multicast sending to {} on {}", action, family, group, nif.name) + ": " + funcReturn.message());
+        }
+    }
+
+    if (summarySender != nullptr) {
+        std::string group = this->shardGroup(baseGroup, this->settings.shardCount);
+        auto funcReturn = enable ? summarySender->addMulticastAddress(group, this->settings.port, ifindex) : summarySender->removeMulticastAddress(group, this->settings.port, ifindex);
+        if (this->logger != nullptr && !funcReturn.isOk()) {
+            this->logger->error(std::format("Couldn't {} {} multicast sending to {} on {}", action, family, group, nif.name) + ": " + funcReturn.message());
+        }
+    }
+}
+
+void NetworkNeighborDiscoverer::updateMemberships(const NetInterface& nif, bool enable) {
+    this->updateMembership(nif, enable, IPAddresses::IPv6CustomMulticast,
+        this->ipv6receiver.get(), this->ipv6sender.get(), this->ipv6summarySender.get());
+    this->updateMembership(nif, enable, IPAddresses::IPv4CustomMulticast,
+        this->ipv4receiver.get(), this->ipv4sender.get(), this->ipv4summarySender.get());
+
+    for (auto& worker : this->receiveWorkers) {
+        this->updateMembership<::sockaddr_in6>(nif, enable, IPAddresses::IPv6CustomMulticast, worker->ipv6receiver.get(), nullptr, nullptr);
+        this->updateMembership<::sockaddr_in>(nif, enable, IPAddresses::IPv4CustomMulticast, worker->ipv4receiver.get(), nullptr, nullptr);
+    }
+}
+
+std::string NetworkNeighborDiscoverer::shardGroup(const std::string& baseGroup, unsigned int index) const {
+    auto funcReturn = MulticastShards::group(baseGroup, index);
+    if (!funcReturn.isOk()) {
+        if (this->logger != nullptr) {
+            this->logger->error(funcReturn.message());
+        }
+        return baseGroup;
+    }
+    return std::move(funcReturn).value();
+}
+
+NetworkNeighborDiscoverer::~NetworkNeighborDiscoverer() {
+    this->stopReceiveWorkers = true;
+    for (auto& worker : this->receiveWorkers) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+    if (this->workerEventFd >= 0) {
+        ::close(this->workerEventFd);
+    }
+    if (this->signalFd >= 0) {
+        ::close(this->signalFd);
+    }
+}
+
+void NetworkNeighborDiscoverer::runIteration() {
+    if (!this->ioStarted) {
+        this->ioStarted = true;
+        //before worker threads start, so they inherit blocked signals
+        this->setupSignals();
+        this->startReceiveWorkers();
+        this->startIoUring();
+        this->startTasks();
+    }
+
+    //get system's network interfaces
+    std::vector<NetInterface> nifs{};
+    auto nifReturn = NetInterfaceManager::getInterfaces();
+    
+    if (nifReturn.isOk()) {
+        nifs = std::move(nifReturn).value();
+    } else {
+        if (this->logger != nullptr) {
+            logger->error("Couldn't retrieve system's network interfaces :" + nifReturn.message());
+        }
+    }
+
+    if (nifs.size() > 0) {
+        //set when interface appears, including the first iteration after start
+        bool solicit = false;
+        bool changed = prevNifs != nifs;
+
+        if (changed) {
+            //cached payloads were filtered against previous local subnets
+            this->senderFingerprints.clear();
+            this->fingerprintsGeneration++;
+
+            if (this->logger != nullptr) {
+                if (this->logger != nullptr) {
+                    auto macsVec = nifs | std::views::transform([](const NetInterface& nif){ return nif.mac; });    
+                    std::ostringstream macs;
+                    for (const auto& mac : macsVec) {
+                        macs << mac << " ";
+                    }
+                    logger->info("Found system's interfaces with MACs: " + macs.str());
+                }
+            }
+
+            //update senders/receivers
+            auto nifsToDisable = this->prevNifs
+                | std::views::filter([&](const NetInterface& nif){
+                    return std::ranges::find(nifs, nif) == nifs.end();
+                });
+            
+            for (const auto& nif : nifsToDisable) {
+                this->updateMemberships(nif, false);
+            }
+
+            auto nifsToEnable = nifs
+                | std::views::filter([&](const NetInterface& nif){
+                    return std::ranges::find(this->prevNifs, nif) == this->prevNifs.end();
+                });
+
+            for (const auto& nif : nifsToEnable) {
+                solicit = true;
+                this->updateMemberships(nif, true);
+            }
+        }
+
+        //changes are sent right away, new interfaces ask peers to answer instead of waiting for their next period
+        //unchanged interfaces are announced by announcementTask
+        if (changed) {
+            this->sendAnnouncement(nifs, solicit ? Frame::MessageType::Solicitation : Frame::MessageType::Announcement);
+        }
+        this->sendShardSummary();
+    }
+    this->prevNifs = std::move(nifs);
+}
+
+void NetworkNeighborDiscoverer::waitForEvents(unsigned int seconds) {
+    this->reactor.runUntil(std::chrono::steady_clock::now() + std::chrono::seconds(seconds));
+}
+
+void NetworkNeighborDiscoverer::sendAnnouncement(const std::vector<NetInterface>& nifs, Frame::MessageType type) {
+    bool canUseIPv6 = std::ranges::any_of(nifs, [](const NetInterface& nif) { return nif.ipv6s.size() > 0; });
+    bool canUseIPv4 = std::ranges::any_of(nifs, [](const NetInterface& nif) { return nif.ipv4s.size() > 0; });
+
+    auto sbuff = std::make_shared<std::vector<std::uint8_t>>();
+    sbuff->reserve(Frame::HEADER_SIZE + Codec::encodedSize(nifs) + Frame::TRAILER_SIZE);
+    Frame::reserveHeader(*sbuff);
+    Serializer::serialize<NetInterface>(*sbuff, nifs);
+    std::size_t compressionThreshold = this->peersSupport(Frame::Capabilities::Lz) ? this->settings.compressionThreshold : 0;
+    Frame::seal(*sbuff, this->settings.useChecksum, compressionThreshold, type, this->nextAnnouncementSequence++);
+    if (this->nextAnnouncementSequence == 0) {
+        this->nextAnnouncementSequence = 1;
+    }
+    std::shared_ptr<const std::vector<std::uint8_t>> frame = std::move(sbuff);
+
+    if (canUseIPv6) {
+        this->sendFrame(this->ipv6sender.get(), frame);
+    }
+
+    if (canUseIPv4) {
+        this->sendFrame(this->ipv4sender.get(), frame);
+    }
+
+    //with sharding only summary group reaches members of all shards
+    if (type == Frame::MessageType::Solicitation) {
+        if (canUseIPv6) {
+            this->sendFrame(this->ipv6summarySender.get(), frame);
+        }
+
+        if (canUseIPv4) {
+            this->sendFrame(this->ipv4summarySender.get(), frame);
+        }
+    }
+
+    //peers that solicited before got their answer
+    this->scheduledResponseTime.reset();
+    this->prevSendTime = std::chrono::steady_clock::now();
+
+    this->submitIoUring();
+}
+
+void NetworkNeighborDiscoverer::sendShardSummary() {
+    if (this->ipv6summarySender == nullptr && this->ipv4summarySender == nullptr) {
+        return;
+    }
+
+    auto sbuff = std::make_shared<std::vector<std::uint8_t>>();
+    Frame::reserveHeader(*sbuff);
+    Serializer::serialize<ShardDigest>(*sbuff, this->localShardDigests());
+    Frame::seal(*sbuff, this->settings.useChecksum, 0, Frame::MessageType::Summary);
+    std::shared_ptr<const std::vector<std::uint8_t>> frame = std::move(sbuff);
+
+    this->sendFrame(this->ipv6summarySender.get(), frame);
+    this->sendFrame(this->ipv4summarySender.get(), frame);
+
+    this->submitIoUring();
+}
+
+template<typename T>
+void NetworkNeighborDiscoverer::sendFrame(IPMulticastSender<T>* sender, const std::shared_ptr<const std::vector<std::uint8_t>>& frame) {
+    if (sender == nullptr) {
+        return;
+    }
+
+    auto funcReturn = this->ioUring == nullptr ? sender->send(*frame) : sender->send(frame, *this->ioUring);
+    if (!funcReturn.isOk() && this->logger != nullptr) {
+        this->logger->error(funcReturn.message());
+    }
+}
+
+std::vector<ShardDigest> NetworkNeighborDiscoverer::localShardDigests() const {
+    //subscribed shards are sorted, so digests are too
+    std::vector<ShardDigest> digests{};
+    for (unsigned int shard : this->subscribedShards) {
+        ShardDigest digest;
+        digest.shard = shard;
+        digests.push_back(digest);
+    }
+
+    auto addMember = [&](const std::string& mac, std::uint64_t fingerprint) {
+        unsigned int shard = MulticastShards::shardOf(mac, this->settings.shardCount);
+        auto it = std::ranges::lower_bound(digests, shard, {}, &ShardDigest::shard);
+        if (it == digests.end() || it->shard != shard) {
+            return;
+        }
+        it->members++;
+        it->digest += fingerprint;
+    };
+
+    //own interfaces are members too, every daemon of a shard then sums up the same set
+    std::vector<std::uint8_t> buff{};
+    for (const auto& nif : this->prevNifs) {
+        buff.clear();
+        nif.serialize(buff);
+        addMember(nif.mac, PayloadFingerprint::compute(buff.data(), buff.size()));
+    }
+    for (const auto& [mac, member] : this->shardMembers) {
+        bool own = std::ranges::any_of(this->prevNifs, [&](const NetInterface& nif) { return nif.mac == mac; });
+        if (!own) {
+            addMember(mac, member.fingerprint);
+        }
+    }
+
+    return digests;
+}
+
+void NetworkNeighborDiscoverer::handleSummary(const std::string& sender, std::vector<std::uint8_t>& rbuff, ReceivedBatch& batch) {
+    auto frameReturn = Frame::open(rbuff, false, this->settings.maxBufferSize);
+    if (!frameReturn.isOk()) {
+        if (this->logger != nullptr) {
+            this->logger->error(std::format("Dropped summary from {}: ", sender) + frameReturn.message());
+        }
+        return;
+    }
+
+    std::size_t offset = frameReturn.value().offset;
+    auto desReturn = Deserializer::deserialize<ShardDigest>(rbuff, offset);
+    if (!desReturn.isOk()) {
+        if (this->logger != nullptr) {
+            this->logger->error("Couldn't deserialize shard summary: " + desReturn.message());
+        }
+        return;
+    }
+
+    for (ShardDigest& digest : desReturn.value()) {
+        batch.summaries.push_back(std::move(digest));
+    }
+}
+
+void NetworkNeighborDiscoverer::handleProbe(const std::string& sender, std::chrono::steady_clock::time_point arrival, std::vector<std::uint8_t>& rbuff, ReceivedBatch& batch) {
+    Frame::MessageType type = Frame::messageType(rbuff);
+    auto frameReturn = Frame::open(rbuff, false, this->settings.maxBufferSize);
+    if (!frameReturn.isOk()) {
+        if (this->logger != nullptr) {
+            this->logger->error(std::format("Dropped probe from {}: ", sender) + frameReturn.message());
+        }
+        return;
+    }
+
+    std::size_t offset = frameReturn.value().offset;
+    auto desReturn = ProbeMessage::deserialize(rbuff, offset);
+    if (!desReturn.isOk()) {
+        if (this->logger != nullptr) {
+            this->logger->error("Couldn't deserialize probe: " + desReturn.message());
+        }
+        return;
+    }
+
+    if (type == Frame::MessageType::Probe) {
+        batch.probes.emplace_back(sender, desReturn.value());
+    } else {
+        batch.probeReplies.push_back(ReceivedBatch::ProbeReply{sender, desReturn.value(), arrival});
+    }
+}
+
+void NetworkNeighborDiscoverer::applyProbes(ReceivedBatch& batch) {
+    auto now = std::chrono::steady_clock::now();
+
+    if (!batch.probes.empty()) {
+        double rate = this->settings.probeReplyMaxPerSecond;
+        std::chrono::duration<double> refill = now - this->prevProbeReplyRefill;
+        this->probeReplyTokens = std::min(rate, this->probeReplyTokens + refill.count() * rate);
+        this->prevProbeReplyRefill = now;
+
+        unsigned int dropped = 0;
+        for (const auto& [sender, probe] : batch.probes) {
+            if (this->probeReplyTokens < 1.0) {
+                dropped++;
+                continue;
+            }
+            this->probeReplyTokens -= 1.0;
+
+            std::vector<std::uint8_t> frame{};
+            Frame::reserveHeader(frame);
+            probe.serialize(frame);
+            Frame::seal(frame, this->settings.useChecksum, 0, Frame::MessageType::ProbeReply);
+            auto sendReturn = this->sendUnicast(sender, frame);
+            if (!sendReturn.isOk() && this->logger != nullptr) {
+                this->logger->error(std::format("Couldn't answer probe of {}: ", sender) + sendReturn.message());
+            }
+        }
+        if (dropped > 0 && this->logger != nullptr) {
+            this->logger->error(std::format("Dropped {} probes above reply budget", dropped));
+        }
+    }
+
+    //late replies of probes already counted as lost are ignored
+    //echoed send time is only sender's word, any host could answer with sequence and time of its choosing
+    for (const auto& reply : batch.probeReplies) {
+        auto it = this->outstandingProbes.find(reply.probe.sequence);
+        if (it == this->outstandingProbes.end() || it->second.address != reply.sender) {
+            continue;
+        }
+        auto neighborIt = this->probedNeighbors.find(it->second.mac);
+        if (neighborIt != this->probedNeighbors.end()) {
+            neighborIt->second.estimator.addSample(std::chrono::duration_cast<std::chrono::microseconds>(reply.arrival - it->second.sent));
+        }
+        this->outstandingProbes.erase(it);
+    }
+}
+
+void NetworkNeighborDiscoverer::sendProbe() {
+    auto now = std::chrono::steady_clock::now();
+    auto due = std::ranges::min_element(this->probedNeighbors, {}, [](const auto& entry) { return entry.second.nextProbe; });
+    if (due == this->probedNeighbors.end() || due->second.nextProbe > now) {
+        return;
+    }
+    due->second.nextProbe = now + std::chrono::milliseconds(this->settings.probePeriodMs);
+
+    ProbeMessage probe{};
+    probe.sequence = this->nextProbeSequence++;
+    probe.sentNs = std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count();
+
+    std::vector<std::uint8_t> frame{};
+    Frame::reserveHeader(frame);
+    probe.serialize(frame);
+    Frame::seal(frame, this->settings.useChecksum, 0, Frame::MessageType::Probe);
+
+    auto sendReturn = this->sendUnicast(due->second.address, frame);
+    if (!sendReturn.isOk()) {
+        if (this->logger != nullptr) {
+            this->logger->error(std::format("Couldn't probe {}: ", due->first) + sendReturn.message());
+        }
+        return;
+    }
+    this->outstandingProbes[probe.sequence] = OutstandingProbe{due->first, due->second.address, now, now + std::chrono::milliseconds(this->settings.probeTimeoutMs)};
+}
+
+void NetworkNeighborDiscoverer::expireProbes() {
+    auto now = std::chrono::steady_clock::now();
+    std::erase_if(this->outstandingProbes, [&](const auto& entry) {
+        if (now < entry.second.deadline) {
+            return false;
+        }
+        auto neighborIt = this->probedNeighbors.find(entry.second.mac);
+        if (neighborIt != this->probedNeighbors.end()) {
+            neighborIt->second.estimator.addLoss();
+        }
+        return true;
+    });
+}
+
+Result<> NetworkNeighborDiscoverer::sendUnicast(const std::string& scopedAddress, const std::vector<std::uint8_t>& frame) {
+    auto separator = scopedAddress.rfind('%');
+    std::string address = scopedAddress.substr(0, separator);
+    unsigned int ifindex = 0;
+    if (separator != std::string::npos) {
+        ifindex = static_cast<unsigned int>(std::strtoul(scopedAddress.c_str() + separator + 1, nullptr, 10));
+    }
+
+    ::sockaddr_in6 ipv6address{};
+    if (::inet_pton(AF_INET6, address.c_str(), &ipv6address.sin6_addr) == 1) {
+        if (this->ipv6sender == nullptr) {
+            return Error{ErrorCode::NotFound, "No IPv6 sender socket"};
+        }
+        ipv6address.sin6_family = AF_INET6;
+        ipv6address.sin6_port = ::htons(this->settings.port);
+        ipv6address.sin6_scope_id = ifindex;
+        return this->ipv6sender->sendTo(frame, ipv6address);
+    }
+
+    ::sockaddr_in ipv4address{};
+    if (::inet_pton(AF_INET, address.c_str(), &ipv4address.sin_addr) == 1) {
+        if (this->ipv4sender == nullptr) {
+            return Error{ErrorCode::NotFound, "No IPv4 sender socket"};
+        }
+        ipv4address.sin_family = AF_INET;
+        ipv4address.sin_port = ::htons(this->settings.port);
+        return this->ipv4sender->sendTo(frame, ipv4address);
+    }
+    return Error{ErrorCode::Failed, "Invalid unicast address"};
+}
+
+std::optional<std::unordered_set<std::string>> NetworkNeighborDiscoverer::subnetCandidates(const NeighborQuery& query) {
+    if (this->neighborAddressesGeneration != this->neighbors.getGeneration()) {
+        this->neighborAddresses.clear();
+        this->neighborAddressMacs.clear();
+        for (const auto& [mac, entry] : this->neighbors) {
+            std::uint32_t tag = static_cast<std::uint32_t>(this->neighborAddressMacs.size());
+            for (const auto& ipv4 : entry.first.ipv4s) {
+                this->neighborAddresses.addIPv4(ipv4, tag);
+            }
+            for (const auto& ipv6 : entry.first.ipv6s) {
+                this->neighborAddresses.addIPv6(ipv6, tag);
+            }
+            this->neighborAddressMacs.push_back(mac);
+        }
+        this->neighborAddressesGeneration = this->neighbors.getGeneration();
+    }
+
+    std::vector<std::uint8_t> ipv4Matches{}, ipv6Matches{};
+    if (!query.matchSubnet(this->neighborAddresses, ipv4Matches, ipv6Matches)) {
+        return std::nullopt;
+    }
+
+    std::unordered_set<std::string> candidates{};
+    for (std::size_t i = 0; i < ipv4Matches.size(); i++) {
+        if (ipv4Matches[i]) {
+            candidates.insert(this->neighborAddressMacs[this->neighborAddresses.ipv4Tags[i]]);
+        }
+    }
+    for (std::size_t i = 0; i < ipv6Matches.size(); i++) {
+        if (ipv6Matches[i]) {
+            candidates.insert(this->neighborAddressMacs[this->neighborAddresses.ipv6Tags[i]]);
+        }
+    }
+    return candidates;
+}
+
+LossReport NetworkNeighborDiscoverer::lossReport() {
+    LossReport report{};
+    this->forEachReceiver([&](const auto& receiver) {
+        report.kernelDrops += receiver.droppedDatagrams();
+    });
+
+    report.total.sender = "total";
+    for (const auto& [sender, tracker] : this->senderSequences) {
+        std::string macs{};
+        if (auto it = this->senderFingerprints.find(sender); it != this->senderFingerprints.end()) {
+            for (const auto& mac : it->second.macs) {
+                macs += (macs.empty() ? "" : ",") + mac;
+            }
+        }
+
+        NeighborLoss loss = tracker.report(sender, macs);
+        report.total.restarts += loss.restarts;
+        report.total.received += loss.received;
+        report.total.lost += loss.lost;
+        report.total.reordered += loss.reordered;
+        report.total.duplicates += loss.duplicates;
+        report.senders.push_back(std::move(loss));
+    }
+    std::ranges::sort(report.senders, {}, &NeighborLoss::sender);
+    return report;
+}
+
+std::optional<std::chrono::microseconds> NetworkNeighborDiscoverer::smoothedRtt(const std::string& mac) const {
+    auto it = this->probedNeighbors.find(mac);
+    if (it == this->probedNeighbors.end()) {
+        return std::nullopt;
+    }
+    return it->second.estimator.smoothedRtt();
+}
+
+void NetworkNeighborDiscoverer::mergeWorkerBatches(ReceivedBatch& batch) {
+    std::vector<ReceivedBatch> decoded{};
+    {
+        std::lock_guard<std::mutex> lock(this->workerBatchesMutex);
+        decoded.swap(this->workerBatches);
+    }
+    for (auto& workerBatch : decoded) {
+        batch.merge(std::move(workerBatch));
+    }
+}
+
+int NetworkNeighborDiscoverer::receiveDatagrams(IPMulticastReceiver<::sockaddr_in6>* ipv6receiver, IPMulticastReceiver<::sockaddr_in>* ipv4receiver,
+    std::unordered_map<std::string, SenderFingerprint>& fingerprints, ReceivedBatch& batch) {
+    int receivedBytes = 0;
+
+    if (ipv6receiver != nullptr) {
+        std::vector<std::uint8_t> rbuff(this->settings.maxBufferSize);
+        ::sockaddr_in6 sender{};
+        unsigned int ifindex = 0;
+        std::chrono::system_clock::time_point stamp{};
+        int n = ipv6receiver->receive(rbuff, &sender, &ifindex, &stamp);
+
+        if (n > 0) {
+            std::string scopedSender = scopedAddress(sender, ifindex);
+            auto arrival = steadyArrival(stamp);
+            if (this->logger != nullptr) {
+                this->logger->info(std::format("Received {}B from {}, queued {}us", n, scopedSender, queuedMicroseconds(arrival)));
+            }
+            this->handleDatagram(scopedSender, ifindex, arrival, rbuff, n, fingerprints, batch);
+
+            receivedBytes += n;
+        }
+    }
+
+    if (ipv4receiver != nullptr) {
+        std::vector<std::uint8_t> rbuff(this->settings.maxBufferSize);
+        ::sockaddr_in sender{};
+        unsigned int ifindex = 0;
+        std::chrono::system_clock::time_point stamp{};
+        int n = ipv4receiver->receive(rbuff, &sender, &ifindex, &stamp);
+
+        if (n > 0) {
+            std::string scopedSender = scopedAddress(sender, ifindex);
+            auto arrival = steadyArrival(stamp);
+            if (this->logger != nullptr) {
+                this->logger->info(std::format("Received {}B from {}, queued {}us", n, scopedSender, queuedMicroseconds(arrival)));
+            }
+            receivedBytes += n;
+            this->handleDatagram(scopedSender, ifindex, arrival, rbuff, n, fingerprints, batch);
+        }
+    }
+
+    return receivedBytes;
+}
+
+void NetworkNeighborDiscoverer::applyBatch(ReceivedBatch& batch, const std::vector<NetInterface>& nifs) {
+    std::unordered_map<std::string, std::vector<std::string>> acceptedMacs{};
+    std::unordered_map<std::string, std::vector<std::string>> announcedMacs{};
+
+    for (const auto& frame : batch.sequences) {
+        this->senderSequences[frame.sender].add(frame.origin, frame.sequence, frame.arrival);
+    }
+
+    std::unordered_map<unsigned int, const NetInterface*> localByIfindex{};
+    for (const auto& local : nifs) {
+        localByIfindex[::if_nametoindex(local.name.c_str())] = &local;
+    }
+
+    //addresses of whole batch are laid out as columns and matched against all local subnets at once
+    //each address is tagged with interface announcement arrived on, so it's matched only against subnets of that interface, all if it's unknown
+    SubnetTable localSubnets = SubnetTable::fromInterfaces(nifs);
+    AddressColumns receivedAddresses{};
+    std::vector<bool> ipv4Parsed{}, ipv6Parsed{};
+    for (const auto& received : (batch.nifs | std::views::values)) {
+        unsigned int ifindex = batch.nifIfindexes[received.mac];
+        std::uint32_t tag = localByIfindex.contains(ifindex) ? ifindex : 0;
+        for (const auto& rIPv4 : received.ipv4s) {
+            ipv4Parsed.push_back(receivedAddresses.addIPv4(rIPv4, tag));
+        }
+        for (const auto& rIPv6 : received.ipv6s) {
+            ipv6Parsed.push_back(receivedAddresses.addIPv6(rIPv6, tag));
+        }
+    }
+    std::vector<std::uint8_t> ipv4Matches{}, ipv6Matches{};
+    localSubnets.matchIPv4(receivedAddresses, ipv4Matches);
+    localSubnets.matchIPv6(receivedAddresses, ipv6Matches);
+
+    std::size_t ipv4Entry = 0, ipv4Row = 0, ipv6Entry = 0, ipv6Row = 0;
+    std::vector<std::uint8_t> memberBuff{};
+    for (const auto& received : (batch.nifs | std::views::values)) {
+        auto arrivalTimeIt = batch.nifArrivals.find(received.mac);
+        auto lastSeen = arrivalTimeIt != batch.nifArrivals.end() ? arrivalTimeIt->second : std::chrono::steady_clock::now();
+
+        memberBuff.clear();
+        received.serialize(memberBuff);
+        this->shardMembers[received.mac] = ShardMember{PayloadFingerprint::compute(memberBuff.data(), memberBuff.size()), lastSeen};
+        announcedMacs[batch.nifSenders[received.mac]].push_back(received.mac);
+
+        std::vector<IPv4Info> matchedIPv4;
+        for (const auto& rIPv4 : received.ipv4s) {
+            if (ipv4Parsed[ipv4Entry++] && ipv4Matches[ipv4Row++]) {
+                matchedIPv4.push_back(rIPv4);
+            }
+        }
+
+        std::vector<IPv6Info> matchedIPv6;
+        for (const auto& rIPv6 : received.ipv6s) {
+            if (ipv6Parsed[ipv6Entry++] && ipv6Matches[ipv6Row++]) {
+                matchedIPv6.push_back(rIPv6);
+            }
+        }
+
+        if (!matchedIPv4.empty() || !matchedIPv6.empty()) {
+            NetInterface filteredNif = received;
+            filteredNif.ipv4s = std::move(matchedIPv4);
+            filteredNif.ipv6s = std::move(matchedIPv6);
+            acceptedMacs[batch.nifSenders[filteredNif.mac]].push_back(filteredNif.mac);
+            this->probedNeighbors[filteredNif.mac].address = batch.nifSenders[filteredNif.mac];
+            //add/update to timedindexedset
+            UpdateResult result = this->neighbors.update(filteredNif.mac, filteredNif, lastSeen);
+            if (result != UpdateResult::Unchanged) {
+                this->neighborsChanged = true;
+                if (this->journal != nullptr) {
+                    JournalEvent event;
+                    event.timeMs = wallClockMs();
+                    event.type = result == UpdateResult::Added ? JournalEventType::Added : JournalEventType::Updated;
+                    event.nif = std::move(filteredNif);
+                    this->journal->record(std::move(event));
+                }
+            }
+        }
+    }
+
+    //cache fingerprints of freshly decoded payloads together with what they contributed
+    for (auto& [sender, fingerprint] : batch.fingerprints) {
+        fingerprint.macs = std::move(acceptedMacs[sender]);
+        fingerprint.announcedMacs = std::move(announcedMacs[sender]);
+        this->senderFingerprints[sender] = std::move(fingerprint);
+    }
+
+    auto now = std::chrono::steady_clock::now();
+
+    //unchanged payloads would produce the same filtered result, only last seen time has to be updated
+    for (const auto& [sender, arrival] : batch.unchangedSenders) {
+        auto it = this->senderFingerprints.find(sender);
+        if (it != this->senderFingerprints.end()) {
+            it->second.lastSeen = std::max(it->second.lastSeen, arrival);
+            for (const auto& mac : it->second.macs) {
+                this->neighbors.refresh(mac, arrival);
+            }
+            for (const auto& mac : it->second.announcedMacs) {
+                auto member = this->shardMembers.find(mac);
+                if (member != this->shardMembers.end()) {
+                    member->second.lastSeen = std::max(member->second.lastSeen, arrival);
+                }
+            }
+        }
+    }
+
+    this->applyProbes(batch);
+
+    //digests of subscribed shards are computed locally
+    for (const ShardDigest& digest : batch.summaries) {
+        if (!std::ranges::binary_search(this->subscribedShards, digest.shard)) {
+            this->remoteShardDigests[digest.shard] = RemoteShardDigest{digest, now};
+        }
+    }
+
+    //answer solicitations of other daemons, own solicitation comes back over multicast loopback
+    bool solicitedByPeer = std::ranges::any_of(batch.solicitingMacs, [&](const std::string& mac) {
+        return std::ranges::none_of(nifs, [&](const NetInterface& nif) { return nif.mac == mac; });
+    });
+    if (solicitedByPeer) {
+        this->scheduleResponse();
+    }
+}
+
+void NetworkNeighborDiscoverer::scheduleResponse() {
+    if (this->scheduledResponseTime.has_value()) {
+        return;
+    }
+
+    //random delay spreads answers of many peers, minimal interval limits answer rate
+    std::uniform_int_distribution<unsigned int> delayMs(0, this->settings.solicitResponseMaxDelayMs);
+    auto responseTime = std::chrono::steady_clock::now() + std::chrono::milliseconds(delayMs(this->random));
+    this->scheduledResponseTime = std::max(responseTime, this->prevResponseTime + std::chrono::milliseconds(this->settings.solicitResponseMinIntervalMs));
+
+    if (!this->responseTaskRunning) {
+        this->responseTaskRunning = true;
+        this->reactor.spawn(this->responseTask());
+    }
+}
+
+void NetworkNeighborDiscoverer::expireNeighbors() {
+    auto expiredMacs = this->neighbors.remove(std::chrono::seconds(this->settings.neighborActivityPeriodS));
+    if (!expiredMacs.empty()) {
+        this->neighborsChanged = true;
+    }
+    for (const auto& mac : expiredMacs) {
+        this->probedNeighbors.erase(mac);
+    }
+    if (this->journal != nullptr) {
+        for (auto& mac : expiredMacs) {
+            JournalEvent event;
+            event.timeMs = wallClockMs();
+            event.type = JournalEventType::Expired;
+            event.nif.mac = std::move(mac);
+            this->journal->record(std::move(event));
+        }
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    std::erase_if(this->senderFingerprints, [&](const auto& entry) {
+        return now - entry.second.lastSeen > std::chrono::seconds(this->settings.neighborActivityPeriodS);
+    });
+    std::erase_if(this->shardMembers, [&](const auto& entry) {
+        return now - entry.second.lastSeen > std::chrono::seconds(this->settings.neighborActivityPeriodS);
+    });
+    std::erase_if(this->remoteShardDigests, [&](const auto& entry) {
+        return now - entry.second.lastSeen > std::chrono::seconds(this->settings.neighborActivityPeriodS);
+    });
+    std::erase_if(this->senderSequences, [&](const auto& entry) {
+        return now - entry.second.lastArrival() > std::chrono::seconds(this->settings.neighborActivityPeriodS);
+    });
+}
+
+void NetworkNeighborDiscoverer::startTasks() {
+    if (this->ioUring != nullptr) {
+        this->reactor.spawn(this->completionsTask());
+    } else {
+        this->startReadinessTasks();
+    }
+    if (this->workerEventFd >= 0) {
+        this->reactor.spawn(this->workerBatchesTask());
+    }
+    this->reactor.spawn(this->maintenanceTask());
+    this->reactor.spawn(this->announcementTask());
+    if (this->signalFd >= 0) {
+        this->reactor.spawn(this->signalTask());
+    }
+    this->reactor.spawn(this->probeTask());
+    if (this->handoffServer != nullptr) {
+        this->reactor.spawn(this->handoffTask());
+    }
+}
+
+void NetworkNeighborDiscoverer::startReadinessTasks() {
+    if (this->ipv6receiver != nullptr) {
+        this->reactor.spawn(this->receiveTask(this->ipv6receiver.get(), nullptr, this->ipv6receiver->fd()));
+    }
+    if (this->ipv4receiver != nullptr) {
+        this->reactor.spawn(this->receiveTask(nullptr, this->ipv4receiver.get(), this->ipv4receiver->fd()));
+    }
+    if (this->unixDomainServer != nullptr) {
+        this->reactor.spawn(this->acceptTask());
+    }
+}
+
+Task NetworkNeighborDiscoverer::receiveTask(IPMulticastReceiver<::sockaddr_in6>* ipv6receiver, IPMulticastReceiver<::sockaddr_in>* ipv4receiver, int fd) {
+    while (true) {
+        co_await this->reactor.readable(fd);
+
+        ReceivedBatch batch{};
+        for (int i = 0; i < MAX_DATAGRAMS_PER_BATCH; i++) {
+            if (this->receiveDatagrams(ipv6receiver, ipv4receiver, this->senderFingerprints, batch) <= 0) {
+                break;
+            }
+        }
+        this->applyBatch(batch, this->prevNifs);
+
+        //rest of burst waits until other tasks had their turn
+        co_await this->reactor.yield();
+    }
+}
+
+Task NetworkNeighborDiscoverer::workerBatchesTask() {
+    while (true) {
+        co_await this->reactor.readable(this->workerEventFd);
+
+        //counter is only a wake up signal, workers push batches before signalling
+        std::uint64_t signals = 0;
+        ::read(this->workerEventFd, &signals, sizeof(signals));
+
+        ReceivedBatch batch{};
+        this->mergeWorkerBatches(batch);
+        this->applyBatch(batch, this->prevNifs);
+    }
+}
+
+Task NetworkNeighborDiscoverer::completionsTask() {
+    while (this->ioUring != nullptr) {
+        co_await this->reactor.readable(this->ioUring->fd());
+        //ring got closed meanwhile, handoff that failed couldn't restart it
+        if (this->ioUring == nullptr) {
+            break;
+        }
+
+        auto waitReturn = this->ioUring->wait(0);
+        if (!waitReturn.isOk()) {
+            this->disableIoUring(waitReturn.message());
+            break;
+        }
+
+        ReceivedBatch batch{};
+        this->handleCompletions(waitReturn.value(), batch);
+        this->submitIoUring();
+        this->applyBatch(batch, this->prevNifs);
+
+        co_await this->reactor.yield();
+    }
+
+    //io_uring got disabled, sockets are awaited directly from now on
+    this->startReadinessTasks();
+}
+
+Task NetworkNeighborDiscoverer::acceptTask() {
+    while (true) {
+        co_await this->reactor.readable(this->unixDomainServer->fd());
+
+        while (true) {
+            //isOk returns true if client connected
+            auto clientSocketReturn = this->unixDomainServer->acceptClient();
+            if (!clientSocketReturn.isOk()) {
+                break;
+            }
+            this->reactor.spawn(this->cliSession(std::move(clientSocketReturn).value()));
+        }
+    }
+}
+
+Task NetworkNeighborDiscoverer::cliSession(UnixSocket clientSocket) {
+    if (this->logger != nullptr) {
+        this->logger->info("Established client connection on UNIX domain socket");
+    }
+
+    //connection stays open for further requests, each is terminated by newline and answered in order
+    std::string pending{};
+    std::vector<std::uint8_t> rbuff(this->localSettings.maxRequestSize);
+    auto waitTime = std::chrono::milliseconds(this->localSettings.requestTimeoutMs);
+    while (true) {
+        //client that connects without sending request or stays idle holds up only its own session
+        bool requested = co_await this->reactor.readable(clientSocket.fd(), waitTime);
+        if (!requested) {
+            if (this->logger != nullptr) {
+                this->logger->info(pending.empty() ? "Closing idle CLI client connection" : "CLI client didn't finish request in time");
+            }
+            co_return;
+        }
+
+        auto recReturn = clientSocket.receiveSome(rbuff);
+        if (!recReturn.isOk()) {
+            if (this->logger != nullptr) {
+                this->logger->info("CLI client connection ended: " + recReturn.message());
+            }
+            co_return;
+        }
+        pending.append(rbuff.begin(), rbuff.begin() + recReturn.value());
+
+        for (auto newline = pending.find('\n'); newline != std::string::npos; newline = pending.find('\n')) {
+            std::vector<std::uint8_t> response = this->answerCliRequest(pending.substr(0, newline));
+            pending.erase(0, newline + 1);
+
+            //written as client reads it, daemon keeps running meanwhile
+            std::span<const std::uint8_t> unsent = response;
+            while (!unsent.empty()) {
+                auto sendReturn = clientSocket.sendSome(unsent);
+                if (!sendReturn.isOk()) {
+                    if (this->logger != nullptr) {
+                        this->logger->error("Failed to send response to CLI client: " + sendReturn.message());
+                    }
+                    co_return;
+                }
+                unsent = unsent.subspan(sendReturn.value());
+                if (!unsent.empty() && !co_await this->reactor.writable(clientSocket.fd(), std::chrono::milliseconds(this->localSettings.requestTimeoutMs))) {
+                    if (this->logger != nullptr) {
+                        this->logger->error("CLI client stopped reading response");
+                    }
+                    co_return;
+                }
+            }
+            if (this->logger != nullptr) {
+                this->logger->info(std::format("Sent {}B response to CLI client", response.size()));
+            }
+
+            //pipelined requests don't hold up other tasks
+            co_await this->reactor.yield();
+        }
+
+        if (pending.size() > this->localSettings.maxRequestSize) {
+            if (this->logger != nullptr) {
+                this->logger->error("CLI request exceeds maximum size, closing connection");
+            }
+            co_return;
+        }
+        waitTime = std::chrono::seconds(this->localSettings.idleTimeoutS);
+    }
+}
+
+Task NetworkNeighborDiscoverer::maintenanceTask() {
+    while (true) {
+        co_await this->reactor.sleepFor(MAINTENANCE_PERIOD);
+
+        this->expireNeighbors();
+        this->checkReceiveDrops();
+
+        //batched journal writes happen off the receive path
+        if (this->journal != nullptr) {
+            auto flushReturn = this->journal->flush();
+            if (!flushReturn.isOk() && this->logger != nullptr) {
+                this->logger->error("Couldn't write neighbor journal: " + flushReturn.message());
+            }
+        }
+
+        this->saveSnapshot();
+    }
+}
+
+Task NetworkNeighborDiscoverer::announcementTask() {
+    while (true) {
+        //announcements sent on interface changes or as answers move next one
+        auto nextSendTime = this->prevSendTime + std::chrono::seconds(std::max(this->settings.sendingPeriodS, 1u));
+        if (std::chrono::steady_clock::now() < nextSendTime) {
+            co_await this->reactor.sleepUntil(nextSendTime);
+            continue;
+        }
+
+        if (this->prevNifs.empty()) {
+            this->prevSendTime = std::chrono::steady_clock::now();
+        } else {
+            this->sendAnnouncement(this->prevNifs, Frame::MessageType::Announcement);
+        }
+    }
+}
+
+Task NetworkNeighborDiscoverer::responseTask() {
+    //periodic announcement sent in the meantime answers solicitation as well and resets scheduled time
+    while (this->scheduledResponseTime.has_value()) {
+        auto now = std::chrono::steady_clock::now();
+        if (now < this->scheduledResponseTime.value()) {
+            co_await this->reactor.sleepUntil(this->scheduledResponseTime.value());
+            continue;
+        }
+
+        if (!this->prevNifs.empty()) {
+            if (this->logger != nullptr) {
+                this->logger->info("Answering neighbor solicitation");
+            }
+            this->sendAnnouncement(this->prevNifs, Frame::MessageType::Announcement);
+        }
+        this->scheduledResponseTime.reset();
+        this->prevResponseTime = now;
+    }
+    this->responseTaskRunning = false;
+}
+
+Task NetworkNeighborDiscoverer::probeTask() {
+    while (true) {
+        if (this->settings.probePeriodMs == 0 || this->settings.probeMaxPerSecond == 0) {
+            this->outstandingProbes.clear();
+            co_await this->reactor.sleepFor(MAINTENANCE_PERIOD);
+            continue;
+        }
+
+        //one probe per tick keeps cost within budget however large neighbor table gets
+        co_await this->reactor.sleepFor(std::chrono::microseconds(1000000 / this->settings.probeMaxPerSecond));
+        this->expireProbes();
+        this->sendProbe();
+    }
+}
+
+Task NetworkNeighborDiscoverer::signalTask() {
+    while (true) {
+        co_await this->reactor.readable(this->signalFd);
+
+        ::signalfd_siginfo info{};
+        if (::read(this->signalFd, &info, sizeof(info)) != sizeof(info)) {
+            continue;
+        }
+
+        if (info.ssi_signo == SIGTERM || info.ssi_signo == SIGINT) {
+            if (this->logger != nullptr) {
+                this->logger->info(std::format("Received {}, stopping", info.ssi_signo == SIGTERM ? "SIGTERM" : "SIGINT"));
+            }
+            if (this->journal != nullptr) {
+                auto flushReturn = this->journal->flush();
+                if (!flushReturn.isOk() && this->logger != nullptr) {
+                    this->logger->error("Couldn't write neighbor journal: " + flushReturn.message());
+                }
+            }
+            //restarted daemon continues from current table instead of one up to snapshot period old
+            this->neighborsChanged = true;
+            this->saveSnapshot();
+
+            this->reactor.stop();
+            if (this->stopHandler) {
+                this->stopHandler();
+            }
+            continue;
+        }
+
+        if (this->logger != nullptr) {
+            this->logger->info("Received SIGHUP, reloading settings");
+        }
+        auto reloadReturn = this->reloadSettings();
+        if (!reloadReturn.isOk() && this->logger != nullptr) {
+            this->logger->error(reloadReturn.message());
+        }
+    }
+}
+
+Task NetworkNeighborDiscoverer::handoffTask() {
+    while (true) {
+        co_await this->reactor.readable(this->handoffServer->fd());
+
+        auto clientReturn = this->handoffServer->acceptClient();
+        if (!clientReturn.isOk()) {
+            continue;
+        }
+        UnixSocket client = std::move(clientReturn).value();
+
+        //replacing daemon sends request line right after connecting, nothing follows it
+        std::string request{};
+        std::vector<std::uint8_t> rbuff(DaemonHandoff::MAX_REQUEST_SIZE);
+        while (request.find('\n') == std::string::npos && request.size() < DaemonHandoff::MAX_REQUEST_SIZE) {
+            if (!co_await this->reactor.readable(client.fd(), std::chrono::milliseconds(this->localSettings.requestTimeoutMs))) {
+                break;
+            }
+            auto recReturn = client.receiveSome(std::span<std::uint8_t>(rbuff.data(), DaemonHandoff::MAX_REQUEST_SIZE - request.size()));
+            if (!recReturn.isOk()) {
+                break;
+            }
+            request.append(rbuff.begin(), rbuff.begin() + recReturn.value());
+        }
+        auto newline = request.find('\n');
+        if (newline == std::string::npos) {
+            if (this->logger != nullptr) {
+                this->logger->error("Ignoring incomplete handoff request");
+            }
+            continue;
+        }
+        request.resize(newline);
+
+        if (this->handOver(client, request)) {
+            co_return;
+        }
+    }
+}
+
+bool NetworkNeighborDiscoverer::handOver(UnixSocket& client, const std::string& request) {
+    if (this->logger != nullptr) {
+        this->logger->info("Replacing daemon requested handoff");
+    }
+
+    //daemon with other port, socket path or worker count couldn't use handed over sockets, this one keeps running instead
+    auto checkReturn = DaemonHandoff::checkRequest(request, this->settings, this->localSettings);
+    if (!checkReturn.isOk()) {
+        if (this->logger != nullptr) {
+            this->logger->error("Refusing handoff, keeps running: " + checkReturn.message());
+        }
+        auto refuseReturn = DaemonHandoff::refuse(client, checkReturn.message(), std::chrono::milliseconds(this->settings.handoffTimeoutMs));
+        if (!refuseReturn.isOk() && this->logger != nullptr) {
+            this->logger->error(refuseReturn.message());
+        }
+        return false;
+    }
+
+    //replacing daemon opens journal once handoff is done and continues after last flushed event
+    if (this->journal != nullptr) {
+        auto flushReturn = this->journal->flush();
+        if (!flushReturn.isOk() && this->logger != nullptr) {
+            this->logger->error("Couldn't write neighbor journal: " + flushReturn.message());
+        }
+    }
+
+    //armed multishot requests would keep taking datagrams and clients off handed over sockets until process exits
+    bool ringUsed = this->ioUring != nullptr;
+    this->ioUring = nullptr;
+
+    std::vector<std::pair<HandoffRole, int>> descriptors{};
+    if (this->unixDomainServer != nullptr) {
+        descriptors.emplace_back(HandoffRole::UnixListener, this->unixDomainServer->fd());
+    }
+    if (this->ipv4receiver != nullptr) {
+        descriptors.emplace_back(HandoffRole::IPv4Receiver, this->ipv4receiver->fd());
+    }
+    if (this->ipv6receiver != nullptr) {
+        descriptors.emplace_back(HandoffRole::IPv6Receiver, this->ipv6receiver->fd());
+    }
+
+    //blocks discoverer thread, it stops right after anyway
+    auto sendReturn = DaemonHandoff::send(client, descriptors, NeighborSnapshot::encode(this->neighbors), std::chrono::milliseconds(this->settings.handoffTimeoutMs));
+    if (!sendReturn.isOk()) {
+        if (this->logger != nullptr) {
+            this->logger->error("Handoff failed, keeps running: " + sendReturn.message());
+        }
+        if (ringUsed) {
+            this->startIoUring();
+        }
+        return false;
+    }
+
+    if (this->logger != nullptr) {
+        this->logger->info(std::format("Handed over {} sockets and {} neighbors, stopping", descriptors.size(), this->neighbors.size()));
+    }
+    //socket paths belong to replacing daemon now
+    if (this->unixDomainServer != nullptr) {
+        this->unixDomainServer->keepPath();
+    }
+    this->handoffServer->keepPath();
+
+    this->reactor.stop();
+    if (this->stopHandler) {
+        this->stopHandler();
+    }
+    return true;
+}
+
+std::vector<std::uint8_t> NetworkNeighborDiscoverer::answerCliRequest(const std::string& text) {
+    auto requestReturn = UnixRequest::parse(text);
+    if (!requestReturn.isOk()) {
+        return this->cliError("Malformed CLI request: " + requestReturn.message());
+    }
+
+    if (this->logger != nullptr) {
+        this->logger->info("Received \"" + requestReturn.value().command + "\" request from CLI program");
+    }
+    return this->respondToCli(requestReturn.value());
+}
+
+std::vector<std::uint8_t> NetworkNeighborDiscoverer::respondToCli(const UnixRequest& request) {
+    std::vector<std::uint8_t> clientSBuff;
+    Frame::reserveHeader(clientSBuff);
+
+    if (request.command == this->localSettings.requestString) {
+        auto queryReturn = NeighborQuery::fromRequest(request);
+        if (!queryReturn.isOk()) {
+            return this->cliError("Malformed neighbor query: " + queryReturn.message());
+        }
+
+        //only matching neighbors are copied and serialized
+        const NeighborQuery& query = queryReturn.value();
+        auto candidates = this->subnetCandidates(query);
+        auto now = std::chrono::steady_clock::now();
+        std::vector<NetInterface> selected{};
+        for (const auto& [mac, entry] : this->neighbors) {
+            if (candidates.has_value() && !candidates->contains(mac)) {
+                continue;
+            }
+            if (auto nif = query.apply(entry.first, now - entry.second, this->smoothedRtt(mac)); nif.has_value()) {
+                selected.push_back(std::move(nif.value()));
+            }
+        }
+
+        Serializer::serialize<NetInterface>(clientSBuff, selected);
+        return this->sealCliResponse(clientSBuff, request);
+    } else if (request.command == this->localSettings.pageRequestString) {
+        auto queryReturn = NeighborQuery::fromRequest(request);
+        if (!queryReturn.isOk()) {
+            return this->cliError("Malformed neighbor query: " + queryReturn.message());
+        }
+
+        unsigned long limit = this->localSettings.maxPageSize;
+        try {
+            limit = std::min(std::stoul(request.option("limit").value_or(std::to_string(limit))), limit);
+        } catch (const std::exception&) {
+            limit = 0;
+        }
+        if (limit == 0) {
+            return this->cliError("Malformed neighbor page request: " + request.toString());
+        }
+
+        //cursor is MAC of last neighbor checked for previous page, neighbors added or removed since don't shift following pages
+        const NeighborQuery& query = queryReturn.value();
+        auto candidates = this->subnetCandidates(query);
+        auto now = std::chrono::steady_clock::now();
+        NeighborPage page{};
+        page.generation = this->neighbors.getGeneration();
+        unsigned int scanned = 0;
+        auto cursor = this->neighbors.visitAfter(request.option("after"), [&](const std::string& mac, const NetInterface& nif, std::chrono::steady_clock::time_point lastSeen) {
+            //neighbors outside subnet still count against scan limit, so page cost stays bounded
+            bool candidate = !candidates.has_value() || candidates->contains(mac);
+            if (auto selected = candidate ? query.apply(nif, now - lastSeen, this->smoothedRtt(mac)) : std::nullopt; selected.has_value()) {
+                page.neighbors.push_back(std::move(selected.value()));
+            }
+            return page.neighbors.size() < limit && ++scanned < this->localSettings.pageScanLimit;
+        });
+        page.cursor = cursor.value_or("");
+
+        page.serialize(clientSBuff);
+        return this->sealCliResponse(clientSBuff, request);
+    } else if (request.command == this->localSettings.eventsRequestString) {
+        if (this->journal == nullptr) {
+            return this->cliError("Events requested, but neighbor journal is disabled");
+        }
+
+        std::int64_t fromMs = 0;
+        std::int64_t toMs = wallClockMs();
+        try {
+            fromMs = std::stoll(request.option("from").value_or("0"));
+            toMs = std::stoll(request.option("to").value_or(std::to_string(toMs)));
+        } catch (const std::exception&) {
+            return this->cliError("Malformed events request: " + request.toString());
+        }
+
+        //events still buffered have to be visible to the query, answer without them would be silently stale
+        auto flushReturn = this->journal->flush();
+        if (!flushReturn.isOk()) {
+            return this->cliError("Couldn't write neighbor journal: " + flushReturn.message());
+        }
+        auto queryReturn = this->journal->query(fromMs, toMs);
+        if (!queryReturn.isOk()) {
+            return this->cliError("Couldn't query neighbor journal: " + queryReturn.message());
+        }
+
+        auto& events = queryReturn.value();
+        if (auto mac = request.option("mac"); mac.has_value()) {
+            std::erase_if(events, [&mac](const JournalEvent& event){ return event.nif.mac != mac.value(); });
+        }
+
+        Serializer::serialize<JournalEvent>(clientSBuff, events);
+        return this->sealCliResponse(clientSBuff, request);
+    } else if (request.command == this->localSettings.reloadRequestString) {
+        auto reloadReturn = this->reloadSettings();
+        if (!reloadReturn.isOk()) {
+            return this->cliError(reloadReturn.message());
+        }
+
+        std::string status = "Reloaded settings";
+        const auto& ignored = reloadReturn.value();
+        if (!ignored.empty()) {
+            status += ", restart needed to apply:";
+            for (const auto& key : ignored) {
+                status += " " + key;
+            }
+        }
+        Serializer::serialize(clientSBuff, status);
+        return this->sealCliResponse(clientSBuff, request);
+    } else if (request.command == this->localSettings.lossRequestString) {
+        this->lossReport().serialize(clientSBuff);
+        return this->sealCliResponse(clientSBuff, request);
+    } else if (request.command == this->localSettings.latencyRequestString) {
+        std::vector<NeighborLatency> latencies{};
+        for (const auto& [mac, probed] : this->probedNeighbors) {
+            latencies.push_back(probed.estimator.report(mac));
+        }
+        std::ranges::sort(latencies, {}, &NeighborLatency::mac);
+
+        Serializer::serialize<NeighborLatency>(clientSBuff, latencies);
+        return this->sealCliResponse(clientSBuff, request);
+    } else if (request.command == this->localSettings.shardsRequestString) {
+        std::vector<ShardDigest> digests = this->localShardDigests();
+        for (const auto& remote : this->remoteShardDigests | std::views::values) {
+            digests.push_back(remote.digest);
+        }
+        std::ranges::sort(digests, {}, &ShardDigest::shard);
+
+        Serializer::serialize<ShardDigest>(clientSBuff, digests);
+        return this->sealCliResponse(clientSBuff, request);
+    }
+
+    return this->cliError("Unknown CLI request: " + request.command);
+}
+
+std::vector<std::uint8_t> NetworkNeighborDiscoverer::sealCliResponse(std::vector<std::uint8_t>& buff, const UnixRequest& request) {
+    bool acceptsLz = request.option(Config::UNIX_DOMAIN_ACCEPT_OPTION) == "lz";
+    Frame::seal(buff, this->localSettings.useChecksum, acceptsLz ? this->localSettings.compressionThreshold : 0);
+    return std::move(buff);
+}
+
+std::vector<std::uint8_t> NetworkNeighborDiscoverer::cliError(const std::string& message) {
+    if (this->logger != nullptr) {
+        this->logger->error(message);
+    }
+
+    std::vector<std::uint8_t> buff{};
+    Frame::reserveHeader(buff);
+    Serializer::serialize(buff, message);
+    Frame::seal(buff, this->localSettings.useChecksum, 0, Frame::MessageType::Error);
+    return buff;
+}
+
+Result<std::vector<std::string>> NetworkNeighborDiscoverer::reloadSettings() {
+    if (!this->settingsLoader) {
+        return Error{ErrorCode::NotFound, "Daemon runs without settings file"};
+    }
+
+    DiscoverySettings loaded = this->settings;
+    UnixDomainSettings localLoaded = this->localSettings;
+    auto loadReturn = this->settingsLoader(loaded, localLoaded);
+    if (!loadReturn.isOk()) {
+        return loadReturn.within("Settings not reloaded");
+    }
+
+    //sockets, threads, io_uring and storage are set up once, their settings keep values daemon started with
+    std::vector<std::string> ignored{};
+    auto restartOnly = [&ignored](const char* key, const auto& loadedValue, const auto& currentValue) {
+        if (loadedValue != currentValue) {
+            ignored.push_back(key);
+        }
+    };
+    restartOnly("port", loaded.port, this->settings.port);
+    restartOnly("multicast_shard_count", loaded.shardCount, this->settings.shardCount);
+    restartOnly("multicast_subscribed_shards", loaded.subscribedShards, this->settings.subscribedShards);
+    restartOnly("single_message_max_size_bytes", loaded.maxBufferSize, this->settings.maxBufferSize);
+    restartOnly("checksum_enabled", loaded.useChecksum, this->settings.useChecksum);
+    restartOnly("socket_filter_enabled", loaded.useSocketFilter, this->settings.useSocketFilter);
+    bool buffersChanged = loaded.receiveBufferSize != this->settings.receiveBufferSize || loaded.sendBufferSize != this->settings.sendBufferSize;
+    restartOnly("receive_worker_count", loaded.receiveWorkers, this->settings.receiveWorkers);
+    restartOnly("io_uring_enabled", loaded.useIoUring, this->settings.useIoUring);
+    restartOnly("io_uring_queue_depth", loaded.ioUringQueueDepth, this->settings.ioUringQueueDepth);
+    restartOnly("io_uring_receive_buffers", loaded.ioUringReceiveBuffers, this->settings.ioUringReceiveBuffers);
+    restartOnly("snapshot_path", loaded.snapshotPath, this->settings.snapshotPath);
+    restartOnly("journal_directory", loaded.journalDirectory, this->settings.journalDirectory);
+    restartOnly("journal_segment_size_bytes", loaded.journalSegmentSize, this->settings.journalSegmentSize);
+    restartOnly("journal_max_segments", loaded.journalMaxSegments, this->settings.journalMaxSegments);
+    restartOnly("unix_domain_socket_path", localLoaded.socketPath, this->localSettings.socketPath);
+    restartOnly("handoff_socket_path", loaded.handoffSocketPath, this->settings.handoffSocketPath);
+
+    //assigned one by one, worker threads keep reading restart only fields meanwhile
+    this->settings.sendingPeriodS = loaded.sendingPeriodS;
+    this->settings.neighborActivityPeriodS = loaded.neighborActivityPeriodS;
+    this->workerActivityPeriodS = loaded.neighborActivityPeriodS;
+    this->settings.solicitResponseMaxDelayMs = loaded.solicitResponseMaxDelayMs;
+    this->settings.solicitResponseMinIntervalMs = loaded.solicitResponseMinIntervalMs;
+    this->settings.compressionThreshold = loaded.compressionThreshold;
+    this->settings.snapshotPeriodS = loaded.snapshotPeriodS;
+    this->settings.receiveBufferSize = loaded.receiveBufferSize;
+    this->settings.maxReceiveBufferSize = loaded.maxReceiveBufferSize;
+    this->settings.probePeriodMs = loaded.probePeriodMs;
+    this->settings.probeMaxPerSecond = loaded.probeMaxPerSecond;
+    this->settings.probeTimeoutMs = loaded.probeTimeoutMs;
+    this->settings.probeReplyMaxPerSecond = loaded.probeReplyMaxPerSecond;
+    this->settings.sendBufferSize = loaded.sendBufferSize;
+    this->settings.handoffTimeoutMs = loaded.handoffTimeoutMs;
+    if (buffersChanged) {
+        this->setupSocketBuffers();
+    }
+
+    this->localSettings.maxPageSize = localLoaded.maxPageSize;
+    this->localSettings.pageScanLimit = localLoaded.pageScanLimit;
+    this->localSettings.maxRequestSize = localLoaded.maxRequestSize;
+    this->localSettings.requestTimeoutMs = localLoaded.requestTimeoutMs;
+    this->localSettings.idleTimeoutS = localLoaded.idleTimeoutS;
+    this->localSettings.compressionThreshold = localLoaded.compressionThreshold;
+
+    if (this->logger != nullptr) {
+        this->logger->info("Reloaded settings");
+        for (const auto& key : ignored) {
+            this->logger->info("Change of " + key + " is applied only after restart");
+        }
+    }
+    return Result<std::vector<std::string>>{std::move(ignored)};
+}
+
+void NetworkNeighborDiscoverer::setupSignals() {
+    ::sigset_t mask{};
+    ::sigemptyset(&mask);
+    ::sigaddset(&mask, SIGHUP);
+    ::sigaddset(&mask, SIGTERM);
+    ::sigaddset(&mask, SIGINT);
+    if (::pthread_sigmask(SIG_BLOCK, &mask, nullptr) != 0) {
+        if (this->logger != nullptr) {
+            this->logger->error("Couldn't block signals, settings reload and graceful stop on signal disabled");
+        }
+        return;
+    }
 
-void NetworkNeighborDiscoverer::runIteration() {
+    this->signalFd = ::signalfd(-1, &mask, SFD_NONBLOCK | SFD_CLOEXEC);
+    if (this->signalFd < 0) {
+        //blocked signals would be ignored without signalfd, default actions are restored
+        ::pthread_sigmask(SIG_UNBLOCK, &mask, nullptr);
+        if (this->logger != nullptr) {
+            this->logger->error(std::string("signalfd() failed, settings reload and graceful stop on signal disabled: ") + std::strerror(errno));
+        }
+    }
+}
 
-    //get system's network interfaces
-    std::vector<NetInterface> nifs{};
-    auto nifReturn = NetInterfaceManager::getInterfaces();
-    
-    if (nifReturn.isOk()) {
-        nifs = nifReturn.data.value();
+void NetworkNeighborDiscoverer::setupJournal() {
+    if (this->settings.journalDirectory.empty()) {
+        return;
+    }
+
+    auto funcReturn = NeighborJournal::factory(this->settings.journalDirectory, this->settings.journalSegmentSize, this->settings.journalMaxSegments);
+    if (funcReturn.isOk()) {
+        this->journal = std::make_unique<NeighborJournal>(std::move(funcReturn).value());
     } else {
         if (this->logger != nullptr) {
-            logger->error("Couldn't retrieve system's network interfaces :" + nifReturn.msg.value());
+            this->logger->error("Couldn't open neighbor journal: " + funcReturn.message());
         }
+        this->journal = nullptr;
     }
+}
 
-    if (nifs.size() > 0) {
-        bool canUseIPv6 = std::ranges::any_of(nifs, [](const NetInterface& nif) { return nif.ipv6s.size() > 0; });
-        bool canUseIPv4 = std::ranges::any_of(nifs, [](const NetInterface& nif) { return nif.ipv6s.size() > 0; });
-
-        if (prevNifs != nifs) {
-            if (this->logger != nullptr) {
-                if (this->logger != nullptr) {
-                    auto macsVec = nifs | std::views::transform([](const NetInterface& nif){ return nif.mac; });    
-                    std::ostringstream macs;
-                    for (const auto& mac : macsVec) {
-                        macs << mac << " ";
-                    }
-                    logger->info("Found system's interfaces with MACs: " + macs.str());
-                }
+void NetworkNeighborDiscoverer::restoreSnapshot() {
+    //handed over table is newer than any snapshot replaced daemon wrote
+    if (this->handoff.has_value()) {
+        auto decodeReturn = NeighborSnapshot::decode(this->handoff->neighborSnapshot, this->neighbors, std::chrono::seconds(this->settings.neighborActivityPeriodS));
+        if (this->logger != nullptr) {
+            if (decodeReturn.isOk()) {
+                this->logger->info(std::format("Took over {} neighbors from replaced daemon", decodeReturn.value()));
+            } else {
+                this->logger->error("Couldn't take over neighbors of replaced daemon: " + decodeReturn.message());
             }
+        }
+        this->prevSnapshotTime = std::chrono::steady_clock::now();
+        return;
+    }
 
-            //update senders/receivers
-            auto nifsToDisable = this->prevNifs
-                | std::views::filter([&](const NetInterface& nif){
-                    return std::ranges::find(nifs, nif) == nifs.end();
-                });
-            
-            for (const auto& nif : nifsToDisable) {
-                if (this->ipv6receiver != nullptr) {
-                    auto disReturn = this->ipv6receiver
-                        ->disableMulticastGroup(IPAddresses::IPv6CustomMulticast, ::if_nametoindex(nif.name.c_str()));
-                    if (this->logger != nullptr && !disReturn.isOk()) {
-                        this->logger->error(std::format("Couldn't disable IPv6 multicast receival on {}", nif.name) + ": " + disReturn.msg.value());
-                    }
-                }
-                
-                if (this->ipv6sender != nullptr) {
-                    auto disReturn = this->ipv6sender
-                        ->removeMulticastAddress(IPAddresses::IPv6CustomMulticast, this->settings.port,::if_nametoindex(nif.name.c_str()));
-                    if (this->logger != nullptr && !disReturn.isOk()) {
-                        this->logger->error(std::format("Couldn't disable IPv6 multicast sending on {}", nif.name) + ": " + disReturn.msg.value());
-                    }
-                }
+    if (this->settings.snapshotPath.empty()) {
+        return;
+    }
 
-                if (this->ipv4receiver != nullptr) {
-                    auto disReturn = this->ipv4receiver
-                        ->disableMulticastGroup(IPAddresses::IPv4CustomMulticast, ::if_nametoindex(nif.name.c_str()));
-                    if (this->logger != nullptr && !disReturn.isOk()) {
-                        this->logger->error(std::format("Couldn't disable IPv4 multicast receival on {}", nif.name) + ": " + disReturn.msg.value());
-                    }
-                }
-                
-                if (this->ipv4sender != nullptr) {
-                    auto disReturn = this->ipv4sender
-                        ->removeMulticastAddress(IPAddresses::IPv4CustomMulticast, this->settings.port, ::if_nametoindex(nif.name.c_str()));
-                    if (this->logger != nullptr && !disReturn.isOk()) {
-                        this->logger->error(std::format("Couldn't disable IPv4 multicast sending on {}", nif.name) + ": " + disReturn.msg.value());
-                    }
-                }
-            }
+    auto restoreReturn = NeighborSnapshot::restore(this->settings.snapshotPath, this->neighbors, std::chrono::seconds(this->settings.neighborActivityPeriodS));
+    if (this->logger != nullptr) {
+        if (restoreReturn.isOk()) {
+            this->logger->info(std::format("Restored {} neighbors from {}", restoreReturn.value(), this->settings.snapshotPath));
+        } else {
+            this->logger->error("Couldn't restore neighbors: " + restoreReturn.message());
+        }
+    }
+    this->prevSnapshotTime = std::chrono::steady_clock::now();
+}
 
-            auto nifsToEnable = nifs
-                | std::views::filter([&](const NetInterface& nif){
-                    return std::ranges::find(this->prevNifs, nif) == this->prevNifs.end();
-                });
+void NetworkNeighborDiscoverer::saveSnapshot() {
+    if (this->settings.snapshotPath.empty()) {
+        return;
+    }
 
-            for (const auto& nif : nifsToEnable) {
-                if (this->ipv6receiver != nullptr) {
-                    auto disReturn = this->ipv6receiver
-                        ->enableMulticastGroup(IPAddresses::IPv6CustomMulticast, ::if_nametoindex(nif.name.c_str()));
-                    if (this->logger != nullptr && !disReturn.isOk()) {
-                        this->logger->error(std::format("Couldn't enable IPv6 multicast receival on {}", nif.name) + ": " + disReturn.msg.value());
-                    }
-                }
-                
-                if (this->ipv6sender != nullptr) {
-                    auto disReturn = this->ipv6sender
-                        ->addMulticastAddress(IPAddresses::IPv6CustomMulticast, this->settings.port,::if_nametoindex(nif.name.c_str()));
-                    if (this->logger != nullptr && !disReturn.isOk()) {
-                        this->logger->error(std::format("Couldn't enable IPv6 multicast sending on {}", nif.name) + ": " + disReturn.msg.value());
-                    }
-                }
+    auto now = std::chrono::steady_clock::now();
+    if (!this->neighborsChanged && now - this->prevSnapshotTime < std::chrono::seconds(this->settings.snapshotPeriodS)) {
+        return;
+    }
 
-                if (this->ipv4receiver != nullptr) {
-                    auto disReturn = this->ipv4receiver
-                        ->enableMulticastGroup(IPAddresses::IPv4CustomMulticast, ::if_nametoindex(nif.name.c_str()));
-                    if (this->logger != nullptr && !disReturn.isOk()) {
-                        this->logger->error(std::format("Couldn't enable IPv4 multicast receival on {}", nif.name) + ": " + disReturn.msg.value());
-                    }
-                }
-                
-                if (this->ipv4sender != nullptr) {
-                    auto disReturn = this->ipv4sender
-                        ->addMulticastAddress(IPAddresses::IPv4CustomMulticast, this->settings.port,::if_nametoindex(nif.name.c_str()));
-                    if (this->logger != nullptr && !disReturn.isOk()) {
-                        this->logger->error(std::format("Couldn't enable IPv4 multicast sending on {}", nif.name) + ": " + disReturn.msg.value());
-                    }
-                }
-            }
+    auto saveReturn = NeighborSnapshot::save(this->settings.snapshotPath, this->neighbors);
+    if (!saveReturn.isOk() && this->logger != nullptr) {
+        this->logger->error(saveReturn.message());
+    }
+    this->neighborsChanged = false;
+    this->prevSnapshotTime = now;
+}
+
+void NetworkNeighborDiscoverer::handleDatagram(const std::string& sender, unsigned int ifindex, std::chrono::steady_clock::time_point arrival, std::vector<std::uint8_t>& rbuff, std::size_t size,
+    std::unordered_map<std::string, SenderFingerprint>& fingerprints, ReceivedBatch& batch) {
+    rbuff.resize(size);
 
+    //summaries and probes don't describe the sender, they must not replace its payload fingerprint
+    if (Frame::messageType(rbuff) == Frame::MessageType::Summary) {
+        this->handleSummary(sender, rbuff, batch);
+        return;
+    }
+    if (Frame::messageType(rbuff) == Frame::MessageType::Probe || Frame::messageType(rbuff) == Frame::MessageType::ProbeReply) {
+        this->handleProbe(sender, arrival, rbuff, batch);
+        return;
+    }
+
+    //integrity check happens before header is used or payload is compared, unchanged payloads included
+    //checksum is verified whenever frame carries one, frames without it come from peers with checksum_enabled off and are accepted
+    auto verifyReturn = Frame::verify(rbuff, false);
+    if (!verifyReturn.isOk()) {
+        if (this->logger != nullptr) {
+            this->logger->error(std::format("Dropped {}B from {}: ", size, sender) + verifyReturn.message());
         }
+        return;
+    }
+    const auto& header = verifyReturn.value();
 
-        //send own interfaces
-        {
-            std::vector<std::uint8_t> sbuff{};
-            Serializer::serialize<NetInterface>(sbuff, nifs);
+    //looped back own frame, normally dropped already by socket filter
+    if (header.offset != 0 && header.origin == Frame::localOrigin()) {
+        return;
+    }
+    if (header.sequence != 0) {
+        batch.sequences.push_back(ReceivedBatch::SequencedFrame{sender, header.origin, header.sequence, arrival});
+    }
 
-            if (canUseIPv6 && this->ipv6sender != nullptr) {
-                this->ipv6sender->send(sbuff);
-            }
+    //header and trailer change with sequence, fingerprint covers what sender announced, both are verified above
+    auto payload = Frame::rawPayload(rbuff);
+    std::uint64_t hash = PayloadFingerprint::compute(payload.data(), payload.size());
+    //restarted peer may repeat its previous solicitation byte for byte, it still has to be answered
+    bool solicitation = Frame::messageType(rbuff) == Frame::MessageType::Solicitation;
+
+    auto it = fingerprints.find(sender);
+    if (!solicitation && it != fingerprints.end() && it->second.hash == hash && it->second.size == size) {
+        it->second.lastSeen = std::max(it->second.lastSeen, arrival);
+        auto [unchangedIt, inserted] = batch.unchangedSenders.try_emplace(sender, arrival);
+        unchangedIt->second = std::max(unchangedIt->second, arrival);
+        return;
+    }
+
+    //sent more than once during this iteration
+    auto batchIt = batch.fingerprints.find(sender);
+    if (!solicitation && batchIt != batch.fingerprints.end() && batchIt->second.hash == hash && batchIt->second.size == size) {
+        return;
+    }
+
+    auto frameReturn = Frame::open(rbuff, false, this->settings.maxBufferSize);
+    if (!frameReturn.isOk()) {
+        if (this->logger != nullptr) {
+            this->logger->error(std::format("Dropped {}B from {}: ", size, sender) + frameReturn.message());
+        }
+        return;
+    }
+
+    std::size_t offset = frameReturn.value().offset;
+    auto desReturn = Deserializer::deserialize<NetInterface>(rbuff, offset);
+    if (!desReturn.isOk()) {
+        if (this->logger != nullptr) {
+            this->logger->error("Couldn't deserialize data: " + desReturn.message());
+        }
+        return;
+    }
+
+    for (NetInterface& nif : desReturn.value()) {
+        if (solicitation) {
+            batch.solicitingMacs.push_back(nif.mac);
+        }
+        batch.nifSenders[nif.mac] = sender;
+        batch.nifIfindexes[nif.mac] = ifindex;
+        batch.nifArrivals[nif.mac] = arrival;
+        batch.nifs[nif.mac] = std::move(nif);
+    }
+    batch.fingerprints[sender] = SenderFingerprint{hash, size, {}, arrival, frameReturn.value().capabilities};
+}
+
+void NetworkNeighborDiscoverer::startReceiveWorkers() {
+    for (auto& worker : this->receiveWorkers) {
+        worker->thread = std::thread(&NetworkNeighborDiscoverer::runReceiveWorker, this, std::ref(*worker));
+    }
+}
 
-            if (canUseIPv4 && this->ipv4sender != nullptr) {
-                this->ipv4sender->send(sbuff);
+void NetworkNeighborDiscoverer::runReceiveWorker(ReceiveWorker& worker) {
+    constexpr int POLL_TIMEOUT_MS = 500;
+
+    std::vector<::pollfd> fds{};
+    if (worker.ipv6receiver != nullptr) {
+        fds.push_back(::pollfd{worker.ipv6receiver->fd(), POLLIN, 0});
+    }
+    if (worker.ipv4receiver != nullptr) {
+        fds.push_back(::pollfd{worker.ipv4receiver->fd(), POLLIN, 0});
+    }
+    if (fds.empty()) {
+        return;
+    }
+
+    while (!this->stopReceiveWorkers) {
+        if (::poll(fds.data(), fds.size(), POLL_TIMEOUT_MS) <= 0) {
+            continue;
+        }
+
+        unsigned int generation = this->fingerprintsGeneration;
+        if (generation != worker.fingerprintsGeneration) {
+            worker.fingerprints.clear();
+            worker.fingerprintsGeneration = generation;
+        }
+
+        ReceivedBatch batch{};
+        for (int i = 0; i < MAX_DATAGRAMS_PER_BATCH; i++) {
+            if (this->receiveDatagrams(worker.ipv6receiver.get(), worker.ipv4receiver.get(), worker.fingerprints, batch) <= 0) {
+                break;
             }
         }
 
-        //receive 
-        std::unordered_map<std::string, NetInterface> receivedNifs{};
-        bool receivedRequestFromCliClient = false;
-        std::unique_ptr<UnixSocket> clientSocket = nullptr;
+        auto now = std::chrono::steady_clock::now();
+        for (const auto& [sender, fingerprint] : batch.fingerprints) {
+            worker.fingerprints[sender] = SenderFingerprint{fingerprint.hash, fingerprint.size, {}, fingerprint.lastSeen, fingerprint.capabilities};
+        }
+        std::erase_if(worker.fingerprints, [&](const auto& entry) {
+            return now - entry.second.lastSeen > std::chrono::seconds(this->workerActivityPeriodS.load());
+        });
+
+        if (batch.empty()) {
+            continue;
+        }
         {
-            auto receiveStart = std::chrono::steady_clock::now();
-            unsigned int receiveTimePassedS = 0;
-            int receivedBytes = 0;
-            do {
-                if (canUseIPv6 && this->ipv6sender != nullptr) {
-                    std::vector<std::uint8_t> rbuff(this->settings.maxBufferSize);
-                    ::sockaddr_in6 sender{};
-                    int n = this->ipv6receiver->receive(rbuff, &sender);
-
-                    if (n > 0) {
-                        if (this->logger != nullptr) {
-                            char addrbuf[INET6_ADDRSTRLEN];
-                            ::inet_ntop(AF_INET6, &sender.sin6_addr, addrbuf, sizeof(addrbuf));
-                            this->logger->info(std::format("Received {}B from {}", n, addrbuf));
-                        }
-                        auto desReturn = Deserializer::deserialize<NetInterface>(rbuff);
-                        if (desReturn.isOk()) {
-                            auto ipv6ReceivedNifs = desReturn.data.value();
-
-                            for (const NetInterface& nif : ipv6ReceivedNifs) {
-                                receivedNifs[nif.mac] = nif;
-                            }
-                        } else {
-                            if (this->logger != nullptr) {
-                                this->logger->error("Couldn't deserialize data: " + desReturn.msg.value());
-                            }
-                        }
-
-                        receivedBytes += n;
-                    }
-                }
+            std::lock_guard<std::mutex> lock(this->workerBatchesMutex);
+            this->workerBatches.push_back(std::move(batch));
+        }
+        std::uint64_t signal = 1;
+        ::write(this->workerEventFd, &signal, sizeof(signal));
+    }
+}
 
-                if (canUseIPv4 && this->ipv4sender != nullptr) {
-                    std::vector<std::uint8_t> rbuff(this->settings.maxBufferSize);
-                    ::sockaddr_in sender{};
-                    int n = this->ipv4receiver->receive(rbuff, &sender);
-
-                    if (n > 0) {
-                        if (this->logger != nullptr) {
-                            char addrbuf[INET_ADDRSTRLEN];
-                            ::inet_ntop(AF_INET, &sender.sin_addr, addrbuf, sizeof(addrbuf));
-                            this->logger->info(std::format("Received {}B from {}", n, addrbuf));
-                        }
-                        receivedBytes += n;
-                        auto desReturn = Deserializer::deserialize<NetInterface>(rbuff);
-                        if (desReturn.isOk()) {
-                            auto ipv4ReceivedNifs = desReturn.data.value();
-
-                            for (const NetInterface& nif : ipv4ReceivedNifs) {
-                                receivedNifs[nif.mac] = nif;
-                            }
-                        } else {
-                            if (this->logger != nullptr) {
-                                this->logger->error("Couldn't deserialize data: " + desReturn.msg.value());
-                            }
-                        }
-                    }
-                }
+void NetworkNeighborDiscoverer::startIoUring() {
+    if (!this->settings.useIoUring) {
+        return;
+    }
 
-                //check if someone requested neigbhor list using cli
-                //isOk returns true if client connected
-                if (this->unixDomainServer != nullptr) {
-                    auto clientSocketReturn = this->unixDomainServer->acceptClient();
-                    if (clientSocketReturn.isOk()) {
-                        if (this->logger != nullptr) {
-                            this->logger->info("Established client connection on UNIX domain socket");
-                        }
-
-                        clientSocket = std::make_unique<UnixSocket>(std::move(clientSocketReturn.data.value()));
-
-                        auto recReturn = clientSocket->receiveString(sizeof(this->localSettings.requestString));
-                        if (!recReturn.isOk()) {
-                            if (this->logger != nullptr) {
-                                this->logger->error("Couldn't receive from client over UNIX domain: " + recReturn.msg.value());
-                            }
-                        } else {
-                            if (recReturn.data.value() == this->localSettings.requestString) {
-                                if (this->logger != nullptr) {
-                                    this->logger->info("Received neigbhor list request from CLI program");
-                                }
-                                receivedRequestFromCliClient = true;
-                            }
-                        }
-                    }
-                }
+    //one provided buffer takes whole multishot recvmsg result of largest datagram
+    std::uint32_t bufferSize = this->settings.maxBufferSize + IPMulticastReceiver<::sockaddr_in6>::MULTISHOT_OVERHEAD;
+    auto funcReturn = IoUring::factory(this->settings.ioUringQueueDepth, static_cast<std::uint16_t>(this->settings.ioUringReceiveBuffers), bufferSize);
+    if (!funcReturn.isOk()) {
+        if (this->logger != nullptr) {
+            this->logger->error("io_uring unavailable, using poll(): " + funcReturn.message());
+        }
+        return;
+    }
+    this->ioUring = std::make_unique<IoUring>(std::move(funcReturn).value());
+
+    for (IoUringTarget target : {IPv6ReceiverTarget, IPv4ReceiverTarget, CliServerTarget}) {
+        auto armReturn = this->armIoUring(target);
+        if (!armReturn.isOk()) {
+            this->disableIoUring(armReturn.message());
+            return;
+        }
+    }
+
+    this->submitIoUring();
+
+    if (this->logger != nullptr) {
+        this->logger->info("Using io_uring for multicast and UNIX domain I/O");
+    }
+}
 
-                receiveTimePassedS = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now() - receiveStart).count();
+void NetworkNeighborDiscoverer::submitIoUring() {
+    if (this->ioUring == nullptr) {
+        return;
+    }
+
+    //queued sends and rearmed requests would otherwise wait for next completion
+    auto funcReturn = this->ioUring->submit();
+    if (!funcReturn.isOk() && this->logger != nullptr) {
+        this->logger->error("Failed submitting io_uring requests: " + funcReturn.message());
+    }
+}
 
-            } while(receivedBytes > 0 
-                && receiveTimePassedS < this->settings.sendingPeriodS
-                && !receivedRequestFromCliClient);
+void NetworkNeighborDiscoverer::disableIoUring(const std::string& reason) {
+    if (this->logger != nullptr) {
+        this->logger->error("Disabling io_uring, using poll(): " + reason);
+    }
+    this->ioUring = nullptr;
+}
+
+Result<> NetworkNeighborDiscoverer::armIoUring(IoUringTarget target) {
+    switch (target) {
+    case IPv6ReceiverTarget:
+        if (this->ipv6receiver != nullptr) {
+            return this->ioUring->receiveMultishot(this->ipv6receiver->fd(), this->ipv6receiver->multishotHeader(), target);
+        }
+        break;
+    case IPv4ReceiverTarget:
+        if (this->ipv4receiver != nullptr) {
+            return this->ioUring->receiveMultishot(this->ipv4receiver->fd(), this->ipv4receiver->multishotHeader(), target);
         }
+        break;
+    case CliServerTarget:
+        if (this->unixDomainServer != nullptr) {
+            return this->ioUring->acceptMultishot(this->unixDomainServer->fd(), target);
+        }
+        break;
+    }
+    return Result<>{};
+}
 
-        //handle received network interfaces
-        {
-            for (const auto& received : (receivedNifs | std::views::values)) {
-                std::vector<IPv4Info> matchedIPv4;
-                for (const auto& rIPv4 : received.ipv4s) {
-                    if (std::ranges::any_of(nifs, [&](const auto& local){
-                        return std::ranges::any_of(local.ipv4s, [&](const auto& lIPv4){
-                            return NetInterfaces::IPAddressManager::isSameSubnet(lIPv4, rIPv4);
-                        });
-                    })) {
-                        matchedIPv4.push_back(rIPv4);
-                    }
-                }
+void NetworkNeighborDiscoverer::handleCompletions(const std::vector<IoUring::Completion>& ready, ReceivedBatch& batch) {
+    //datagram is copied out of provided buffer, so buffer goes back to kernel right away
+    auto handleReceived = [&]<typename T>(IPMulticastReceiver<T>* receiver, const IoUring::Completion& completion) {
+        std::vector<std::uint8_t> rbuff(this->settings.maxBufferSize);
+        T sender{};
+        unsigned int ifindex = 0;
+        std::chrono::system_clock::time_point stamp{};
+        int n = static_cast<int>(receiver->receive(this->ioUring->buffer(completion), rbuff, &sender, &ifindex, &stamp));
+        this->ioUring->recycle(completion);
 
-                // Filter IPv6 addresses that match any local interface
-                std::vector<IPv6Info> matchedIPv6;
-                for (const auto& rIPv6 : received.ipv6s) {
-                    if (std::ranges::any_of(nifs, [&](const auto& local){
-                        return std::ranges::any_of(local.ipv6s, [&](const auto& lIPv6){
-                            return NetInterfaces::IPAddressManager::isSameSubnet(lIPv6, rIPv6);
-                        });
-                    })) {
-                        matchedIPv6.push_back(rIPv6);
-                    }
-                }
+        if (n > 0) {
+            std::string scopedSender = scopedAddress(sender, ifindex);
+            auto arrival = steadyArrival(stamp);
+            if (this->logger != nullptr) {
+                this->logger->info(std::format("Received {}B from {}, queued {}us", n, scopedSender, queuedMicroseconds(arrival)));
+            }
+            this->handleDatagram(scopedSender, ifindex, arrival, rbuff, n, this->senderFingerprints, batch);
+        }
+    };
+
+    for (const IoUring::Completion& completion : ready) {
+        //disabled while handling previous completion
+        if (this->ioUring == nullptr) {
+            break;
+        }
 
-                if (!matchedIPv4.empty() || !matchedIPv6.empty()) {
-                    NetInterface filteredNif = received;
-                    filteredNif.ipv4s = std::move(matchedIPv4);
-                    filteredNif.ipv6s = std::move(matchedIPv6);
-                    //add/update to timedindexedset
-                    this->neighbors.update(filteredNif.mac, filteredNif);
+        switch (completion.operation) {
+        case IoUring::Operation::Receive:
+            if (!completion.hasBuffer()) {
+                break;
+            }
+            if (completion.target == IPv6ReceiverTarget && this->ipv6receiver != nullptr) {
+                handleReceived(this->ipv6receiver.get(), completion);
+            } else if (completion.target == IPv4ReceiverTarget && this->ipv4receiver != nullptr) {
+                handleReceived(this->ipv4receiver.get(), completion);
+            } else {
+                this->ioUring->recycle(completion);
+            }
+            break;
+        case IoUring::Operation::Accept:
+            if (completion.result >= 0) {
+                auto clientReturn = UnixSocket::acceptedFactory(completion.result);
+                if (clientReturn.isOk()) {
+                    this->reactor.spawn(this->cliSession(std::move(clientReturn).value()));
                 }
             }
-
-            this->neighbors.remove(std::chrono::seconds(this->settings.neighborActivityPeriodS));
+            break;
+        case IoUring::Operation::Send:
+            if (completion.result < 0 && this->logger != nullptr) {
+                this->logger->error(std::string("Failed sending datagram: ") + std::strerror(-completion.result));
+            }
+            continue;
         }
 
-        //send neighbors to CLI client requestor
-        if (receivedRequestFromCliClient && this->unixDomainServer != nullptr && clientSocket != nullptr) {
-            std::vector<std::uint8_t> clientSBuff;
-            Serializer::serialize<NetInterface>(clientSBuff, this->neighbors.data());
-            auto sendReturn = clientSocket->send(clientSBuff);
-            if (!sendReturn.isOk() && this->logger != nullptr) {
-                this->logger->error("Failed to send neighbor list to client: " + sendReturn.msg.value());
-            } else if (sendReturn.isOk()) {
-                this->logger->info("Sent neighbor list to CLI client");
+        //multishot request ends when kernel can't continue it, running out of provided buffers is recovered by rearming
+        if (!completion.more()) {
+            if (completion.result < 0 && completion.result != -ENOBUFS) {
+                this->disableIoUring(std::format("multishot request {} ended: {}", static_cast<unsigned int>(completion.target), std::strerror(-completion.result)));
+                break;
+            }
+            auto armReturn = this->armIoUring(static_cast<IoUringTarget>(completion.target));
+            if (!armReturn.isOk()) {
+                this->disableIoUring(armReturn.message());
+                break;
             }
         }
+    }
+}
 
+bool NetworkNeighborDiscoverer::peersSupport(std::uint8_t capabilities) const {
+    //frames sent before anybody was heard from, e.g. solicitations on start or new interface, reach peers of unknown capabilities
+    if (this->senderFingerprints.empty()) {
+        return false;
+    }
+    return std::ranges::all_of(this->senderFingerprints | std::views::values, [&](const SenderFingerprint& fingerprint) {
+        return (fingerprint.capabilities & capabilities) == capabilities;
+    });
+}
+
+void NetworkNeighborDiscoverer::setupShards() {
+    auto funcReturn = MulticastShards::parseSubscription(this->settings.subscribedShards, this->settings.shardCount);
+    if (funcReturn.isOk()) {
+        this->subscribedShards = std::move(funcReturn).value();
+    } else {
+        if (this->logger != nullptr) {
+            this->logger->error("Invalid shard subscription, subscribing to all shards: " + funcReturn.message());
+        }
+        this->subscribedShards = MulticastShards::parseSubscription("", this->settings.shardCount).value();
+    }
+
+    this->receivedGroups = this->subscribedShards;
+    if (this->settings.shardCount > 1) {
+        this->receivedGroups.push_back(this->settings.shardCount);
     }
-    this->prevNifs = std::move(nifs);
 }
 
 void NetworkNeighborDiscoverer::setupIPv6Sockets() {
@@ -320,26 +1900,58 @@ void NetworkNeighborDiscoverer::setupIPv6Sockets() {
         auto funcReturn = IPMulticastSender<::sockaddr_in6>::factory();
         if (funcReturn.isOk()) {
             this->ipv6sender = std::make_unique<IPMulticastSender<::sockaddr_in6>>(
-                    std::move(funcReturn.data.value())
+                    std::move(funcReturn).value()
                 );
         } else {
             if (this->logger != nullptr) {
-                this->logger->error("Failed creating IPv6 sender socket: " + funcReturn.msg.value());
+                this->logger->error("Failed creating IPv6 sender socket: " + funcReturn.message());
             }
             this->ipv6sender = nullptr;
         }
     }
 
-    //receiver block
-    {
-        auto funcReturn = IPMulticastReceiver<::sockaddr_in6>::factory(this->settings.port);
+    //summary sender block
+    if (this->settings.shardCount > 1) {
+        auto funcReturn = IPMulticastSender<::sockaddr_in6>::factory();
+        if (funcReturn.isOk()) {
+            this->ipv6summarySender = std::make_unique<IPMulticastSender<::sockaddr_in6>>(
+                    std::move(funcReturn).value()
+                );
+        } else {
+            if (this->logger != nullptr) {
+                this->logger->error("Failed creating IPv6 summary sender socket: " + funcReturn.message());
+            }
+            this->ipv6summarySender = nullptr;
+        }
+    }
+
+    //receiver block, receive workers own their sockets instead
+    if (this->settings.receiveWorkers == 0) {
+        //receiver handed over by replaced daemon is already bound and joined to groups
+        int adoptedFd = this->handoff.has_value() ? this->handoff->take(HandoffRole::IPv6Receiver) : -1;
+        auto funcReturn = adoptedFd >= 0 ? IPMulticastReceiver<::sockaddr_in6>::adoptedFactory(adoptedFd, this->settings.port)
+            : IPMulticastReceiver<::sockaddr_in6>::factory(this->settings.port);
+        if (adoptedFd >= 0 && !funcReturn.isOk()) {
+            if (this->logger != nullptr) {
+                this->logger->error("Couldn't take over IPv6 receiver socket, creating new one: " + funcReturn.message());
+            }
+            funcReturn = IPMulticastReceiver<::sockaddr_in6>::factory(this->settings.port);
+        }
         if (funcReturn.isOk()) {
             this->ipv6receiver = std::make_unique<IPMulticastReceiver<::sockaddr_in6>>(
-                    std::move(funcReturn.data.value())
+                    std::move(funcReturn).value()
                 );
+
+            if (this->settings.useSocketFilter) {
+                auto program = FrameFilter::program(Frame::localOrigin());
+                auto filterReturn = this->ipv6receiver->attachFilter(program);
+                if (!filterReturn.isOk() && this->logger != nullptr) {
+                    this->logger->error("Failed attaching filter to IPv6 receiver socket, receiving unfiltered: " + filterReturn.message());
+                }
+            }
         } else {
             if (this->logger != nullptr) {
-                this->logger->error("Failed creating IPv6 receiver socket: " + funcReturn.msg.value());
+                this->logger->error("Failed creating IPv6 receiver socket: " + funcReturn.message());
             }
             this->ipv6receiver = nullptr;
         }
@@ -352,43 +1964,231 @@ void NetworkNeighborDiscoverer::setupIPv4Sockets() {
         auto funcReturn = IPMulticastSender<::sockaddr_in>::factory();
         if (funcReturn.isOk()) {
             this->ipv4sender = std::make_unique<IPMulticastSender<::sockaddr_in>>(
-                    std::move(funcReturn.data.value())
+                    std::move(funcReturn).value()
                 );
         } else {
             if (this->logger != nullptr) {
-                this->logger->error("Failed creating IPv4 sender socket: " + funcReturn.msg.value());
+                this->logger->error("Failed creating IPv4 sender socket: " + funcReturn.message());
             }
             this->ipv4sender = nullptr;
         }
     }
 
-    //receiver block
-    {
-        auto funcReturn = IPMulticastReceiver<::sockaddr_in>::factory(this->settings.port);
+    //summary sender block
+    if (this->settings.shardCount > 1) {
+        auto funcReturn = IPMulticastSender<::sockaddr_in>::factory();
+        if (funcReturn.isOk()) {
+            this->ipv4summarySender = std::make_unique<IPMulticastSender<::sockaddr_in>>(
+                    std::move(funcReturn).value()
+                );
+        } else {
+            if (this->logger != nullptr) {
+                this->logger->error("Failed creating IPv4 summary sender socket: " + funcReturn.message());
+            }
+            this->ipv4summarySender = nullptr;
+        }
+    }
+
+    //receiver block, receive workers own their sockets instead
+    if (this->settings.receiveWorkers == 0) {
+        //receiver handed over by replaced daemon is already bound and joined to groups
+        int adoptedFd = this->handoff.has_value() ? this->handoff->take(HandoffRole::IPv4Receiver) : -1;
+        auto funcReturn = adoptedFd >= 0 ? IPMulticastReceiver<::sockaddr_in>::adoptedFactory(adoptedFd, this->settings.port)
+            : IPMulticastReceiver<::sockaddr_in>::factory(this->settings.port);
+        if (adoptedFd >= 0 && !funcReturn.isOk()) {
+            if (this->logger != nullptr) {
+                this->logger->error("Couldn't take over IPv4 receiver socket, creating new one: " + funcReturn.message());
+            }
+            funcReturn = IPMulticastReceiver<::sockaddr_in>::factory(this->settings.port);
+        }
         if (funcReturn.isOk()) {
             this->ipv4receiver = std::make_unique<IPMulticastReceiver<::sockaddr_in>>(
-                    std::move(funcReturn.data.value())
+                    std::move(funcReturn).value()
                 );
+
+            if (this->settings.useSocketFilter) {
+                auto program = FrameFilter::program(Frame::localOrigin());
+                auto filterReturn = this->ipv4receiver->attachFilter(program);
+                if (!filterReturn.isOk() && this->logger != nullptr) {
+                    this->logger->error("Failed attaching filter to IPv4 receiver socket, receiving unfiltered: " + filterReturn.message());
+                }
+            }
         } else {
             if (this->logger != nullptr) {
-                this->logger->error("Failed creating IPv4 receiver socket: " + funcReturn.msg.value());
+                this->logger->error("Failed creating IPv4 receiver socket: " + funcReturn.message());
             }
             this->ipv4receiver = nullptr;
         }
     }
 }
 
+template<typename T>
+std::unique_ptr<IPMulticastReceiver<T>> NetworkNeighborDiscoverer::createWorkerReceiver(unsigned int workerIndex) {
+    constexpr const char* family = std::is_same_v<T, ::sockaddr_in6> ? "IPv6" : "IPv4";
+
+    auto funcReturn = IPMulticastReceiver<T>::factory(this->settings.port, true);
+    if (!funcReturn.isOk()) {
+        if (this->logger != nullptr) {
+            this->logger->error(std::format("Failed creating {} receiver socket of worker {}: ", family, workerIndex) + funcReturn.message());
+        }
+        return nullptr;
+    }
+    auto receiver = std::make_unique<IPMulticastReceiver<T>>(std::move(funcReturn).value());
+
+    //every reuseport socket gets a copy of each multicast datagram, filter keeps only origins of this worker
+    auto program = FrameFilter::program(Frame::localOrigin(), this->settings.receiveWorkers, workerIndex);
+    auto filterReturn = receiver->attachFilter(program);
+    if (!filterReturn.isOk()) {
+        if (this->logger != nullptr) {
+            this->logger->error(std::format("Failed attaching filter to {} receiver socket of worker {}: ", family, workerIndex) + filterReturn.message());
+        }
+        return nullptr;
+    }
+    return receiver;
+}
+
+template<typename F>
+void NetworkNeighborDiscoverer::forEachReceiver(F&& visitor) {
+    if (this->ipv6receiver != nullptr) {
+        visitor(*this->ipv6receiver);
+    }
+    if (this->ipv4receiver != nullptr) {
+        visitor(*this->ipv4receiver);
+    }
+    for (auto& worker : this->receiveWorkers) {
+        if (worker->ipv6receiver != nullptr) {
+            visitor(*worker->ipv6receiver);
+        }
+        if (worker->ipv4receiver != nullptr) {
+            visitor(*worker->ipv4receiver);
+        }
+    }
+}
+
+void NetworkNeighborDiscoverer::checkReceiveDrops() {
+    std::uint64_t dropped = 0;
+    this->forEachReceiver([&](const auto& receiver) {
+        dropped += receiver.droppedDatagrams();
+    });
+    if (dropped <= this->prevDroppedDatagrams) {
+        return;
+    }
+    std::uint64_t newDrops = dropped - this->prevDroppedDatagrams;
+    this->prevDroppedDatagrams = dropped;
+
+    int maxBytes = static_cast<int>(this->settings.maxReceiveBufferSize);
+    int grownBytes = 0;
+    this->forEachReceiver([&](auto& receiver) {
+        //kernel reports double of requested size, so requesting reported size doubles the queue
+        auto sizeReturn = receiver.receiveBufferSize();
+        if (!sizeReturn.isOk() || sizeReturn.value() / 2 >= maxBytes) {
+            return;
+        }
+        auto resizeReturn = receiver.setReceiveBufferSize(std::min(sizeReturn.value(), maxBytes));
+        if (resizeReturn.isOk()) {
+            grownBytes = std::max(grownBytes, resizeReturn.value() / 2);
+        } else if (this->logger != nullptr) {
+            this->logger->error("Couldn't grow receive buffer: " + resizeReturn.message());
+        }
+    });
+
+    if (this->logger != nullptr) {
+        this->logger->error(std::format("Kernel dropped {} datagrams on full receive queues", newDrops));
+        if (grownBytes > 0) {
+            this->logger->info(std::format("Grew receive buffers to {}B", grownBytes));
+        }
+    }
+}
+
+void NetworkNeighborDiscoverer::setupSocketBuffers() {
+    //0 keeps kernel defaults
+    if (this->settings.receiveBufferSize > 0) {
+        this->forEachReceiver([&](auto& receiver) {
+            auto funcReturn = receiver.setReceiveBufferSize(static_cast<int>(this->settings.receiveBufferSize));
+            if (!funcReturn.isOk() && this->logger != nullptr) {
+                this->logger->error("Couldn't resize receive buffer: " + funcReturn.message());
+            }
+        });
+    }
+
+    if (this->settings.sendBufferSize > 0) {
+        auto resize = [&](auto* sender) {
+            if (sender == nullptr) {
+                return;
+            }
+            auto funcReturn = sender->setSendBufferSize(static_cast<int>(this->settings.sendBufferSize));
+            if (!funcReturn.isOk() && this->logger != nullptr) {
+                this->logger->error("Couldn't resize send buffer: " + funcReturn.message());
+            }
+        };
+        resize(this->ipv6sender.get());
+        resize(this->ipv4sender.get());
+        resize(this->ipv6summarySender.get());
+        resize(this->ipv4summarySender.get());
+    }
+}
+
+void NetworkNeighborDiscoverer::setupReceiveWorkers() {
+    if (this->settings.receiveWorkers == 0) {
+        return;
+    }
+
+    this->workerEventFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (this->workerEventFd < 0) {
+        if (this->logger != nullptr) {
+            this->logger->error(std::string("Failed creating receive worker eventfd: ") + std::strerror(errno));
+        }
+        return;
+    }
+
+    for (unsigned int i = 0; i < this->settings.receiveWorkers; i++) {
+        auto worker = std::make_unique<ReceiveWorker>();
+        worker->ipv6receiver = this->createWorkerReceiver<::sockaddr_in6>(i);
+        worker->ipv4receiver = this->createWorkerReceiver<::sockaddr_in>(i);
+        this->receiveWorkers.push_back(std::move(worker));
+    }
+}
+
 void NetworkNeighborDiscoverer::setupUnixDomainSockets() {
+    //clients connecting during handoff wait in backlog of handed over socket instead of failing
+    int adoptedFd = this->handoff.has_value() ? this->handoff->take(HandoffRole::UnixListener) : -1;
+    if (adoptedFd >= 0) {
+        auto adoptReturn = UnixSocket::adoptedServerFactory(adoptedFd, this->localSettings.socketPath);
+        if (adoptReturn.isOk()) {
+            this->unixDomainServer = std::make_unique<UnixSocket>(std::move(adoptReturn).value());
+            return;
+        }
+        if (this->logger != nullptr) {
+            this->logger->error("Couldn't take over Unix domain socket, creating new one: " + adoptReturn.message());
+        }
+    }
+
     auto funcReturn = UnixSocket::serverFactory(this->localSettings.socketPath);
 
     if (funcReturn.isOk()) {
         this->unixDomainServer = std::make_unique<UnixSocket>(
-                std::move(funcReturn.data.value())
+                std::move(funcReturn).value()
             );
     } else {
         if (this->logger != nullptr) {
-            this->logger->error("Couldn't open Unix domain socket: " + funcReturn.msg.value());
+            this->logger->error("Couldn't open Unix domain socket: " + funcReturn.message());
         }
         this->unixDomainServer = nullptr;
     }
+}
+
+void NetworkNeighborDiscoverer::setupHandoffSocket() {
+    if (this->settings.handoffSocketPath.empty()) {
+        return;
+    }
+
+    auto funcReturn = UnixSocket::serverFactory(this->settings.handoffSocketPath);
+    if (funcReturn.isOk()) {
+        this->handoffServer = std::make_unique<UnixSocket>(std::move(funcReturn).value());
+    } else {
+        if (this->logger != nullptr) {
+            this->logger->error("Couldn't open handoff socket, restarts won't be seamless: " + funcReturn.message());
+        }
+        this->handoffServer = nullptr;
+    }
 }
\ No newline at end of file
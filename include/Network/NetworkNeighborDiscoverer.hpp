@@ -6,17 +6,41 @@
 #include "Unix/UnixDomainSettings.hpp"
 #include "Unix/UnixSocket.hpp"
 #include "Logging/ILogger.hpp"
+#include "Utility/Result.hpp"
 #include "Logging/LoggableFrom.hpp"
 #include "Containers/IndexedTimedSet.hpp"
 #include "NetInterfaces/NetInterface.hpp"
+#include "NetInterfaces/SubnetTable.hpp"
 #include "Sockets/IPMulticastSender.hpp"
 #include "Sockets/IPMulticastReceiver.hpp"
+#include "Sockets/IoUring.hpp"
+#include "Unix/UnixRequest.hpp"
+#include "Journal/NeighborJournal.hpp"
+#include "Protocol/Frame.hpp"
+#include "Protocol/ShardDigest.hpp"
+#include "Protocol/ProbeMessage.hpp"
+#include "LatencyEstimator.hpp"
+#include "SequenceTracker.hpp"
+#include "NeighborLoss.hpp"
+#include "NeighborQuery.hpp"
+#include "DaemonHandoff.hpp"
+#include "Coroutines/Reactor.hpp"
 
 #include <memory>
 #include <cstdint>
 #include <string>
 #include <type_traits>
 #include <chrono>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <optional>
+#include <random>
+#include <map>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <functional>
 
 using Network::DiscoverySettings;
 using Unix::UnixDomainSettings;
@@ -27,40 +51,338 @@ using Containers::IndexedTimedSet;
 using Network::NetInterfaces::NetInterface;
 using Network::Sockets::IPMulticastReceiver;
 using Network::Sockets::IPMulticastSender;
+using Network::Sockets::IoUring;
+using Unix::UnixRequest;
+using Journal::NeighborJournal;
+using Coroutines::Reactor;
+using Coroutines::Task;
 
 namespace Network {
     class NetworkNeighborDiscoverer : public LoggableFrom { 
     private:
-        const DiscoverySettings settings;
-        const UnixDomainSettings localSettings;
+        //tunables change on reload, fields read by receive worker threads are restart only
+        DiscoverySettings settings;
+        UnixDomainSettings localSettings;
+        //fills passed settings from settings file, empty if daemon runs on compiled settings only
+        std::function<Result<>(DiscoverySettings&, UnixDomainSettings&)> settingsLoader{};
+        //SIGHUP, SIGTERM and SIGINT are blocked and read from signalfd, so reload and stop run on discoverer thread
+        int signalFd = -1;
+        //called once SIGTERM or SIGINT arrives, after journal and snapshot are written
+        std::function<void()> stopHandler{};
 
-        std::chrono::steady_clock::time_point prevSendTime;
+        //last announcement or solicitation, next periodic announcement is due sending period after it
+        std::chrono::steady_clock::time_point prevSendTime{};
 
         IndexedTimedSet<std::string, NetInterface> neighbors{};
         std::vector<NetInterface> prevNifs{};
 
+        //neighbor table persistence
+        bool neighborsChanged = false;
+        std::chrono::steady_clock::time_point prevSnapshotTime{};
+
+        std::unique_ptr<NeighborJournal> journal = nullptr;
+
+        //answer to solicitations of other daemons, one answer covers all solicitations received before it
+        std::optional<std::chrono::steady_clock::time_point> scheduledResponseTime{};
+        std::chrono::steady_clock::time_point prevResponseTime{};
+        std::mt19937 random{std::random_device{}()};
+
+        //multicast sharding, group index equal to shard count is the summary group
+        std::vector<unsigned int> subscribedShards{0};
+        std::vector<unsigned int> receivedGroups{0};
+        struct RemoteShardDigest {
+            Protocol::ShardDigest digest{};
+            std::chrono::steady_clock::time_point lastSeen{};
+        };
+        std::map<unsigned int, RemoteShardDigest> remoteShardDigests{};
+        //interfaces announced into shards with fingerprints of their announcement before subnet filtering
+        //digests are computed over them, so daemons with different local subnets agree on digests of the same shard
+        struct ShardMember {
+            std::uint64_t fingerprint{};
+            std::chrono::steady_clock::time_point lastSeen{};
+        };
+        std::unordered_map<std::string, ShardMember> shardMembers{};
+
+        //last payload seen from a sender address and MACs it contributed to neighbors after subnet filtering
+        struct SenderFingerprint {
+            std::uint64_t hash{};
+            std::size_t size{};
+            std::vector<std::string> macs{};
+            std::chrono::steady_clock::time_point lastSeen{};
+            std::uint8_t capabilities{};
+            //every MAC of the payload, subnet filtering doesn't affect shard membership
+            std::vector<std::string> announcedMacs{};
+        };
+        std::unordered_map<std::string, SenderFingerprint> senderFingerprints{};
+
+        //network interfaces received during one iteration, with payload fingerprints of senders that need to be cached
+        struct ReceivedBatch {
+            std::unordered_map<std::string, NetInterface> nifs{};
+            std::unordered_map<std::string, std::string> nifSenders{};
+            //index of local interface announcement arrived on, 0 if unknown
+            std::unordered_map<std::string, unsigned int> nifIfindexes{};
+            //kernel arrival time of announcement, converted to steady clock
+            std::unordered_map<std::string, std::chrono::steady_clock::time_point> nifArrivals{};
+            std::unordered_map<std::string, SenderFingerprint> fingerprints{};
+            //sender of unchanged payload with arrival time of latest one
+            std::unordered_map<std::string, std::chrono::steady_clock::time_point> unchangedSenders{};
+            std::vector<std::string> solicitingMacs{};
+            std::vector<Protocol::ShardDigest> summaries{};
+            //probes of other daemons to answer, with sender they came from
+            std::vector<std::pair<std::string, Protocol::ProbeMessage>> probes{};
+            //replies to own probes with sender they came from and their arrival time
+            struct ProbeReply {
+                std::string sender{};
+                Protocol::ProbeMessage probe{};
+                std::chrono::steady_clock::time_point arrival{};
+            };
+            std::vector<ProbeReply> probeReplies{};
+            //every received copy of sequenced frames in arrival order, unchanged payloads and duplicates included
+            struct SequencedFrame {
+                std::string sender{};
+                std::uint64_t origin{};
+                std::uint32_t sequence{};
+                std::chrono::steady_clock::time_point arrival{};
+            };
+            std::vector<SequencedFrame> sequences{};
+
+            bool empty() const;
+            //entries of other batch replace entries of this one, other batch is expected to be newer
+            void merge(ReceivedBatch&& other);
+        };
+
+        //receive worker owns reuseport sockets of one origin shard and a private payload fingerprint cache
+        struct ReceiveWorker {
+            std::unique_ptr<IPMulticastReceiver<::sockaddr_in6>> ipv6receiver = nullptr;
+            std::unique_ptr<IPMulticastReceiver<::sockaddr_in>> ipv4receiver = nullptr;
+            std::unordered_map<std::string, SenderFingerprint> fingerprints{};
+            unsigned int fingerprintsGeneration = 0;
+            std::thread thread{};
+        };
+        std::vector<std::unique_ptr<ReceiveWorker>> receiveWorkers{};
+        //threads and io_uring requests belong to process that started them, so both are started on first iteration after daemonizing
+        bool ioStarted = false;
+        std::atomic<bool> stopReceiveWorkers = false;
+        //decoded batches waiting to be merged by discoverer thread, eventfd wakes it up
+        std::mutex workerBatchesMutex{};
+        std::vector<ReceivedBatch> workerBatches{};
+        int workerEventFd = -1;
+        //incremented when cached payloads become invalid, workers clear their caches when it changes
+        std::atomic<unsigned int> fingerprintsGeneration = 0;
+        //copy of neighbor activity period for workers, it can change on reload
+        std::atomic<unsigned int> workerActivityPeriodS = 0;
+
         std::unique_ptr<IPMulticastSender<::sockaddr_in6>> ipv6sender = nullptr;
         std::unique_ptr<IPMulticastSender<::sockaddr_in>> ipv4sender = nullptr;
+        //used only with sharding enabled
+        std::unique_ptr<IPMulticastSender<::sockaddr_in6>> ipv6summarySender = nullptr;
+        std::unique_ptr<IPMulticastSender<::sockaddr_in>> ipv4summarySender = nullptr;
 
         std::unique_ptr<IPMulticastReceiver<::sockaddr_in6>> ipv6receiver = nullptr;
         std::unique_ptr<IPMulticastReceiver<::sockaddr_in>> ipv4receiver = nullptr;
 
         std::unique_ptr<UnixSocket> unixDomainServer = nullptr;
 
+        //sockets and neighbor table handed over by daemon this one replaces, released once constructor took what it needs
+        std::optional<HandoffState> handoff{};
+        //replacing daemon asks for handoff here, null if handoff is disabled
+        std::unique_ptr<UnixSocket> handoffServer = nullptr;
+
+        //sum of kernel drop counters of all receivers at last check
+        std::uint64_t prevDroppedDatagrams = 0;
+
+        //null if disabled or unsupported by kernel, poll() readiness loop is used then
+        std::unique_ptr<IoUring> ioUring = nullptr;
+        //identifies multishot request a completion belongs to
+        enum IoUringTarget : std::uint32_t {
+            IPv6ReceiverTarget,
+            IPv4ReceiverTarget,
+            CliServerTarget
+        };
+
+        //echo probing, neighbors are probed at sender address of their latest decoded announcement
+        struct ProbedNeighbor {
+            std::string address{};
+            LatencyEstimator estimator{};
+            std::chrono::steady_clock::time_point nextProbe{};
+        };
+        std::unordered_map<std::string, ProbedNeighbor> probedNeighbors{};
+        //announcement sequence statistics per sender address
+        std::unordered_map<std::string, SequenceTracker> senderSequences{};
+        //sequence of next sent announcement, 0 is left for unsequenced frames
+        std::uint32_t nextAnnouncementSequence = 1;
+        //addresses of all neighbors as columns tagged with position of their MAC, rebuilt once neighbors change, for cidr queries
+        NetInterfaces::AddressColumns neighborAddresses{};
+        std::vector<std::string> neighborAddressMacs{};
+        std::optional<std::uint64_t> neighborAddressesGeneration{};
+        //probe waiting for reply, counted as lost once deadline passes
+        //round trip is measured from send time kept here, only reply from probed address is accepted
+        struct OutstandingProbe {
+            std::string mac{};
+            std::string address{};
+            std::chrono::steady_clock::time_point sent{};
+            std::chrono::steady_clock::time_point deadline{};
+        };
+        std::unordered_map<std::uint64_t, OutstandingProbe> outstandingProbes{};
+        //starts at random value, so hosts off path can't guess sequences of outstanding probes
+        std::uint64_t nextProbeSequence = (std::uint64_t{this->random()} << 32) | this->random();
+        //token bucket limiting answers to probes of other daemons
+        double probeReplyTokens = 0.0;
+        std::chrono::steady_clock::time_point prevProbeReplyRefill{};
+
+        //runs receiving, CLI sessions and periodic work between announcements, declared last so its tasks go first
+        Reactor reactor{};
+        //at most one task sends delayed answers to solicitations
+        bool responseTaskRunning = false;
+
+        void sendAnnouncement(const std::vector<NetInterface>& nifs, Protocol::Frame::MessageType type);
+        //sends digests of subscribed shards on summary group
+        void sendShardSummary();
+        std::vector<Protocol::ShardDigest> localShardDigests() const;
+        void handleSummary(const std::string& sender, std::vector<std::uint8_t>& rbuff, ReceivedBatch& batch);
+        void handleProbe(const std::string& sender, std::chrono::steady_clock::time_point arrival, std::vector<std::uint8_t>& rbuff, ReceivedBatch& batch);
+        //echoes received probes within reply budget and resolves replies to own probes
+        void applyProbes(ReceivedBatch& batch);
+        //probes neighbor that waited longest once its period passed
+        void sendProbe();
+        void expireProbes();
+        //sends to scoped address of a sender on discovery port
+        Result<> sendUnicast(const std::string& scopedAddress, const std::vector<std::uint8_t>& frame);
+        std::optional<std::chrono::microseconds> smoothedRtt(const std::string& mac) const;
+        LossReport lossReport();
+        //MACs of neighbors with an address inside subnet of query, nullopt if query has no subnet
+        std::optional<std::unordered_set<std::string>> subnetCandidates(const NeighborQuery& query);
+        //joins or leaves subscribed shard groups and summary group, announcements go to shard of interface MAC
+        template<typename T>
+        void updateMembership(const NetInterface& nif, bool enable, const std::string& baseGroup,
+            IPMulticastReceiver<T>* receiver, IPMulticastSender<T>* sender, IPMulticastSender<T>* summarySender);
+        //updates membership of own and receive worker sockets for both IP versions
+        void updateMemberships(const NetInterface& nif, bool enable);
+        //base group advanced by index, falls back to base group if it can't be
+        std::string shardGroup(const std::string& baseGroup, unsigned int index) const;
+        void mergeWorkerBatches(ReceivedBatch& batch);
+        //reads at most one datagram from every passed receiver, returns amount of bytes received
+        //thread safe as long as fingerprints are owned by calling thread
+        int receiveDatagrams(IPMulticastReceiver<::sockaddr_in6>* ipv6receiver, IPMulticastReceiver<::sockaddr_in>* ipv4receiver,
+            std::unordered_map<std::string, SenderFingerprint>& fingerprints, ReceivedBatch& batch);
+        //filters received network interfaces by local subnets and updates neighbors
+        void applyBatch(ReceivedBatch& batch, const std::vector<NetInterface>& nifs);
+        //answer is sent by response task once scheduled time comes
+        void scheduleResponse();
+        void expireNeighbors();
+
+        //skips deserialization if payload is byte identical to previous one from the same sender
+        //sender is address scoped by arrival interface, same address on different links is a different sender
+        void handleDatagram(const std::string& sender, unsigned int ifindex, std::chrono::steady_clock::time_point arrival, std::vector<std::uint8_t>& rbuff, std::size_t size,
+            std::unordered_map<std::string, SenderFingerprint>& fingerprints, ReceivedBatch& batch);
+
+        //threads are started on first iteration, after process got daemonized
+        void startReceiveWorkers();
+        void runReceiveWorker(ReceiveWorker& worker);
+        template<typename T>
+        std::unique_ptr<IPMulticastReceiver<T>> createWorkerReceiver(unsigned int workerIndex);
+        //own and receive worker receivers of both IP versions
+        template<typename F>
+        void forEachReceiver(F&& visitor);
+        //logs datagrams kernel dropped since last check and grows receive queues up to limit
+        void checkReceiveDrops();
+        void startIoUring();
+        //falls back to poll() loop, requests in flight are cancelled
+        void disableIoUring(const std::string& reason);
+        Result<> armIoUring(IoUringTarget target);
+        //hands queued sends and rearmed requests to kernel, errors are only logged
+        void submitIoUring();
+        //decodes received datagrams, starts sessions of accepted clients and rearms finished multishot requests
+        void handleCompletions(const std::vector<IoUring::Completion>& ready, ReceivedBatch& batch);
+        //queued on io_uring if enabled, sent right away otherwise
+        template<typename T>
+        void sendFrame(IPMulticastSender<T>* sender, const std::shared_ptr<const std::vector<std::uint8_t>>& frame);
+
+        //compression is used only if senders are known and every one of them is able to decompress
+        bool peersSupport(std::uint8_t capabilities) const;
+
+        //every request gets response frame, error frame if it can't be served, so pipelined responses stay in order
+        std::vector<std::uint8_t> answerCliRequest(const std::string& text);
+        //serves neighbor list or journal events depending on request command
+        std::vector<std::uint8_t> respondToCli(const UnixRequest& request);
+        std::vector<std::uint8_t> sealCliResponse(std::vector<std::uint8_t>& buff, const UnixRequest& request);
+        //logs message and wraps it into error frame
+        std::vector<std::uint8_t> cliError(const std::string& message);
+
+        //applies tunables of reloaded settings file, returns keys whose changes need restart
+        Result<std::vector<std::string>> reloadSettings();
+        void setupSignals();
+
+        //spawned on first iteration, io_uring completions replace socket readiness tasks while ring is enabled
+        void startTasks();
+        void startReadinessTasks();
+        //drains one receiver per wake up in bounded batches
+        Task receiveTask(IPMulticastReceiver<::sockaddr_in6>* ipv6receiver, IPMulticastReceiver<::sockaddr_in>* ipv4receiver, int fd);
+        Task workerBatchesTask();
+        Task completionsTask();
+        Task acceptTask();
+        //one per connected client, serves its requests until it disconnects or stays idle, slow client doesn't hold up others
+        Task cliSession(UnixSocket clientSocket);
+        //expires neighbors, flushes journal and saves snapshot
+        Task maintenanceTask();
+        //announces own interfaces every sending period, independent of iteration period
+        Task announcementTask();
+        Task responseTask();
+        //reloads settings on SIGHUP, stops daemon on SIGTERM and SIGINT
+        Task signalTask();
+        //sends at most probe budget per second, idles while probing is disabled
+        Task probeTask();
+        //serves handoff requests of replacing daemon, stops this one once sockets are handed over
+        Task handoffTask();
+        //returns false if daemon keeps running because request didn't match its settings or handoff failed
+        bool handOver(UnixSocket& client, const std::string& request);
+
     public:
-        NetworkNeighborDiscoverer(std::shared_ptr<ILogger> logger, const DiscoverySettings& settings, const UnixDomainSettings& localSettings)
-            : LoggableFrom{logger}, settings{settings}, localSettings{localSettings}
+        //sockets and neighbor table of handoff are taken over instead of being created and restored from snapshot
+        NetworkNeighborDiscoverer(std::shared_ptr<ILogger> logger, const DiscoverySettings& settings, const UnixDomainSettings& localSettings,
+            std::optional<HandoffState> handoff = std::nullopt)
+            : LoggableFrom{logger}, settings{settings}, localSettings{localSettings}, workerActivityPeriodS{settings.neighborActivityPeriodS},
+            handoff{std::move(handoff)}
         {
+            setupShards();
             setupIPv4Sockets();
             setupIPv6Sockets();
+            setupReceiveWorkers();
+            setupSocketBuffers();
             setupUnixDomainSockets();
+            setupJournal();
+            restoreSnapshot();
+            //descriptors nothing took are closed
+            this->handoff.reset();
+            setupHandoffSocket();
         }
 
+        ~NetworkNeighborDiscoverer();
+
         void runIteration();
+        void setSettingsLoader(const std::function<Result<>(DiscoverySettings&, UnixDomainSettings&)>& settingsLoader) {
+            this->settingsLoader = settingsLoader;
+        }
+        void setStopHandler(const std::function<void()>& stopHandler) {
+            this->stopHandler = stopHandler;
+        }
+        //runs reactor tasks until passed amount of seconds passes or stop signal arrives
+        void waitForEvents(unsigned int seconds);
 
+        void setupShards();
+        void setupHandoffSocket();
         void setupIPv4Sockets();
         void setupIPv6Sockets();
         void setupUnixDomainSockets();
+        void setupReceiveWorkers();
+        //applies configured queue sizes to all multicast sockets, also on reload
+        void setupSocketBuffers();
+
+        void setupJournal();
+
+        void restoreSnapshot();
+        //writes snapshot if neighbor table changed or snapshot period passed
+        void saveSnapshot();
     };
 
 }
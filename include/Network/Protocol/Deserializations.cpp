@@ -0,0 +1,55 @@
+#include "ShardDigest.hpp"
+#include "ProbeMessage.hpp"
+#include "Utility/Serialization/Deserializer.hpp"
+#include "Utility/Result.hpp"
+
+#include <vector>
+#include <span>
+#include <cstdint>
+
+using Network::Protocol::ShardDigest;
+using Network::Protocol::ProbeMessage;
+using Utility::Serialization::Deserializer;
+using Utility::Result;
+
+Result<ShardDigest> ShardDigest::deserializeImpl(std::span<const std::uint8_t> buff, std::size_t& offset) {
+    ShardDigest shardDigest;
+
+    auto funcReturn = Deserializer::deserialize<std::uint32_t>(buff, offset);
+    if (!funcReturn.isOk()) {
+        return funcReturn.within("Couldn't deserialize shard index");
+    }
+    shardDigest.shard = funcReturn.value();
+
+    auto funcReturn1 = Deserializer::deserialize<std::uint32_t>(buff, offset);
+    if (!funcReturn1.isOk()) {
+        return funcReturn1.within("Couldn't deserialize shard member count");
+    }
+    shardDigest.members = funcReturn1.value();
+
+    auto funcReturn2 = Deserializer::deserialize<std::uint64_t>(buff, offset);
+    if (!funcReturn2.isOk()) {
+        return funcReturn2.within("Couldn't deserialize shard digest");
+    }
+    shardDigest.digest = funcReturn2.value();
+
+    return Result<ShardDigest>{std::move(shardDigest)};
+}
+
+Result<ProbeMessage> ProbeMessage::deserializeImpl(std::span<const std::uint8_t> buff, std::size_t& offset) {
+    ProbeMessage probe;
+
+    auto funcReturn = Deserializer::deserialize<std::uint64_t>(buff, offset);
+    if (!funcReturn.isOk()) {
+        return funcReturn.within("Couldn't deserialize probe sequence");
+    }
+    probe.sequence = funcReturn.value();
+
+    auto funcReturn1 = Deserializer::deserialize<std::int64_t>(buff, offset);
+    if (!funcReturn1.isOk()) {
+        return funcReturn1.within("Couldn't deserialize probe timestamp");
+    }
+    probe.sentNs = funcReturn1.value();
+
+    return Result<ProbeMessage>{std::move(probe)};
+}
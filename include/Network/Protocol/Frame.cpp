@@ -0,0 +1,219 @@
+#include "Frame.hpp"
+
+#include "Utility/Result.hpp"
+#include "Utility/Hashing/Crc32c.hpp"
+#include "Utility/Compression/LzCompressor.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <random>
+#include <algorithm>
+
+using Network::Protocol::Frame;
+using Network::Protocol::FrameInfo;
+using Utility::Result;
+using Utility::ErrorCode;
+using Utility::Hashing::Crc32c;
+using Utility::Compression::LzCompressor;
+
+namespace {
+    constexpr std::size_t FLAGS_OFFSET = 5u;
+    constexpr std::size_t CAPABILITIES_OFFSET = 6u;
+    constexpr std::size_t SIZE_OFFSET = 8u;
+    constexpr std::size_t ORIGINAL_SIZE_SIZE = 4u;
+
+    //replaces payload of frame with compressed one, returns false if it wouldn't get smaller
+    bool compressPayload(std::vector<std::uint8_t>& buff) {
+        std::size_t payloadSize = buff.size() - Frame::HEADER_SIZE;
+
+        std::vector<std::uint8_t> compressed;
+        compressed.reserve(Frame::HEADER_SIZE + ORIGINAL_SIZE_SIZE + LzCompressor::maxCompressedSize(payloadSize) + Frame::TRAILER_SIZE);
+        compressed.resize(Frame::HEADER_SIZE + ORIGINAL_SIZE_SIZE);
+        std::uint32_t originalSize = static_cast<std::uint32_t>(payloadSize);
+        std::memcpy(compressed.data() + Frame::HEADER_SIZE, &originalSize, sizeof(originalSize));
+        LzCompressor::compress(buff.data() + Frame::HEADER_SIZE, payloadSize, compressed);
+
+        if (compressed.size() >= buff.size()) {
+            return false;
+        }
+        buff = std::move(compressed);
+        return true;
+    }
+}
+
+std::uint64_t Frame::localOrigin() {
+    static const std::uint64_t origin = [] {
+        std::random_device device;
+        std::uint64_t generated = (static_cast<std::uint64_t>(device()) << 32) | device();
+        //zero is left for frames that don't carry origin
+        return generated != 0 ? generated : 1u;
+    }();
+    return origin;
+}
+
+void Frame::reserveHeader(std::vector<std::uint8_t>& buff) {
+    buff.resize(buff.size() + HEADER_SIZE);
+}
+
+void Frame::seal(std::vector<std::uint8_t>& buff, bool checksum, std::size_t compressionThreshold, MessageType type, std::uint32_t sequence) {
+    std::uint8_t flags = checksum ? Flags::Checksum : Flags::None;
+    if (compressionThreshold > 0 && buff.size() - HEADER_SIZE > compressionThreshold && compressPayload(buff)) {
+        flags |= Flags::Compressed;
+    }
+
+    std::uint32_t magic = MAGIC;
+    std::uint32_t payloadSize = static_cast<std::uint32_t>(buff.size() - HEADER_SIZE);
+
+    std::memcpy(buff.data(), &magic, sizeof(magic));
+    buff[VERSION_OFFSET] = VERSION;
+    buff[FLAGS_OFFSET] = flags;
+    buff[CAPABILITIES_OFFSET] = LOCAL_CAPABILITIES;
+    buff[TYPE_OFFSET] = type;
+    std::memcpy(buff.data() + SIZE_OFFSET, &payloadSize, sizeof(payloadSize));
+    std::uint64_t origin = localOrigin();
+    std::memcpy(buff.data() + ORIGIN_OFFSET, &origin, sizeof(origin));
+    std::memcpy(buff.data() + SEQUENCE_OFFSET, &sequence, sizeof(sequence));
+
+    if (checksum) {
+        std::uint32_t crc = Crc32c::compute(buff.data(), buff.size());
+        const std::uint8_t* pointer = reinterpret_cast<const std::uint8_t*>(&crc);
+        buff.insert(buff.end(), pointer, pointer + sizeof(crc));
+    }
+}
+
+std::optional<std::size_t> Frame::size(const std::vector<std::uint8_t>& buff) {
+    if (buff.size() < HEADER_SIZE) {
+        return std::nullopt;
+    }
+
+    std::uint32_t payloadSize = 0;
+    std::memcpy(&payloadSize, buff.data() + SIZE_OFFSET, sizeof(payloadSize));
+    bool hasChecksum = (buff[FLAGS_OFFSET] & Flags::Checksum) != 0;
+    return HEADER_SIZE + payloadSize + (hasChecksum ? TRAILER_SIZE : 0u);
+}
+
+Frame::MessageType Frame::messageType(const std::vector<std::uint8_t>& buff) {
+    std::uint32_t magic = 0;
+    if (buff.size() < HEADER_SIZE) {
+        return MessageType::Announcement;
+    }
+    std::memcpy(&magic, buff.data(), sizeof(magic));
+    if (magic != MAGIC) {
+        return MessageType::Announcement;
+    }
+    return static_cast<MessageType>(buff[TYPE_OFFSET]);
+}
+
+std::optional<FrameInfo> Frame::peekHeader(const std::vector<std::uint8_t>& buff) {
+    std::uint32_t magic = 0;
+    if (buff.size() < HEADER_SIZE) {
+        return std::nullopt;
+    }
+    std::memcpy(&magic, buff.data(), sizeof(magic));
+    if (magic != MAGIC) {
+        return std::nullopt;
+    }
+
+    FrameInfo info{HEADER_SIZE, buff[FLAGS_OFFSET], buff[CAPABILITIES_OFFSET], buff[TYPE_OFFSET], 0u, 0u};
+    std::memcpy(&info.origin, buff.data() + ORIGIN_OFFSET, sizeof(info.origin));
+    std::memcpy(&info.sequence, buff.data() + SEQUENCE_OFFSET, sizeof(info.sequence));
+    return info;
+}
+
+std::span<const std::uint8_t> Frame::rawPayload(const std::vector<std::uint8_t>& buff) {
+    auto info = peekHeader(buff);
+    if (!info.has_value()) {
+        return std::span<const std::uint8_t>(buff);
+    }
+    std::size_t end = buff.size();
+    if ((info->flags & Flags::Checksum) != 0 && end >= HEADER_SIZE + TRAILER_SIZE) {
+        end -= TRAILER_SIZE;
+    }
+    return std::span<const std::uint8_t>(buff.data() + HEADER_SIZE, end - HEADER_SIZE);
+}
+
+Result<FrameInfo> Frame::verify(const std::vector<std::uint8_t>& buff, bool requireChecksum) {
+    std::uint32_t magic = 0;
+    if (buff.size() >= sizeof(magic)) {
+        std::memcpy(&magic, buff.data(), sizeof(magic));
+    }
+
+    if (magic != MAGIC) {
+        if (requireChecksum) {
+            return Utility::Error{ErrorCode::Failed, "Frame rejected, missing frame header"};
+        }
+        return Result<FrameInfo>{FrameInfo{}};
+    }
+
+    if (buff.size() < HEADER_SIZE) {
+        return Utility::Error{ErrorCode::Overflow, "Frame rejected, truncated header"};
+    }
+    if (buff[VERSION_OFFSET] != VERSION) {
+        return Utility::Error{ErrorCode::Unsupported, "Frame rejected, unsupported version", buff[VERSION_OFFSET]};
+    }
+
+    FrameInfo info{HEADER_SIZE, buff[FLAGS_OFFSET], buff[CAPABILITIES_OFFSET], buff[TYPE_OFFSET], 0u, 0u};
+    std::memcpy(&info.origin, buff.data() + ORIGIN_OFFSET, sizeof(info.origin));
+    std::memcpy(&info.sequence, buff.data() + SEQUENCE_OFFSET, sizeof(info.sequence));
+    bool hasChecksum = (info.flags & Flags::Checksum) != 0;
+    if (requireChecksum && !hasChecksum) {
+        return Utility::Error{ErrorCode::Failed, "Frame rejected, missing checksum"};
+    }
+
+    std::uint32_t payloadSize = 0;
+    std::memcpy(&payloadSize, buff.data() + SIZE_OFFSET, sizeof(payloadSize));
+    std::size_t expectedSize = HEADER_SIZE + payloadSize + (hasChecksum ? TRAILER_SIZE : 0u);
+    if (buff.size() != expectedSize) {
+        return Utility::Error{ErrorCode::Failed, "Frame rejected, size mismatch"};
+    }
+
+    if (hasChecksum) {
+        std::size_t covered = buff.size() - TRAILER_SIZE;
+        std::uint32_t expected = 0;
+        std::memcpy(&expected, buff.data() + covered, sizeof(expected));
+        if (Crc32c::compute(buff.data(), covered) != expected) {
+            return Utility::Error{ErrorCode::Failed, "Frame rejected, checksum mismatch"};
+        }
+    }
+
+    return Result<FrameInfo>{info};
+}
+
+Result<FrameInfo> Frame::open(std::vector<std::uint8_t>& buff, bool requireChecksum, std::size_t maxPayloadSize) {
+    auto verifyReturn = verify(buff, requireChecksum);
+    if (!verifyReturn.isOk()) {
+        return verifyReturn;
+    }
+    FrameInfo info = verifyReturn.value();
+    //unframed payload
+    if (info.offset == 0) {
+        return verifyReturn;
+    }
+
+    std::uint32_t payloadSize = 0;
+    std::memcpy(&payloadSize, buff.data() + SIZE_OFFSET, sizeof(payloadSize));
+    if ((info.flags & Flags::Checksum) != 0) {
+        buff.resize(buff.size() - TRAILER_SIZE);
+    }
+
+    if (info.flags & Flags::Compressed) {
+        if (payloadSize < ORIGINAL_SIZE_SIZE) {
+            return Utility::Error{ErrorCode::Overflow, "Frame rejected, truncated compressed payload"};
+        }
+        std::uint32_t originalSize = 0;
+        std::memcpy(&originalSize, buff.data() + HEADER_SIZE, sizeof(originalSize));
+        if (originalSize > std::min(maxPayloadSize, MAX_PAYLOAD_SIZE)) {
+            return Utility::Error{ErrorCode::Failed, "Frame rejected, decompressed payload too large"};
+        }
+
+        std::vector<std::uint8_t> decompressed(buff.begin(), buff.begin() + HEADER_SIZE);
+        auto lzReturn = LzCompressor::decompress(buff.data() + HEADER_SIZE + ORIGINAL_SIZE_SIZE, payloadSize - ORIGINAL_SIZE_SIZE, originalSize, decompressed);
+        if (!lzReturn.isOk()) {
+            return lzReturn.within("Frame rejected");
+        }
+        buff = std::move(decompressed);
+    }
+
+    return Result<FrameInfo>{info};
+}
@@ -0,0 +1,106 @@
+#pragma once
+#ifndef FRAME_HPP
+#define FRAME_HPP
+
+#include "Utility/Result.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <optional>
+#include <span>
+
+using Utility::Result;
+
+namespace Network::Protocol {
+    //result of opening a received frame
+    struct FrameInfo {
+        std::size_t offset{};
+        std::uint8_t flags{};
+        std::uint8_t capabilities{};
+        std::uint8_t type{};
+        std::uint64_t origin{};
+        std::uint32_t sequence{};
+    };
+
+    //frame wraps serialized payloads sent over multicast and UNIX domain sockets
+    //layout: magic (4B), version (1B), flags (1B), capabilities (1B), message type (1B), payload size (4B), origin (8B), sequence (4B), payload, optional CRC32C trailer (4B)
+    //origin is random ID of producing process, lets receivers drop their own looped back frames
+    //origin also acts as boot epoch of sequence, which counts announcements of that process starting at 1, 0 marks unsequenced frames
+    //trailer covers header and payload, so corrupted or foreign data is rejected before deserialization
+    //compressed payload starts with its original size (4B) followed by LZ block
+    class Frame {
+    public:
+        static constexpr std::uint32_t MAGIC = 0x3146444Eu; //"NDF1" in memory on little endian hosts
+        static constexpr std::uint8_t VERSION = 3u;
+        static constexpr std::size_t HEADER_SIZE = 24u;
+        //fixed offsets, also used by kernel socket filter
+        static constexpr std::size_t VERSION_OFFSET = 4u;
+        static constexpr std::size_t TYPE_OFFSET = 7u;
+        static constexpr std::size_t ORIGIN_OFFSET = 12u;
+        static constexpr std::size_t SEQUENCE_OFFSET = 20u;
+        static constexpr std::size_t TRAILER_SIZE = 4u;
+        //upper bound of decompressed payload, protects against decompression bombs
+        static constexpr std::size_t MAX_PAYLOAD_SIZE = 16u * 1024u * 1024u;
+
+        enum Flags : std::uint8_t {
+            None = 0u,
+            Checksum = 1u << 0,
+            Compressed = 1u << 1
+        };
+
+        //features producer of the frame is able to decode, used to negotiate them with peers
+        enum Capabilities : std::uint8_t {
+            NoCapabilities = 0u,
+            Lz = 1u << 0
+        };
+
+        //solicitation carries the same payload as announcement, but asks receivers to answer with their own announcement
+        //summary carries shard digests instead of network interfaces
+        //error carries message string, UNIX domain clients get it instead of response to request that failed
+        //probe is unicast echo request carrying ProbeMessage, receiver sends it back unchanged as probe reply
+        //handoff carries HandoffMessage from running daemon to its replacement over handoff socket, never multicast
+        enum MessageType : std::uint8_t {
+            Announcement = 0u,
+            Solicitation = 1u,
+            Summary = 2u,
+            Error = 3u,
+            Probe = 4u,
+            ProbeReply = 5u,
+            Handoff = 6u
+        };
+
+        //capabilities of this build
+        static constexpr std::uint8_t LOCAL_CAPABILITIES = Capabilities::Lz;
+
+        //origin ID written into frames sealed by this process, generated once per process
+        static std::uint64_t localOrigin();
+
+        //appends placeholder header, payload is serialized right after it
+        static void reserveHeader(std::vector<std::uint8_t>& buff);
+        //fills header of frame started with reserveHeader and appends checksum trailer if requested
+        //payload is compressed if it's larger than compressionThreshold (0 disables compression) and compression pays off
+        static void seal(std::vector<std::uint8_t>& buff, bool checksum, std::size_t compressionThreshold = 0, MessageType type = MessageType::Announcement, std::uint32_t sequence = 0);
+
+        //validates header, size and checksum trailer without touching buff, cheap enough to run on every datagram
+        //buffers without frame magic are treated as unframed payloads (offset 0) unless checksum is required
+        static Result<FrameInfo> verify(const std::vector<std::uint8_t>& buff, bool requireChecksum = false);
+        //verifies frame, strips trailer, decompresses payload and returns its offset
+        //buffers without frame magic are treated as unframed payloads (offset 0) unless checksum is required
+        //compressed payloads claiming more than maxPayloadSize decompressed bytes are rejected before anything is allocated
+        static Result<FrameInfo> open(std::vector<std::uint8_t>& buff, bool requireChecksum = false, std::size_t maxPayloadSize = MAX_PAYLOAD_SIZE);
+
+        //total length of frame at start of buff (header, payload and trailer), empty until whole header is available
+        //lets stream readers know when complete frame has arrived
+        static std::optional<std::size_t> size(const std::vector<std::uint8_t>& buff);
+        //message type from unvalidated header, unframed payloads are announcements
+        static MessageType messageType(const std::vector<std::uint8_t>& buff);
+        //fields of unvalidated header, empty for unframed payloads
+        static std::optional<FrameInfo> peekHeader(const std::vector<std::uint8_t>& buff);
+        //payload bytes of unvalidated frame without header and trailer, whole buffer for unframed payloads
+        //unlike whole frame they stay the same when the same content is sent again with next sequence
+        static std::span<const std::uint8_t> rawPayload(const std::vector<std::uint8_t>& buff);
+    };
+}
+
+#endif
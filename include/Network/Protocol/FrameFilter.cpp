@@ -0,0 +1,62 @@
+#include "FrameFilter.hpp"
+#include "Frame.hpp"
+
+#include <linux/filter.h>
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+using Network::Protocol::FrameFilter;
+using Network::Protocol::Frame;
+
+namespace {
+    //BPF loads words in network byte order, frame fields are stored in host order
+    std::uint32_t loadedWord(const void* bytes) {
+        const std::uint8_t* p = static_cast<const std::uint8_t*>(bytes);
+        return (static_cast<std::uint32_t>(p[0]) << 24) | (static_cast<std::uint32_t>(p[1]) << 16)
+            | (static_cast<std::uint32_t>(p[2]) << 8) | static_cast<std::uint32_t>(p[3]);
+    }
+
+    //jump offsets count instructions following the jump
+    std::uint8_t offset(std::size_t from, std::size_t to) {
+        return static_cast<std::uint8_t>(to - from - 1);
+    }
+}
+
+std::vector<::sock_filter> FrameFilter::program(std::uint64_t ownOrigin, std::uint32_t shardCount, std::uint32_t shardIndex) {
+    std::uint32_t magic = Frame::MAGIC;
+    std::uint8_t origin[sizeof(ownOrigin)];
+    std::memcpy(origin, &ownOrigin, sizeof(ownOrigin));
+
+    constexpr std::uint32_t payload = UDP_HEADER_SIZE;
+    bool sharded = shardCount > 1;
+    std::size_t foreign = 10;
+    std::size_t accept = sharded ? 15 : 10;
+    std::size_t drop = accept + 1;
+
+    std::vector<::sock_filter> program{
+        /*0*/ BPF_STMT(BPF_LD | BPF_W | BPF_LEN, 0),
+        /*1*/ BPF_JUMP(BPF_JMP | BPF_JGE | BPF_K, payload + Frame::HEADER_SIZE, 0, offset(1, drop)),
+        /*2*/ BPF_STMT(BPF_LD | BPF_W | BPF_ABS, payload),
+        /*3*/ BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, loadedWord(&magic), 0, offset(3, drop)),
+        /*4*/ BPF_STMT(BPF_LD | BPF_B | BPF_ABS, payload + Frame::VERSION_OFFSET),
+        /*5*/ BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, Frame::VERSION, 0, offset(5, drop)),
+        /*6*/ BPF_STMT(BPF_LD | BPF_W | BPF_ABS, payload + Frame::ORIGIN_OFFSET),
+        /*7*/ BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, loadedWord(origin), 0, offset(7, foreign)),
+        /*8*/ BPF_STMT(BPF_LD | BPF_W | BPF_ABS, payload + Frame::ORIGIN_OFFSET + 4u),
+        /*9*/ BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, loadedWord(origin + 4), offset(9, drop), 0)
+    };
+
+    if (sharded) {
+        program.push_back(/*10*/ BPF_STMT(BPF_LD | BPF_B | BPF_ABS, payload + Frame::TYPE_OFFSET));
+        program.push_back(/*11*/ BPF_JUMP(BPF_JMP | BPF_JGE | BPF_K, Frame::MessageType::Probe, offset(11, accept), 0));
+        program.push_back(/*12*/ BPF_STMT(BPF_LD | BPF_W | BPF_ABS, payload + Frame::ORIGIN_OFFSET + 4u));
+        program.push_back(/*13*/ BPF_STMT(BPF_ALU | BPF_MOD | BPF_K, shardCount));
+        program.push_back(/*14*/ BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, shardIndex, 0, offset(14, drop)));
+    }
+
+    program.push_back(BPF_STMT(BPF_RET | BPF_K, 0xFFFFFFFFu));
+    program.push_back(BPF_STMT(BPF_RET | BPF_K, 0u));
+    return program;
+}
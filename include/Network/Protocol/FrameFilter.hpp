@@ -0,0 +1,24 @@
+#pragma once
+#ifndef FRAMEFILTER_HPP
+#define FRAMEFILTER_HPP
+
+#include <linux/filter.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace Network::Protocol {
+    //classic BPF program for UDP receiver sockets, kernel runs it before datagram is queued
+    //accepts only frames with our magic and version that weren't produced by ownOrigin, so garbage and looped back frames never wake the daemon
+    //with shardCount above 1 only frames with origin % shardCount == shardIndex are accepted, used to split load between reuseport sockets
+    //unicast probes reach only one reuseport socket, so they are accepted by every shard
+    class FrameFilter {
+    public:
+        //socket filters see datagram starting with UDP header
+        static constexpr std::uint32_t UDP_HEADER_SIZE = 8u;
+
+        static std::vector<::sock_filter> program(std::uint64_t ownOrigin, std::uint32_t shardCount = 1, std::uint32_t shardIndex = 0);
+    };
+}
+
+#endif
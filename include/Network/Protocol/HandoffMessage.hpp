@@ -0,0 +1,47 @@
+#pragma once
+#ifndef HANDOFFMESSAGE_HPP
+#define HANDOFFMESSAGE_HPP
+
+#include "Utility/Serialization/Codec.hpp"
+#include "Utility/Result.hpp"
+
+#include <vector>
+#include <span>
+#include <cstdint>
+#include <tuple>
+
+using Utility::Serialization::Codec;
+using Utility::Serialization::Field;
+using Utility::Result;
+
+namespace Network::Protocol {
+    //what each descriptor passed along with handoff message is
+    enum class HandoffRole : std::uint8_t {
+        UnixListener = 0u,
+        IPv4Receiver = 1u,
+        IPv6Receiver = 2u
+    };
+
+    //payload of handoff frame sent by running daemon to its replacement
+    //roles describe SCM_RIGHTS descriptors attached to the frame in the order they're attached
+    struct HandoffMessage {
+        std::vector<std::uint8_t> roles;
+        //NeighborSnapshot encoding of neighbor table at the moment of handoff
+        std::vector<std::uint8_t> neighborSnapshot;
+
+        //serialized members in wire order, codec is generated from it
+        static constexpr auto fields() {
+            return std::tuple{Field{"handoff descriptor roles", &HandoffMessage::roles}, Field{"handoff neighbor snapshot", &HandoffMessage::neighborSnapshot}};
+        }
+
+        void serialize(std::vector<std::uint8_t>& buff) const {
+            Codec::encode(*this, buff);
+        }
+
+        static Result<HandoffMessage> deserialize(std::span<const std::uint8_t> buff, std::size_t& offset) {
+            return Codec::decode<HandoffMessage>(buff, offset);
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,32 @@
+#pragma once
+#ifndef PROBEMESSAGE_HPP
+#define PROBEMESSAGE_HPP
+
+#include "Utility/Serialization/ISerializable.hpp"
+#include "Utility/Serialization/IDeserializable.hpp"
+#include "Utility/Result.hpp"
+
+#include <vector>
+#include <span>
+#include <cstdint>
+
+using Utility::Serialization::ISerializable;
+using Utility::Serialization::IDeserializable;
+using Utility::Result;
+
+namespace Network::Protocol {
+    //payload of echo probe and its reply, only prober interprets it
+    //sentNs is prober's steady clock, for diagnostics only, prober measures round trip from send time it kept itself
+    struct ProbeMessage : public ISerializable, public IDeserializable<ProbeMessage> {
+        std::uint64_t sequence{};
+        std::int64_t sentNs{};
+
+        ~ProbeMessage() = default;
+
+        void serialize(std::vector<std::uint8_t>& buff) const;
+        //used by IDeserializable interface to handle deserialization statically
+        static Result<ProbeMessage> deserializeImpl(std::span<const std::uint8_t> buff, std::size_t& offset);
+    };
+}
+
+#endif
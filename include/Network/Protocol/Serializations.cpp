@@ -0,0 +1,21 @@
+#include "ShardDigest.hpp"
+#include "ProbeMessage.hpp"
+#include "Utility/Serialization/Serializer.hpp"
+
+#include <vector>
+#include <cstdint>
+
+using Network::Protocol::ShardDigest;
+using Network::Protocol::ProbeMessage;
+using Utility::Serialization::Serializer;
+
+void ShardDigest::serialize(std::vector<std::uint8_t>& buff) const {
+    Serializer::serialize(buff, this->shard);
+    Serializer::serialize(buff, this->members);
+    Serializer::serialize(buff, this->digest);
+}
+
+void ProbeMessage::serialize(std::vector<std::uint8_t>& buff) const {
+    Serializer::serialize(buff, this->sequence);
+    Serializer::serialize(buff, this->sentNs);
+}
@@ -0,0 +1,34 @@
+#pragma once
+#ifndef SHARDDIGEST_HPP
+#define SHARDDIGEST_HPP
+
+#include "Utility/Serialization/ISerializable.hpp"
+#include "Utility/Serialization/IDeserializable.hpp"
+#include "Utility/Result.hpp"
+
+#include <vector>
+#include <span>
+#include <cstdint>
+
+using Utility::Serialization::ISerializable;
+using Utility::Serialization::IDeserializable;
+using Utility::Result;
+
+namespace Network::Protocol {
+    //summary of one multicast shard as seen by a subscribed daemon, sent on summary group
+    //digest is a sum of fingerprints of member interfaces as they were announced, so it changes whenever any member changes
+    //local subnet filtering isn't applied to it, daemons seeing the same announcements agree on it
+    struct ShardDigest : public ISerializable, public IDeserializable<ShardDigest> {
+        std::uint32_t shard{};
+        std::uint32_t members{};
+        std::uint64_t digest{};
+
+        ~ShardDigest() = default;
+
+        void serialize(std::vector<std::uint8_t>& buff) const;
+        //used by IDeserializable interface to handle deserialization statically
+        static Result<ShardDigest> deserializeImpl(std::span<const std::uint8_t> buff, std::size_t& offset);
+    };
+}
+
+#endif
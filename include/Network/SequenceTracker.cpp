@@ -0,0 +1,82 @@
+#include "SequenceTracker.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using Network::SequenceTracker;
+using Network::NeighborLoss;
+
+namespace {
+    constexpr double INTERVAL_GAIN = 1.0 / 8.0;
+    constexpr double JITTER_GAIN = 1.0 / 16.0;
+}
+
+void SequenceTracker::add(std::uint64_t epoch, std::uint32_t sequence, std::chrono::steady_clock::time_point arrival) {
+    this->lastSeen = std::max(this->lastSeen, arrival);
+
+    if (this->epoch != epoch) {
+        if (this->epoch.has_value()) {
+            this->counters.restarts++;
+        }
+        std::uint32_t restarts = this->counters.restarts;
+        this->counters = NeighborLoss{};
+        this->counters.restarts = restarts;
+        this->counters.epoch = epoch;
+        this->counters.received = 1;
+        this->epoch = epoch;
+        this->highest = sequence;
+        this->seen = 1;
+        this->prevArrival = arrival;
+        this->intervalUs.reset();
+        this->intervalJitterUs = 0.0;
+        return;
+    }
+
+    std::int32_t ahead = static_cast<std::int32_t>(sequence - this->highest);
+    if (ahead == 0) {
+        this->counters.duplicates++;
+        return;
+    }
+
+    if (ahead < 0) {
+        std::uint32_t behind = static_cast<std::uint32_t>(-static_cast<std::int64_t>(ahead));
+        if (behind < WINDOW && (this->seen >> behind) & 1u) {
+            this->counters.duplicates++;
+            return;
+        }
+        //arrivals older than window can't be told from duplicates, they count as late without filling their gap
+        if (behind < WINDOW) {
+            this->seen |= std::uint64_t{1} << behind;
+            this->counters.lost -= std::min<std::uint64_t>(this->counters.lost, 1);
+        }
+        this->counters.reordered++;
+        this->counters.received++;
+        return;
+    }
+
+    std::uint32_t step = static_cast<std::uint32_t>(ahead);
+    this->counters.lost += step - 1;
+    this->counters.received++;
+    this->seen = step < WINDOW ? (this->seen << step) | 1u : 1u;
+    this->highest = sequence;
+
+    //gap spreads its time over missing sequence numbers, so loss doesn't inflate interval
+    double sampleUs = std::chrono::duration<double, std::micro>(arrival - this->prevArrival).count() / step;
+    sampleUs = std::max(sampleUs, 0.0);
+    if (!this->intervalUs.has_value()) {
+        this->intervalUs = sampleUs;
+    } else {
+        this->intervalJitterUs += (std::abs(sampleUs - this->intervalUs.value()) - this->intervalJitterUs) * JITTER_GAIN;
+        this->intervalUs = this->intervalUs.value() + (sampleUs - this->intervalUs.value()) * INTERVAL_GAIN;
+    }
+    this->prevArrival = arrival;
+}
+
+NeighborLoss SequenceTracker::report(const std::string& sender, const std::string& macs) const {
+    NeighborLoss loss = this->counters;
+    loss.sender = sender;
+    loss.macs = macs;
+    loss.intervalMs = static_cast<std::uint32_t>(this->intervalUs.value_or(0.0) / 1000.0);
+    loss.intervalJitterMs = static_cast<std::uint32_t>(this->intervalJitterUs / 1000.0);
+    return loss;
+}
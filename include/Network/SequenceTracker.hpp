@@ -0,0 +1,43 @@
+#pragma once
+#ifndef SEQUENCETRACKER_HPP
+#define SEQUENCETRACKER_HPP
+
+#include "NeighborLoss.hpp"
+
+#include <string>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+
+namespace Network {
+    //announcement sequence statistics of one sender, fed with every received copy in arrival order
+    //new epoch restarts counting, sequence numbers are compared with wraparound
+    class SequenceTracker {
+    public:
+        //recent sequence numbers below highest one remembered to tell late arrivals from duplicates
+        static constexpr std::uint32_t WINDOW = 64u;
+
+    private:
+        std::optional<std::uint64_t> epoch{};
+        std::uint32_t highest = 0;
+        //bit i set if highest - i was received
+        std::uint64_t seen = 0;
+        //arrival of highest sequence, intervals are measured between in order arrivals only
+        std::chrono::steady_clock::time_point prevArrival{};
+        std::chrono::steady_clock::time_point lastSeen{};
+        std::optional<double> intervalUs{};
+        double intervalJitterUs = 0.0;
+        NeighborLoss counters{};
+
+    public:
+        void add(std::uint64_t epoch, std::uint32_t sequence, std::chrono::steady_clock::time_point arrival);
+
+        std::chrono::steady_clock::time_point lastArrival() const {
+            return this->lastSeen;
+        }
+
+        NeighborLoss report(const std::string& sender, const std::string& macs) const;
+    };
+}
+
+#endif
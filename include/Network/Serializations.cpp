@@ -0,0 +1,49 @@
+#include "NeighborPage.hpp"
+#include "NeighborLatency.hpp"
+#include "NeighborLoss.hpp"
+#include "Utility/Serialization/Serializer.hpp"
+
+#include <vector>
+#include <cstdint>
+
+using Network::NeighborPage;
+using Network::NeighborLatency;
+using Network::NeighborLoss;
+using Network::LossReport;
+using Utility::Serialization::Serializer;
+
+void NeighborPage::serialize(std::vector<std::uint8_t>& buff) const {
+    Serializer::serialize(buff, this->generation);
+    Serializer::serialize(buff, this->cursor);
+    Serializer::serialize(buff, this->neighbors);
+}
+
+void NeighborLatency::serialize(std::vector<std::uint8_t>& buff) const {
+    Serializer::serialize(buff, this->mac);
+    Serializer::serialize(buff, this->samples);
+    Serializer::serialize(buff, this->smoothedRttUs);
+    Serializer::serialize(buff, this->jitterUs);
+    Serializer::serialize(buff, this->p50RttUs);
+    Serializer::serialize(buff, this->p90RttUs);
+    Serializer::serialize(buff, this->p99RttUs);
+    Serializer::serialize(buff, this->lossPermille);
+}
+
+void NeighborLoss::serialize(std::vector<std::uint8_t>& buff) const {
+    Serializer::serialize(buff, this->sender);
+    Serializer::serialize(buff, this->macs);
+    Serializer::serialize(buff, this->epoch);
+    Serializer::serialize(buff, this->restarts);
+    Serializer::serialize(buff, this->received);
+    Serializer::serialize(buff, this->lost);
+    Serializer::serialize(buff, this->reordered);
+    Serializer::serialize(buff, this->duplicates);
+    Serializer::serialize(buff, this->intervalMs);
+    Serializer::serialize(buff, this->intervalJitterMs);
+}
+
+void LossReport::serialize(std::vector<std::uint8_t>& buff) const {
+    Serializer::serialize(buff, this->kernelDrops);
+    this->total.serialize(buff);
+    Serializer::serialize(buff, this->senders);
+}
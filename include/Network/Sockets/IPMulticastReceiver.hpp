@@ -2,12 +2,17 @@
 #ifndef IPMULTICASTRECEIVER_HPP
 #define IPMULTICASTRECEIVER_HPP
 
-#include "Utility/FunctionReturn.hpp"
+#include "Utility/Result.hpp"
+#include "SocketBuffers.hpp"
 
 #include <arpa/inet.h>
 #include <netinet/in.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
+#include <linux/filter.h>
+#include <linux/io_uring.h>
 #include <unistd.h>
+#include <fcntl.h>
 
 #include <cstdint>
 #include <vector>
@@ -16,9 +21,16 @@
 #include <type_traits>
 #include <stdexcept>
 #include <memory>
+#include <cstring>
+#include <span>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <ctime>
 
-using Utility::FunctionReturn;
-using Utility::ExitCode;
+using Utility::Result;
+using Utility::Error;
+using Utility::ErrorCode;
 using Logging::LoggableFrom;
 using Logging::ILogger;
 
@@ -27,28 +39,83 @@ namespace Network::Sockets {
     template<typename T>
     requires (std::is_same_v<T, ::sockaddr_in> || std::is_same_v<T, ::sockaddr_in6>)
     class IPMulticastReceiver {
+    public:
+        //room for packet info of either family, SO_RXQ_OVFL drop counter and SO_TIMESTAMPNS arrival time
+        static constexpr std::size_t CONTROL_SIZE = CMSG_SPACE(sizeof(::in6_pktinfo)) + CMSG_SPACE(sizeof(std::uint32_t)) + CMSG_SPACE(sizeof(::timespec));
+        //multishot recvmsg places its header, sender address and control data in front of payload
+        static constexpr std::size_t MULTISHOT_OVERHEAD = sizeof(::io_uring_recvmsg_out) + sizeof(T) + CONTROL_SIZE;
+
     private:
         std::uint16_t port;
         int sockFd;
         int family;
+        //only name and control lengths are used by io_uring, they don't change
+        ::msghdr multishotTemplate{};
+        //datagrams kernel dropped because socket queue was full, reported along with next received datagram
+        std::atomic<std::uint32_t> dropped = 0;
 
         explicit IPMulticastReceiver(std::uint16_t port);
 
+        //returns index of arrival interface and stores drop counter if kernel reported one
+        //arrival receives kernel timestamp, time of reading if kernel didn't stamp datagram
+        unsigned int readControl(::msghdr& msg, std::chrono::system_clock::time_point* arrival);
+
+        //ingress interface, drop counter and arrival time of every datagram are reported in ancillary data
+        Result<> enableAncillaryData();
+
     public:
         ~IPMulticastReceiver();
 
-        FunctionReturn<> enableMulticastGroup(const std::string& multicast_ip, unsigned int ifindex = 0);
-        FunctionReturn<> disableMulticastGroup(const std::string& multicast_ip, unsigned int ifindex = 0);
+        Result<> enableMulticastGroup(const std::string& multicast_ip, unsigned int ifindex = 0);
+        Result<> disableMulticastGroup(const std::string& multicast_ip, unsigned int ifindex = 0);
+
+        //ifindex receives index of interface datagram arrived on, 0 if kernel didn't report it
+        //arrival receives time kernel queued datagram, it's realtime clock like every SO_TIMESTAMPNS stamp
+        ssize_t receive(std::vector<std::uint8_t>& buffer, T* sender = nullptr, unsigned int* ifindex = nullptr,
+            std::chrono::system_clock::time_point* arrival = nullptr);
+
+        //parses provided buffer filled by io_uring multishot recvmsg armed with multishotHeader()
+        ssize_t receive(std::span<const std::uint8_t> multishotBuffer, std::vector<std::uint8_t>& buffer, T* sender = nullptr, unsigned int* ifindex = nullptr,
+            std::chrono::system_clock::time_point* arrival = nullptr);
+
+        const ::msghdr* multishotHeader() const {
+            return &this->multishotTemplate;
+        }
+
+        //attaches classic BPF program that decides in kernel which datagrams get queued to socket
+        Result<> attachFilter(std::vector<::sock_filter>& program);
+
+        //used to wait for readiness with poll()
+        int fd() const {
+            return this->sockFd;
+        }
+
+        //total since socket creation, safe to read from other threads
+        std::uint32_t droppedDatagrams() const {
+            return this->dropped;
+        }
+
+        //returns queue size kernel reports afterwards
+        Result<int> setReceiveBufferSize(int bytes) {
+            return SocketBuffers::resize(this->sockFd, true, bytes);
+        }
 
-        ssize_t receive(std::vector<std::uint8_t>& buffer, T* sender = nullptr);
+        Result<int> receiveBufferSize() const {
+            return SocketBuffers::size(this->sockFd, true);
+        }
+
+        //reusePort lets several sockets bind the same port, each still gets its own copy of multicast datagrams
+        static Result<IPMulticastReceiver<T>> factory(std::uint16_t port, bool reusePort = false);
 
-        static FunctionReturn<IPMulticastReceiver<T>> factory(std::uint16_t port);
+        //takes over socket handed over by another process, its multicast memberships stay joined
+        //fails if socket isn't of family T bound to port, descriptor is closed then
+        static Result<IPMulticastReceiver<T>> adoptedFactory(int fd, std::uint16_t port);
 
         IPMulticastReceiver(const IPMulticastReceiver&) = delete;
         IPMulticastReceiver& operator=(const IPMulticastReceiver&) = delete;
 
         IPMulticastReceiver(IPMulticastReceiver&& other) 
-            : port(other.port), sockFd(other.sockFd), family(other.family) {
+            : port(other.port), sockFd(other.sockFd), family(other.family), multishotTemplate(other.multishotTemplate), dropped(other.dropped.load()) {
             other.sockFd = -1;
         }
 
@@ -60,6 +127,8 @@ namespace Network::Sockets {
                 this->sockFd = other.sockFd;
                 this->family = other.family;
                 this->port = other.port;
+                this->multishotTemplate = other.multishotTemplate;
+                this->dropped = other.dropped.load();
                 other.sockFd = -1;
             }
             return *this;
@@ -68,18 +137,27 @@ namespace Network::Sockets {
 
     template<typename T>
     requires (std::is_same_v<T, ::sockaddr_in> || std::is_same_v<T, ::sockaddr_in6>)
-    FunctionReturn<IPMulticastReceiver<T>> IPMulticastReceiver<T>::factory(std::uint16_t port) {
+    Result<IPMulticastReceiver<T>> IPMulticastReceiver<T>::factory(std::uint16_t port, bool reusePort) {
+        //receiver closes its socket on every failed return below
         IPMulticastReceiver<T> receiver{port};
 
         receiver.sockFd = ::socket(receiver.family, SOCK_DGRAM | SOCK_NONBLOCK, 0);
         if (receiver.sockFd < 0) {
-            return FunctionReturn<IPMulticastReceiver<T>>{ExitCode::Error, std::format("IPMulticastReceiver socket creation on port {} failed", port)};
+            return Error::system("IPMulticastReceiver socket creation failed on port", port);
         }
 
         int reuse = 1;
         if (::setsockopt(receiver.sockFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)) < 0) {
-            ::close(receiver.sockFd);
-            return FunctionReturn<IPMulticastReceiver<T>>{ExitCode::Error, std::format("setsockopt SO_REUSEADDR on IPMulticastReceiver socket on port {} failed", port)};
+            return Error::system("setsockopt SO_REUSEADDR failed on port", port);
+        }
+
+        if (reusePort && ::setsockopt(receiver.sockFd, SOL_SOCKET, SO_REUSEPORT, &reuse, sizeof(reuse)) < 0) {
+            return Error::system("setsockopt SO_REUSEPORT failed on port", port);
+        }
+
+        auto ancillaryReturn = receiver.enableAncillaryData();
+        if (!ancillaryReturn.isOk()) {
+            return ancillaryReturn.error();
         }
 
         if constexpr (std::is_same_v<T, ::sockaddr_in>) {
@@ -88,8 +166,7 @@ namespace Network::Sockets {
             addr.sin_addr.s_addr = ::htonl(INADDR_ANY);
             addr.sin_port = ::htons(receiver.port);
             if (::bind(receiver.sockFd, reinterpret_cast<::sockaddr*>(&addr), sizeof(addr)) < 0) {
-                ::close(receiver.sockFd);
-                return FunctionReturn<IPMulticastReceiver<T>>{ExitCode::Error, std::format("bind IPv4 on IPMulticastReceiver socket on port {} failed", port)};
+                return Error::system("bind IPv4 failed on port", port);
             }
         } else {
             ::sockaddr_in6 addr{};
@@ -97,12 +174,73 @@ namespace Network::Sockets {
             addr.sin6_addr = ::in6addr_any;
             addr.sin6_port = ::htons(receiver.port);
             if (::bind(receiver.sockFd, reinterpret_cast<::sockaddr*>(&addr), sizeof(addr)) < 0) {
-                ::close(receiver.sockFd);
-                return FunctionReturn<IPMulticastReceiver<T>>{ExitCode::Error, std::format("bind IPv6 on IPMulticastReceiver socket on port {} failed", port)};
+                return Error::system("bind IPv6 failed on port", port);
             }
         }
 
-        return FunctionReturn<IPMulticastReceiver<T>>{std::move(receiver)};
+        return Result<IPMulticastReceiver<T>>{std::move(receiver)};
+    }
+
+    template<typename T>
+    requires (std::is_same_v<T, ::sockaddr_in> || std::is_same_v<T, ::sockaddr_in6>)
+    Result<IPMulticastReceiver<T>> IPMulticastReceiver<T>::adoptedFactory(int fd, std::uint16_t port) {
+        //receiver closes adopted socket on every failed return below
+        IPMulticastReceiver<T> receiver{port};
+        receiver.sockFd = fd;
+
+        T addr{};
+        ::socklen_t length = sizeof(addr);
+        if (::getsockname(receiver.sockFd, reinterpret_cast<::sockaddr*>(&addr), &length) < 0) {
+            return Error::system("getsockname of adopted receiver socket failed on port", port);
+        }
+        std::uint16_t boundPort = 0;
+        if constexpr (std::is_same_v<T, ::sockaddr_in>) {
+            boundPort = addr.sin_family == AF_INET ? ::ntohs(addr.sin_port) : 0;
+        } else {
+            boundPort = addr.sin6_family == AF_INET6 ? ::ntohs(addr.sin6_port) : 0;
+        }
+        if (boundPort != port) {
+            return Error{ErrorCode::Failed, "Adopted receiver socket isn't bound to port", port};
+        }
+
+        int flags = ::fcntl(receiver.sockFd, F_GETFL);
+        if (flags < 0 || ::fcntl(receiver.sockFd, F_SETFL, flags | O_NONBLOCK) < 0) {
+            return Error::system("fcntl O_NONBLOCK of adopted receiver socket failed on port", port);
+        }
+
+        //previous owner might have been older build that enabled less of it
+        auto ancillaryReturn = receiver.enableAncillaryData();
+        if (!ancillaryReturn.isOk()) {
+            return ancillaryReturn.error();
+        }
+
+        return Result<IPMulticastReceiver<T>>{std::move(receiver)};
+    }
+
+    template<typename T>
+    requires (std::is_same_v<T, ::sockaddr_in> || std::is_same_v<T, ::sockaddr_in6>)
+    Result<> IPMulticastReceiver<T>::enableAncillaryData() {
+        //ingress interface of every datagram is reported in ancillary data
+        int pktinfo = 1;
+        int pktinfoLevel = std::is_same_v<T, ::sockaddr_in> ? IPPROTO_IP : IPPROTO_IPV6;
+        int pktinfoOption = std::is_same_v<T, ::sockaddr_in> ? IP_PKTINFO : IPV6_RECVPKTINFO;
+        if (::setsockopt(this->sockFd, pktinfoLevel, pktinfoOption, &pktinfo, sizeof(pktinfo)) < 0) {
+            return Error::system("setsockopt packet info failed on port", this->port);
+        }
+
+        //kernel drop counter of socket is reported in ancillary data as well
+        int overflow = 1;
+        if (::setsockopt(this->sockFd, SOL_SOCKET, SO_RXQ_OVFL, &overflow, sizeof(overflow)) < 0) {
+            return Error::system("setsockopt SO_RXQ_OVFL failed on port", this->port);
+        }
+
+        //arrival time is taken by kernel, not when daemon gets to the datagram
+        int timestamp = 1;
+        if (::setsockopt(this->sockFd, SOL_SOCKET, SO_TIMESTAMPNS, &timestamp, sizeof(timestamp)) < 0) {
+            return Error::system("setsockopt SO_TIMESTAMPNS failed on port", this->port);
+        }
+
+        return Result<>{};
     }
 
 
@@ -115,6 +253,8 @@ namespace Network::Sockets {
         } else {
             this->family = AF_INET6;
         }
+        this->multishotTemplate.msg_namelen = sizeof(T);
+        this->multishotTemplate.msg_controllen = CONTROL_SIZE;
     }
 
     template<typename T>
@@ -127,64 +267,172 @@ namespace Network::Sockets {
 
     template<typename T>
     requires (std::is_same_v<T, ::sockaddr_in> || std::is_same_v<T, ::sockaddr_in6>)
-    FunctionReturn<> IPMulticastReceiver<T>::enableMulticastGroup(const std::string& multicast_ip, unsigned int ifindex) {
+    Result<> IPMulticastReceiver<T>::enableMulticastGroup(const std::string& multicast_ip, unsigned int ifindex) {
         if constexpr (std::is_same_v<T, ::sockaddr_in>) {
-            ::ip_mreq mreq{};
+            //ip_mreqn selects interface by index, ip_mreq with INADDR_ANY would join only on the default one
+            ::ip_mreqn mreq{};
             if (::inet_pton(AF_INET, multicast_ip.c_str(), &mreq.imr_multiaddr) < 0) {
-                return FunctionReturn<>{std::format("Failed converting IPv4 {} from text to binary", multicast_ip)};
+                return Error{ErrorCode::Failed, "Failed converting IPv4 multicast address from text to binary"};
             }
-            mreq.imr_interface.s_addr = ::htonl(INADDR_ANY);
-            if (::setsockopt(this->sockFd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq)) < 0) {
-                return FunctionReturn<>{std::format("Failed setting IPPROTO_IP, IP_DROP_MEMBERSHIP on {} socket", this->sockFd)};
+            mreq.imr_address.s_addr = ::htonl(INADDR_ANY);
+            mreq.imr_ifindex = static_cast<int>(ifindex);
+            //socket handed over by previous daemon has joined already
+            if (::setsockopt(this->sockFd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq)) < 0 && errno != EADDRINUSE) {
+                return Error::system("Failed setting IPPROTO_IP, IP_ADD_MEMBERSHIP for interface", ifindex);
             }
         } else {
             ::ipv6_mreq mreq{};
             if (::inet_pton(AF_INET6, multicast_ip.c_str(), &mreq.ipv6mr_multiaddr) < 0) {
-                return FunctionReturn<>{std::format("Failed converting IPv6 {} from text to binary", multicast_ip)};
+                return Error{ErrorCode::Failed, "Failed converting IPv6 multicast address from text to binary"};
             }
             mreq.ipv6mr_interface = ifindex;
-            if (::setsockopt(this->sockFd, IPPROTO_IPV6, IPV6_ADD_MEMBERSHIP, &mreq, sizeof(mreq)) < 0) {
-                return FunctionReturn<>{std::format("Failed setting IPPROTO_IPV5, IPV6_DROP_MEMBERSHIP on {} socket", this->sockFd)};
+            if (::setsockopt(this->sockFd, IPPROTO_IPV6, IPV6_ADD_MEMBERSHIP, &mreq, sizeof(mreq)) < 0 && errno != EADDRINUSE) {
+                return Error::system("Failed setting IPPROTO_IPV6, IPV6_ADD_MEMBERSHIP for interface", ifindex);
             }
         }
 
-        return FunctionReturn<>{};
+        return Result<>{};
     }
 
     template<typename T>
     requires (std::is_same_v<T, ::sockaddr_in> || std::is_same_v<T, ::sockaddr_in6>)
-    FunctionReturn<> IPMulticastReceiver<T>::disableMulticastGroup(const std::string& multicast_ip, unsigned int ifindex) {
+    Result<> IPMulticastReceiver<T>::disableMulticastGroup(const std::string& multicast_ip, unsigned int ifindex) {
         if constexpr (std::is_same_v<T, ::sockaddr_in>) {
-            ::ip_mreq mreq{};
+            //ip_mreqn selects interface by index, ip_mreq with INADDR_ANY would join only on the default one
+            ::ip_mreqn mreq{};
             if (::inet_pton(AF_INET, multicast_ip.c_str(), &mreq.imr_multiaddr) < 0) {
-                return FunctionReturn<>{std::format("Failed converting IPv4 {} from text to binary", multicast_ip)};
+                return Error{ErrorCode::Failed, "Failed converting IPv4 multicast address from text to binary"};
             }
-            mreq.imr_interface.s_addr = ::htonl(INADDR_ANY);
+            mreq.imr_address.s_addr = ::htonl(INADDR_ANY);
+            mreq.imr_ifindex = static_cast<int>(ifindex);
             if (::setsockopt(this->sockFd, IPPROTO_IP, IP_DROP_MEMBERSHIP, &mreq, sizeof(mreq)) < 0) {
-                return FunctionReturn<>{std::format("Failed setting IPPROTO_IP, IP_DROP_MEMBERSHIP on {} socket", this->sockFd)};
+                return Error::system("Failed setting IPPROTO_IP, IP_DROP_MEMBERSHIP for interface", ifindex);
             }
         } else {
             ::ipv6_mreq mreq{};
             if (::inet_pton(AF_INET6, multicast_ip.c_str(), &mreq.ipv6mr_multiaddr) < 0) {
-                return FunctionReturn<>{std::format("Failed converting IPv6 {} from text to binary", multicast_ip)};
+                return Error{ErrorCode::Failed, "Failed converting IPv6 multicast address from text to binary"};
             }
             mreq.ipv6mr_interface = ifindex;    
             if (::setsockopt(this->sockFd, IPPROTO_IPV6, IPV6_DROP_MEMBERSHIP, &mreq, sizeof(mreq)) < 0) {
-                return FunctionReturn<>{std::format("Failed setting IPPROTO_IPV5, IPV6_DROP_MEMBERSHIP on {} socket", this->sockFd)};
+                return Error::system("Failed setting IPPROTO_IPV6, IPV6_DROP_MEMBERSHIP for interface", ifindex);
             }
         }
 
-        return FunctionReturn<>{};
+        return Result<>{};
+    }
+
+    template<typename T>
+    requires (std::is_same_v<T, ::sockaddr_in> || std::is_same_v<T, ::sockaddr_in6>)
+    Result<> IPMulticastReceiver<T>::attachFilter(std::vector<::sock_filter>& program) {
+        ::sock_fprog fprog{};
+        fprog.len = static_cast<unsigned short>(program.size());
+        fprog.filter = program.data();
+        if (::setsockopt(this->sockFd, SOL_SOCKET, SO_ATTACH_FILTER, &fprog, sizeof(fprog)) < 0) {
+            return Error::system("Failed setting SOL_SOCKET, SO_ATTACH_FILTER on socket", this->sockFd);
+        }
+        return Result<>{};
     }
 
     template<typename T>
     requires (std::is_same_v<T, ::sockaddr_in> || std::is_same_v<T, ::sockaddr_in6>)
-    ssize_t IPMulticastReceiver<T>::receive(std::vector<std::uint8_t>& buffer, T* sender) {
-        socklen_t len = sender ? sizeof(T) : 0;
-        ssize_t n = ::recvfrom(sockFd, buffer.data(), buffer.size(), 0, 
-            sender ? reinterpret_cast<::sockaddr*>(sender) : nullptr, sender ? &len : nullptr);
+    ssize_t IPMulticastReceiver<T>::receive(std::vector<std::uint8_t>& buffer, T* sender, unsigned int* ifindex, std::chrono::system_clock::time_point* arrival) {
+        ::iovec iov{buffer.data(), buffer.size()};
+        alignas(::cmsghdr) std::uint8_t control[CONTROL_SIZE];
+
+        ::msghdr msg{};
+        msg.msg_name = sender;
+        msg.msg_namelen = sender ? sizeof(T) : 0;
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+
+        ssize_t n = ::recvmsg(this->sockFd, &msg, 0);
+        if (n < 0) {
+            return n;
+        }
+
+        unsigned int arrivalIfindex = this->readControl(msg, arrival);
+        if (ifindex != nullptr) {
+            *ifindex = arrivalIfindex;
+        }
         return n;
     }
+
+    template<typename T>
+    requires (std::is_same_v<T, ::sockaddr_in> || std::is_same_v<T, ::sockaddr_in6>)
+    ssize_t IPMulticastReceiver<T>::receive(std::span<const std::uint8_t> multishotBuffer, std::vector<std::uint8_t>& buffer, T* sender, unsigned int* ifindex,
+        std::chrono::system_clock::time_point* arrival) {
+        std::size_t nameSize = this->multishotTemplate.msg_namelen;
+        std::size_t controlSize = this->multishotTemplate.msg_controllen;
+        std::size_t payloadOffset = sizeof(::io_uring_recvmsg_out) + nameSize + controlSize;
+        if (multishotBuffer.size() < payloadOffset) {
+            return -1;
+        }
+
+        ::io_uring_recvmsg_out out{};
+        std::memcpy(&out, multishotBuffer.data(), sizeof(out));
+        const std::uint8_t* name = multishotBuffer.data() + sizeof(out);
+        const std::uint8_t* control = name + nameSize;
+
+        //truncated datagrams are cut the same way recvmsg cuts them
+        std::size_t n = std::min({static_cast<std::size_t>(out.payloadlen), multishotBuffer.size() - payloadOffset, buffer.size()});
+        std::memcpy(buffer.data(), multishotBuffer.data() + payloadOffset, n);
+
+        if (sender != nullptr) {
+            *sender = T{};
+            std::memcpy(sender, name, std::min<std::size_t>(out.namelen, sizeof(T)));
+        }
+        ::msghdr msg{};
+        msg.msg_control = const_cast<std::uint8_t*>(control);
+        msg.msg_controllen = std::min<std::size_t>(out.controllen, controlSize);
+        unsigned int arrivalIfindex = this->readControl(msg, arrival);
+        if (ifindex != nullptr) {
+            *ifindex = arrivalIfindex;
+        }
+        return static_cast<ssize_t>(n);
+    }
+
+    template<typename T>
+    requires (std::is_same_v<T, ::sockaddr_in> || std::is_same_v<T, ::sockaddr_in6>)
+    unsigned int IPMulticastReceiver<T>::readControl(::msghdr& msg, std::chrono::system_clock::time_point* arrival) {
+        unsigned int ifindex = 0;
+        if (arrival != nullptr) {
+            *arrival = std::chrono::system_clock::now();
+        }
+        for (::cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+            if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMPNS) {
+                ::timespec stamp{};
+                std::memcpy(&stamp, CMSG_DATA(cmsg), sizeof(stamp));
+                if (arrival != nullptr) {
+                    *arrival = std::chrono::system_clock::time_point(std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                        std::chrono::seconds(stamp.tv_sec) + std::chrono::nanoseconds(stamp.tv_nsec)));
+                }
+                continue;
+            }
+            if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SO_RXQ_OVFL) {
+                std::uint32_t drops = 0;
+                std::memcpy(&drops, CMSG_DATA(cmsg), sizeof(drops));
+                this->dropped = drops;
+                continue;
+            }
+            if constexpr (std::is_same_v<T, ::sockaddr_in>) {
+                if (cmsg->cmsg_level == IPPROTO_IP && cmsg->cmsg_type == IP_PKTINFO) {
+                    ::in_pktinfo info{};
+                    std::memcpy(&info, CMSG_DATA(cmsg), sizeof(info));
+                    ifindex = static_cast<unsigned int>(info.ipi_ifindex);
+                }
+            } else {
+                if (cmsg->cmsg_level == IPPROTO_IPV6 && cmsg->cmsg_type == IPV6_PKTINFO) {
+                    ::in6_pktinfo info{};
+                    std::memcpy(&info, CMSG_DATA(cmsg), sizeof(info));
+                    ifindex = info.ipi6_ifindex;
+                }
+            }
+        }
+        return ifindex;
+    }
 }
 
 #endif
\ No newline at end of file
@@ -2,9 +2,11 @@
 #ifndef IPMULTICASTSENDER_HPP
 #define IPMULTICASTSENDER_HPP
 
-#include "Utility/FunctionReturn.hpp"
+#include "Utility/Result.hpp"
+#include "SocketBuffers.hpp"
 #include "Logging/LoggableFrom.hpp"
 #include "Logging/ILogger.hpp"
+#include "IoUring.hpp"
 
 #include <arpa/inet.h>
 #include <netinet/in.h>
@@ -20,9 +22,11 @@
 #include <memory>
 #include <format>
 #include <cstring>
+#include <cerrno>
 
-using Utility::FunctionReturn;
-using Utility::ExitCode;
+using Utility::Result;
+using Utility::Error;
+using Utility::ErrorCode;
 
 namespace Network::Sockets {
     //templated socket handler for multicast message sending (::sockaddr_in for IPv4, ::sockaddr_in fo IPv6)
@@ -44,12 +48,23 @@ namespace Network::Sockets {
     public:
         ~IPMulticastSender();
 
-        FunctionReturn<> addMulticastAddress(const std::string& multicast_ip, std::uint16_t port, const unsigned int& ifindex = 0);
-        FunctionReturn<> removeMulticastAddress(const std::string& multicast_ip, std::uint16_t port, const unsigned int& ifindex = 0);
+        Result<> addMulticastAddress(const std::string& multicast_ip, std::uint16_t port, const unsigned int& ifindex = 0);
+        Result<> removeMulticastAddress(const std::string& multicast_ip, std::uint16_t port, const unsigned int& ifindex = 0);
         
-        FunctionReturn<> send(const std::vector<std::uint8_t>& data);
+        Result<> send(const std::vector<std::uint8_t>& data);
 
-        static FunctionReturn<IPMulticastSender<T>> factory();
+        //unicast to single address instead of multicast targets, used for echo probes
+        Result<> sendTo(const std::vector<std::uint8_t>& data, const T& address);
+
+        //queues sendmsg per target on ring, outgoing interface is chosen by packet info instead of setsockopt so that messages can be batched
+        Result<> send(std::shared_ptr<const std::vector<std::uint8_t>> data, IoUring& ring);
+
+        static Result<IPMulticastSender<T>> factory();
+
+        //returns queue size kernel reports afterwards
+        Result<int> setSendBufferSize(int bytes) {
+            return SocketBuffers::resize(this->sockFd, false, bytes);
+        }
 
         IPMulticastSender(const IPMulticastSender&) = delete;
         IPMulticastSender& operator=(const IPMulticastSender&) = delete;
@@ -76,26 +91,26 @@ namespace Network::Sockets {
 
     template<typename T>
     requires (std::is_same_v<T, ::sockaddr_in> || std::is_same_v<T, ::sockaddr_in6>)
-    FunctionReturn<IPMulticastSender<T>> IPMulticastSender<T>::factory() {
+    Result<IPMulticastSender<T>> IPMulticastSender<T>::factory() {
         IPMulticastSender<T> sender;
         sender.sockFd = ::socket(sender.family, SOCK_DGRAM, 0);
 
         if (sender.sockFd < 0) {
-            return FunctionReturn<IPMulticastSender<T>>{ExitCode::Error, "IPMulticastSender socket creation failed"};
+            return Error::system("IPMulticastSender socket creation failed");
         }
 
         // unsigned char loop = 0; 
         // if constexpr (std::is_same_v<T, ::sockaddr_in>) {
         //     if (::setsockopt(sender.sockFd, IPPROTO_IP, IP_MULTICAST_LOOP, &loop, sizeof(loop)) < 0) {
-        //         return FunctionReturn<IPMulticastSender<T>>{ExitCode::Error, "IPMulticastSender loopback = 0 setsockopt faield"};
+        //         return Error::system("IPMulticastSender loopback = 0 setsockopt failed");
         //     }
         // } else {
         //     if (::setsockopt(sender.sockFd, IPPROTO_IPV6, IPV6_MULTICAST_LOOP, &loop, sizeof(loop)) < 0) {
-        //         return FunctionReturn<IPMulticastSender<T>>{ExitCode::Error, "IPMulticastSender loopback = 0 setsockopt faield"};
+        //         return Error::system("IPMulticastSender loopback = 0 setsockopt failed");
         //     }
         // }
 
-        return FunctionReturn<IPMulticastSender<T>>{std::move(sender)};
+        return Result<IPMulticastSender<T>>{std::move(sender)};
     }
 
     template<typename T>
@@ -118,7 +133,7 @@ namespace Network::Sockets {
 
     template<typename T>
     requires (std::is_same_v<T, ::sockaddr_in> || std::is_same_v<T, ::sockaddr_in6>)
-    FunctionReturn<> IPMulticastSender<T>::addMulticastAddress(const std::string& multicast_ip, std::uint16_t port, const unsigned int& ifindex) {
+    Result<> IPMulticastSender<T>::addMulticastAddress(const std::string& multicast_ip, std::uint16_t port, const unsigned int& ifindex) {
         Target t{};
         t.ifindex = ifindex;
 
@@ -126,23 +141,23 @@ namespace Network::Sockets {
             t.addr.sin_family = this->family;
             t.addr.sin_port = ::htons(port);
             if (::inet_pton(this->family, multicast_ip.c_str(), &t.addr.sin_addr) < 0) {
-                return FunctionReturn<>{std::format("Failed converting IPv4 {} from text to binary", multicast_ip)};
+                return Error{ErrorCode::Failed, "Failed converting IPv4 multicast address from text to binary"};
             }
         } else { // sockaddr_in6
             t.addr.sin6_family = this->family;
             t.addr.sin6_port = ::htons(port);
             if (::inet_pton(this->family, multicast_ip.c_str(), &t.addr.sin6_addr) < 0) {
-                return FunctionReturn<>{std::format("Failed converting IPv4 {} from text to binary", multicast_ip)};
+                return Error{ErrorCode::Failed, "Failed converting IPv4 multicast address from text to binary"};
             }
         }
 
         this->targets.push_back(t);
-        return FunctionReturn<>{};
+        return Result<>{};
     }
 
     template<typename T>
     requires (std::is_same_v<T, ::sockaddr_in> || std::is_same_v<T, ::sockaddr_in6>)
-    FunctionReturn<> IPMulticastSender<T>::removeMulticastAddress(const std::string& multicast_ip, std::uint16_t port, const unsigned int& ifindex) {
+    Result<> IPMulticastSender<T>::removeMulticastAddress(const std::string& multicast_ip, std::uint16_t port, const unsigned int& ifindex) {
         Target t{};
         t.ifindex = ifindex;
 
@@ -150,7 +165,7 @@ namespace Network::Sockets {
             t.addr.sin_family = this->family;
             t.addr.sin_port = ::htons(port);
             if (::inet_pton(this->family, multicast_ip.c_str(), &t.addr.sin_addr) < 0) {
-                return FunctionReturn<>{std::format("Failed converting IPv4 {} from text to binary", multicast_ip)};
+                return Error{ErrorCode::Failed, "Failed converting IPv4 multicast address from text to binary"};
             }
 
             auto it = std::remove_if(this->targets.begin(), this->targets.end(),
@@ -160,14 +175,14 @@ namespace Network::Sockets {
                         existing.addr.sin_addr.s_addr == t.addr.sin_addr.s_addr;
                 });
             if (it == this->targets.end()) {
-                return FunctionReturn<>{ExitCode::Error, "Multicast IPv4 address not found"};
+                return Error{ErrorCode::NotFound, "Multicast IPv4 address not found"};
             }
             this->targets.erase(it, this->targets.end());
         } else {
             t.addr.sin6_family = this->family;
             t.addr.sin6_port = ::htons(port);
             if (::inet_pton(this->family, multicast_ip.c_str(), &t.addr.sin6_addr) < 0) {
-                return FunctionReturn<>{std::format("Failed converting IPv6 {} from text to binary", multicast_ip)};
+                return Error{ErrorCode::Failed, "Failed converting IPv6 multicast address from text to binary"};
             }
 
             auto it = std::remove_if(this->targets.begin(), this->targets.end(),
@@ -177,32 +192,39 @@ namespace Network::Sockets {
                         std::memcmp(&existing.addr.sin6_addr, &t.addr.sin6_addr, sizeof(::in6_addr)) == 0;
                 });
             if (it == this->targets.end()) {
-                return FunctionReturn<>{ExitCode::Error, "Multicast IPv6 address not found"};
+                return Error{ErrorCode::NotFound, "Multicast IPv6 address not found"};
             }
             this->targets.erase(it, this->targets.end());
         }
 
-        return FunctionReturn<>{};
+        return Result<>{};
+    }
+
+    template<typename T>
+    requires (std::is_same_v<T, ::sockaddr_in> || std::is_same_v<T, ::sockaddr_in6>)
+    Result<> IPMulticastSender<T>::sendTo(const std::vector<std::uint8_t>& data, const T& address) {
+        if (::sendto(this->sockFd, data.data(), data.size(), 0, reinterpret_cast<const ::sockaddr*>(&address), sizeof(address)) < 0) {
+            return Error::system("Failed sending unicast data on socket", this->sockFd);
+        }
+        return Result<>{};
     }
 
     template<typename T>
     requires (std::is_same_v<T, ::sockaddr_in> || std::is_same_v<T, ::sockaddr_in6>)
-    FunctionReturn<> IPMulticastSender<T>::send(const std::vector<std::uint8_t>& data) {
+    Result<> IPMulticastSender<T>::send(const std::vector<std::uint8_t>& data) {
         for (auto& target : targets) {
             if (target.ifindex != 0) {
                 if constexpr (std::is_same_v<T, ::sockaddr_in>) {
-                    ::in_addr local_if{};
-                    local_if.s_addr = htonl(INADDR_ANY);
+                    //ip_mreqn selects outgoing interface by index
+                    ::ip_mreqn local_if{};
+                    local_if.imr_address.s_addr = htonl(INADDR_ANY);
+                    local_if.imr_ifindex = static_cast<int>(target.ifindex);
                     if (::setsockopt(this->sockFd, IPPROTO_IP, IP_MULTICAST_IF, &local_if, sizeof(local_if)) < 0) {
-                        return FunctionReturn<>{
-                            std::format("Failed setting IPPROTO_IP, IP_MULTICAST_IF on {} socket for {} interface", this->sockFd, target.ifindex)
-                        };
+                        return Error::system("Failed setting IPPROTO_IP, IP_MULTICAST_IF for interface", target.ifindex);
                     }
                 } else {
                     if (::setsockopt(this->sockFd, IPPROTO_IPV6, IPV6_MULTICAST_IF, &target.ifindex, sizeof(target.ifindex)) < 0) {
-                        return FunctionReturn<>{
-                            std::format("Failed setting IPPROTO_IPV6, IPV6_MULTICAST_IF on {} socket for {} interface", this->sockFd, target.ifindex)
-                        };
+                        return Error::system("Failed setting IPPROTO_IPV6, IPV6_MULTICAST_IF for interface", target.ifindex);
                     }
                 }
             }
@@ -210,13 +232,51 @@ namespace Network::Sockets {
             auto* sa = reinterpret_cast<::sockaddr*>(&target.addr);
             ::socklen_t salen = static_cast<socklen_t>(sizeof(target.addr));
             if (::sendto(this->sockFd, data.data(), data.size(), 0, sa, salen) < 0) {
-                return FunctionReturn<>{
-                    std::format("Failed sending data on {} socket for {} interface", this->sockFd, target.ifindex)
-                };
+                return Error::system("Failed sending data for interface", target.ifindex);
+            }
+        }
+
+        return Result<>{};
+    }
+
+    template<typename T>
+    requires (std::is_same_v<T, ::sockaddr_in> || std::is_same_v<T, ::sockaddr_in6>)
+    Result<> IPMulticastSender<T>::send(std::shared_ptr<const std::vector<std::uint8_t>> data, IoUring& ring) {
+        for (auto& target : targets) {
+            auto message = std::make_unique<IoUring::Message>();
+            message->name.resize(sizeof(target.addr));
+            std::memcpy(message->name.data(), &target.addr, sizeof(target.addr));
+            message->payload = data;
+
+            if (target.ifindex != 0) {
+                if constexpr (std::is_same_v<T, ::sockaddr_in>) {
+                    ::in_pktinfo info{};
+                    info.ipi_ifindex = static_cast<int>(target.ifindex);
+                    message->control.resize(CMSG_SPACE(sizeof(info)));
+                    auto* cmsg = reinterpret_cast<::cmsghdr*>(message->control.data());
+                    cmsg->cmsg_level = IPPROTO_IP;
+                    cmsg->cmsg_type = IP_PKTINFO;
+                    cmsg->cmsg_len = CMSG_LEN(sizeof(info));
+                    std::memcpy(CMSG_DATA(cmsg), &info, sizeof(info));
+                } else {
+                    ::in6_pktinfo info{};
+                    info.ipi6_ifindex = target.ifindex;
+                    message->control.resize(CMSG_SPACE(sizeof(info)));
+                    auto* cmsg = reinterpret_cast<::cmsghdr*>(message->control.data());
+                    cmsg->cmsg_level = IPPROTO_IPV6;
+                    cmsg->cmsg_type = IPV6_PKTINFO;
+                    cmsg->cmsg_len = CMSG_LEN(sizeof(info));
+                    std::memcpy(CMSG_DATA(cmsg), &info, sizeof(info));
+                }
+            }
+
+            auto queueReturn = ring.sendMessage(this->sockFd, std::move(message));
+            if (!queueReturn.isOk()) {
+                return queueReturn.within("Failed queueing multicast data");
             }
         }
 
-        return FunctionReturn<>{};
+        return Result<>{};
     }
 
 }
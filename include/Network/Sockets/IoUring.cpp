@@ -0,0 +1,281 @@
+#include "IoUring.hpp"
+
+#include "Utility/Result.hpp"
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <signal.h>
+
+#include <atomic>
+#include <algorithm>
+#include <cstring>
+#include <cerrno>
+#include <string>
+
+using Network::Sockets::IoUring;
+using Utility::Result;
+using Utility::Error;
+using Utility::ErrorCode;
+
+namespace {
+    //kernel and daemon share ring indexes, they are published with release and read with acquire ordering
+    unsigned int loadAcquire(unsigned int* index) {
+        return std::atomic_ref<unsigned int>(*index).load(std::memory_order_acquire);
+    }
+
+    void storeRelease(unsigned int* index, unsigned int value) {
+        std::atomic_ref<unsigned int>(*index).store(value, std::memory_order_release);
+    }
+
+    void* map(int fd, std::size_t size, off_t offset) {
+        return ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, offset);
+    }
+}
+
+Result<IoUring> IoUring::factory(unsigned int entries, std::uint16_t bufferCount, std::uint32_t bufferSize) {
+    IoUring ring{};
+
+    ::io_uring_params params{};
+    ring.ringFd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+    if (ring.ringFd < 0) {
+        return Error::system("io_uring_setup failed");
+    }
+
+    //single mapping of both rings and timeouts passed to io_uring_enter are required
+    if (!(params.features & IORING_FEAT_SINGLE_MMAP) || !(params.features & IORING_FEAT_EXT_ARG)) {
+        return Error{ErrorCode::Unsupported, "Kernel io_uring lacks single mmap or extended enter arguments"};
+    }
+
+    ring.rings.size = std::max(params.sq_off.array + params.sq_entries * sizeof(unsigned int),
+        params.cq_off.cqes + params.cq_entries * sizeof(::io_uring_cqe));
+    ring.rings.ptr = map(ring.ringFd, ring.rings.size, IORING_OFF_SQ_RING);
+    if (ring.rings.ptr == MAP_FAILED) {
+        ring.rings = {};
+        return Error::system("Mapping io_uring rings failed");
+    }
+
+    ring.sqeMapping.size = params.sq_entries * sizeof(::io_uring_sqe);
+    ring.sqeMapping.ptr = map(ring.ringFd, ring.sqeMapping.size, IORING_OFF_SQES);
+    if (ring.sqeMapping.ptr == MAP_FAILED) {
+        ring.sqeMapping = {};
+        return Error::system("Mapping io_uring submission entries failed");
+    }
+
+    auto* base = static_cast<std::uint8_t*>(ring.rings.ptr);
+    ring.sqHead = reinterpret_cast<unsigned int*>(base + params.sq_off.head);
+    ring.sqTail = reinterpret_cast<unsigned int*>(base + params.sq_off.tail);
+    ring.sqArray = reinterpret_cast<unsigned int*>(base + params.sq_off.array);
+    ring.sqMask = *reinterpret_cast<unsigned int*>(base + params.sq_off.ring_mask);
+    ring.sqEntries = params.sq_entries;
+    ring.sqes = static_cast<::io_uring_sqe*>(ring.sqeMapping.ptr);
+
+    ring.cqHead = reinterpret_cast<unsigned int*>(base + params.cq_off.head);
+    ring.cqTail = reinterpret_cast<unsigned int*>(base + params.cq_off.tail);
+    ring.cqMask = *reinterpret_cast<unsigned int*>(base + params.cq_off.ring_mask);
+    ring.cqes = reinterpret_cast<::io_uring_cqe*>(base + params.cq_off.cqes);
+
+    auto registerReturn = ring.registerBufferRing(bufferCount, bufferSize);
+    if (!registerReturn.isOk()) {
+        return registerReturn.error();
+    }
+
+    return Result<IoUring>{std::move(ring)};
+}
+
+IoUring::~IoUring() {
+    //closing ring cancels requests still in flight, buffers are released afterwards
+    if (this->ringFd >= 0) {
+        ::close(this->ringFd);
+    }
+    for (Mapping* mapping : {&this->rings, &this->sqeMapping, &this->bufferRingMapping}) {
+        if (mapping->ptr != nullptr) {
+            ::munmap(mapping->ptr, mapping->size);
+        }
+    }
+}
+
+Result<> IoUring::registerBufferRing(std::uint16_t count, std::uint32_t size) {
+    if (count == 0 || (count & (count - 1)) != 0) {
+        return Error{ErrorCode::Failed, "Provided buffer count is not power of two, got", count};
+    }
+
+    this->bufferRingMapping.size = count * sizeof(::io_uring_buf);
+    this->bufferRingMapping.ptr = ::mmap(nullptr, this->bufferRingMapping.size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (this->bufferRingMapping.ptr == MAP_FAILED) {
+        this->bufferRingMapping = {};
+        return Error::system("Mapping provided buffer ring failed");
+    }
+    this->bufferRing = static_cast<::io_uring_buf*>(this->bufferRingMapping.ptr);
+
+    ::io_uring_buf_reg reg{};
+    reg.ring_addr = reinterpret_cast<std::uint64_t>(this->bufferRing);
+    reg.ring_entries = count;
+    reg.bgid = BUFFER_GROUP;
+    if (::syscall(__NR_io_uring_register, this->ringFd, IORING_REGISTER_PBUF_RING, &reg, 1) < 0) {
+        return Error::system("Registering provided buffer ring failed");
+    }
+
+    this->bufferCount = count;
+    this->bufferSize = size;
+    this->buffers.resize(static_cast<std::size_t>(count) * size);
+    for (std::uint16_t id = 0; id < count; id++) {
+        this->addBuffer(id);
+    }
+    return Result<>{};
+}
+
+void IoUring::addBuffer(std::uint16_t id) {
+    ::io_uring_buf& entry = this->bufferRing[this->bufferTail & (this->bufferCount - 1)];
+    entry.addr = reinterpret_cast<std::uint64_t>(this->buffers.data() + static_cast<std::size_t>(id) * this->bufferSize);
+    entry.len = this->bufferSize;
+    entry.bid = id;
+    this->bufferTail++;
+    std::atomic_ref<std::uint16_t>(this->bufferRing[0].resv).store(this->bufferTail, std::memory_order_release);
+}
+
+std::uint64_t IoUring::userData(Operation operation, std::uint32_t target, std::uint32_t id) {
+    //operation in top byte, target in next three, message id in lower half
+    return (static_cast<std::uint64_t>(operation) << 56) | (static_cast<std::uint64_t>(target & 0xFFFFFF) << 32) | id;
+}
+
+int IoUring::enter(unsigned int toSubmit, unsigned int minComplete, unsigned int flags, const void* arg, std::size_t argSize) {
+    return static_cast<int>(::syscall(__NR_io_uring_enter, this->ringFd, toSubmit, minComplete, flags, arg, argSize));
+}
+
+unsigned int IoUring::pendingSubmissions() const {
+    return *this->sqTail - loadAcquire(this->sqHead);
+}
+
+::io_uring_sqe* IoUring::acquireSqe() {
+    if (this->pendingSubmissions() >= this->sqEntries) {
+        if (this->enter(this->pendingSubmissions(), 0, 0, nullptr, 0) < 0 || this->pendingSubmissions() >= this->sqEntries) {
+            return nullptr;
+        }
+    }
+
+    unsigned int index = *this->sqTail & this->sqMask;
+    this->sqArray[index] = index;
+    ::io_uring_sqe* sqe = &this->sqes[index];
+    std::memset(sqe, 0, sizeof(*sqe));
+    return sqe;
+}
+
+void IoUring::pushSqe() {
+    storeRelease(this->sqTail, *this->sqTail + 1);
+}
+
+Result<> IoUring::receiveMultishot(int fd, const ::msghdr* header, std::uint32_t target) {
+    ::io_uring_sqe* sqe = this->acquireSqe();
+    if (sqe == nullptr) {
+        return Error{ErrorCode::Failed, "No free io_uring submission entry for receive on socket", fd};
+    }
+    sqe->opcode = IORING_OP_RECVMSG;
+    sqe->fd = fd;
+    sqe->addr = reinterpret_cast<std::uint64_t>(header);
+    sqe->len = 1;
+    sqe->ioprio = IORING_RECV_MULTISHOT;
+    sqe->flags = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = BUFFER_GROUP;
+    sqe->user_data = userData(Operation::Receive, target, 0);
+    this->pushSqe();
+    return Result<>{};
+}
+
+Result<> IoUring::acceptMultishot(int fd, std::uint32_t target) {
+    ::io_uring_sqe* sqe = this->acquireSqe();
+    if (sqe == nullptr) {
+        return Error{ErrorCode::Failed, "No free io_uring submission entry for accept on socket", fd};
+    }
+    sqe->opcode = IORING_OP_ACCEPT;
+    sqe->fd = fd;
+    sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+    sqe->user_data = userData(Operation::Accept, target, 0);
+    this->pushSqe();
+    return Result<>{};
+}
+
+Result<> IoUring::sendMessage(int fd, std::unique_ptr<Message> message) {
+    ::io_uring_sqe* sqe = this->acquireSqe();
+    if (sqe == nullptr) {
+        return Error{ErrorCode::Failed, "No free io_uring submission entry for send on socket", fd};
+    }
+
+    message->iov.iov_base = const_cast<std::uint8_t*>(message->payload->data());
+    message->iov.iov_len = message->payload->size();
+    message->header.msg_name = message->name.empty() ? nullptr : message->name.data();
+    message->header.msg_namelen = static_cast<::socklen_t>(message->name.size());
+    message->header.msg_iov = &message->iov;
+    message->header.msg_iovlen = 1;
+    message->header.msg_control = message->control.empty() ? nullptr : message->control.data();
+    message->header.msg_controllen = message->control.size();
+
+    std::uint32_t id = this->nextMessageId++;
+    sqe->opcode = IORING_OP_SENDMSG;
+    sqe->fd = fd;
+    sqe->addr = reinterpret_cast<std::uint64_t>(&message->header);
+    sqe->len = 1;
+    sqe->user_data = userData(Operation::Send, 0, id);
+    this->messages[id] = std::move(message);
+    this->pushSqe();
+    return Result<>{};
+}
+
+Result<> IoUring::submit() {
+    unsigned int toSubmit = this->pendingSubmissions();
+    if (toSubmit > 0 && this->enter(toSubmit, 0, 0, nullptr, 0) < 0 && errno != EINTR && errno != EBUSY) {
+        return Error::system("io_uring_enter failed");
+    }
+    return Result<>{};
+}
+
+Result<std::vector<IoUring::Completion>> IoUring::wait(int timeoutMs) {
+    unsigned int toSubmit = this->pendingSubmissions();
+    if (timeoutMs > 0 || toSubmit > 0) {
+        ::__kernel_timespec timeout{};
+        timeout.tv_sec = timeoutMs / 1000;
+        timeout.tv_nsec = static_cast<long long>(timeoutMs % 1000) * 1000000;
+
+        ::io_uring_getevents_arg arg{};
+        arg.sigmask_sz = _NSIG / 8;
+        arg.ts = reinterpret_cast<std::uint64_t>(&timeout);
+
+        unsigned int minComplete = timeoutMs > 0 ? 1 : 0;
+        unsigned int flags = IORING_ENTER_EXT_ARG | (minComplete > 0 ? IORING_ENTER_GETEVENTS : 0);
+        //expired timeout and interruption only end waiting
+        if (this->enter(toSubmit, minComplete, flags, &arg, sizeof(arg)) < 0 && errno != ETIME && errno != EINTR && errno != EBUSY) {
+            return Error::system("io_uring_enter failed");
+        }
+    }
+
+    std::vector<Completion> completions{};
+    unsigned int head = *this->cqHead;
+    unsigned int tail = loadAcquire(this->cqTail);
+    for (; head != tail; head++) {
+        const ::io_uring_cqe& cqe = this->cqes[head & this->cqMask];
+        Completion completion{};
+        completion.operation = static_cast<Operation>(cqe.user_data >> 56);
+        completion.target = static_cast<std::uint32_t>((cqe.user_data >> 32) & 0xFFFFFF);
+        completion.result = cqe.res;
+        completion.flags = cqe.flags;
+        if (completion.operation == Operation::Send) {
+            this->messages.erase(static_cast<std::uint32_t>(cqe.user_data));
+        }
+        completions.push_back(completion);
+    }
+    storeRelease(this->cqHead, head);
+
+    return Result<std::vector<Completion>>{std::move(completions)};
+}
+
+std::span<const std::uint8_t> IoUring::buffer(const Completion& completion) const {
+    std::size_t size = std::min<std::size_t>(completion.result > 0 ? completion.result : 0, this->bufferSize);
+    return std::span<const std::uint8_t>(this->buffers.data() + static_cast<std::size_t>(completion.bufferId()) * this->bufferSize, size);
+}
+
+void IoUring::recycle(const Completion& completion) {
+    if (completion.hasBuffer()) {
+        this->addBuffer(completion.bufferId());
+    }
+}
@@ -0,0 +1,153 @@
+#pragma once
+#ifndef IOURING_HPP
+#define IOURING_HPP
+
+#include "Utility/Result.hpp"
+
+#include <linux/io_uring.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <memory>
+#include <span>
+#include <unordered_map>
+#include <utility>
+
+using Utility::Result;
+using Utility::Error;
+using Utility::ErrorCode;
+
+namespace Network::Sockets {
+    //io_uring instance driven by raw syscalls, multishot receives take buffers from single provided buffer ring
+    class IoUring {
+    public:
+        enum class Operation : std::uint8_t {
+            Receive,
+            Accept,
+            Send
+        };
+
+        struct Completion {
+            Operation operation{};
+            //chosen by caller when arming receive or accept, unused for sends
+            std::uint32_t target{};
+            int result{};
+            std::uint32_t flags{};
+
+            //multishot request stays armed only while kernel reports more completions
+            bool more() const {
+                return (this->flags & IORING_CQE_F_MORE) != 0;
+            }
+
+            bool hasBuffer() const {
+                return (this->flags & IORING_CQE_F_BUFFER) != 0;
+            }
+
+            std::uint16_t bufferId() const {
+                return static_cast<std::uint16_t>(this->flags >> IORING_CQE_BUFFER_SHIFT);
+            }
+        };
+
+        //datagram queued for sendmsg, owned by ring until its completion arrives
+        struct Message {
+            std::vector<std::uint8_t> name{};
+            std::vector<std::uint8_t> control{};
+            //shared by all messages carrying the same frame
+            std::shared_ptr<const std::vector<std::uint8_t>> payload{};
+            ::iovec iov{};
+            ::msghdr header{};
+        };
+
+    private:
+        static constexpr std::uint16_t BUFFER_GROUP = 0;
+
+        struct Mapping {
+            void* ptr = nullptr;
+            std::size_t size = 0;
+        };
+
+        int ringFd{-1};
+        Mapping rings{};
+        Mapping sqeMapping{};
+        Mapping bufferRingMapping{};
+
+        unsigned int* sqHead = nullptr;
+        unsigned int* sqTail = nullptr;
+        unsigned int* sqArray = nullptr;
+        unsigned int sqMask = 0;
+        unsigned int sqEntries = 0;
+        ::io_uring_sqe* sqes = nullptr;
+
+        unsigned int* cqHead = nullptr;
+        unsigned int* cqTail = nullptr;
+        unsigned int cqMask = 0;
+        ::io_uring_cqe* cqes = nullptr;
+
+        //tail of provided buffer ring overlays reserved field of its first entry
+        ::io_uring_buf* bufferRing = nullptr;
+        std::uint16_t bufferTail = 0;
+        std::uint16_t bufferCount = 0;
+        std::uint32_t bufferSize = 0;
+        std::vector<std::uint8_t> buffers{};
+
+        std::unordered_map<std::uint32_t, std::unique_ptr<Message>> messages{};
+        std::uint32_t nextMessageId = 0;
+
+        IoUring() = default;
+
+        int enter(unsigned int toSubmit, unsigned int minComplete, unsigned int flags, const void* arg, std::size_t argSize);
+        //submits queued entries to make room if submission queue is full
+        ::io_uring_sqe* acquireSqe();
+        void pushSqe();
+        void addBuffer(std::uint16_t id);
+        Result<> registerBufferRing(std::uint16_t count, std::uint32_t size);
+        unsigned int pendingSubmissions() const;
+
+        static std::uint64_t userData(Operation operation, std::uint32_t target, std::uint32_t id);
+
+    public:
+        ~IoUring();
+
+        //bufferCount has to be power of two, bufferSize has to fit whole multishot recvmsg result
+        static Result<IoUring> factory(unsigned int entries, std::uint16_t bufferCount, std::uint32_t bufferSize);
+
+        //header supplies only name and control lengths, payload goes to provided buffers
+        Result<> receiveMultishot(int fd, const ::msghdr* header, std::uint32_t target);
+        Result<> acceptMultishot(int fd, std::uint32_t target);
+        Result<> sendMessage(int fd, std::unique_ptr<Message> message);
+
+        //hands queued requests to kernel without waiting for completions
+        Result<> submit();
+
+        //submits queued requests and waits up to timeoutMs for first completion, 0 only reaps ready ones without syscall if nothing is queued
+        Result<std::vector<Completion>> wait(int timeoutMs);
+
+        //provided buffer of receive completion, valid until recycled
+        std::span<const std::uint8_t> buffer(const Completion& completion) const;
+        void recycle(const Completion& completion);
+
+        //readable while completions are waiting, lets ring be awaited like a socket
+        int fd() const {
+            return this->ringFd;
+        }
+
+        IoUring(const IoUring&) = delete;
+        IoUring& operator=(const IoUring&) = delete;
+
+        IoUring(IoUring&& other)
+            : ringFd{std::exchange(other.ringFd, -1)}, rings{std::exchange(other.rings, {})},
+            sqeMapping{std::exchange(other.sqeMapping, {})}, bufferRingMapping{std::exchange(other.bufferRingMapping, {})},
+            sqHead{other.sqHead}, sqTail{other.sqTail}, sqArray{other.sqArray}, sqMask{other.sqMask}, sqEntries{other.sqEntries}, sqes{other.sqes},
+            cqHead{other.cqHead}, cqTail{other.cqTail}, cqMask{other.cqMask}, cqes{other.cqes},
+            bufferRing{other.bufferRing}, bufferTail{other.bufferTail}, bufferCount{other.bufferCount}, bufferSize{other.bufferSize},
+            buffers{std::move(other.buffers)}, messages{std::move(other.messages)}, nextMessageId{other.nextMessageId} {
+        }
+
+        IoUring& operator=(IoUring&&) = delete;
+    };
+}
+
+#endif
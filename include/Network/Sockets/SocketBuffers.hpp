@@ -0,0 +1,39 @@
+#pragma once
+#ifndef SOCKETBUFFERS_HPP
+#define SOCKETBUFFERS_HPP
+
+#include "Utility/Result.hpp"
+
+#include <sys/socket.h>
+
+using Utility::Result;
+using Utility::Error;
+
+namespace Network::Sockets {
+    //kernel socket queue sizing shared by multicast senders and receivers
+    class SocketBuffers {
+    public:
+        //force option lifts net.core.rmem_max/wmem_max limit but needs CAP_NET_ADMIN, plain option is tried without it
+        //returns size kernel reports afterwards, which is double of requested bytes for its bookkeeping
+        static Result<int> resize(int sockFd, bool receive, int bytes) {
+            int forceOption = receive ? SO_RCVBUFFORCE : SO_SNDBUFFORCE;
+            int option = receive ? SO_RCVBUF : SO_SNDBUF;
+            if (::setsockopt(sockFd, SOL_SOCKET, forceOption, &bytes, sizeof(bytes)) < 0
+                && ::setsockopt(sockFd, SOL_SOCKET, option, &bytes, sizeof(bytes)) < 0) {
+                return Error::system(receive ? "Failed setting SO_RCVBUF on socket" : "Failed setting SO_SNDBUF on socket", sockFd);
+            }
+            return size(sockFd, receive);
+        }
+
+        static Result<int> size(int sockFd, bool receive) {
+            int bytes = 0;
+            ::socklen_t length = sizeof(bytes);
+            if (::getsockopt(sockFd, SOL_SOCKET, receive ? SO_RCVBUF : SO_SNDBUF, &bytes, &length) < 0) {
+                return Error::system("Failed reading buffer size of socket", sockFd);
+            }
+            return Result<int>{bytes};
+        }
+    };
+}
+
+#endif
@@ -50,7 +50,7 @@ bool Process::daemonize() {
 }
 
 void Process::run() {
-    //exit from loop happens externally by OS (Ctr+C, kill etc.)
+    //exit from loop happens on stop() or externally by OS (kill -9 etc.)
     if (this->processIterationFunction) {
         do {
             auto start = std::chrono::high_resolution_clock::now();
@@ -64,9 +64,13 @@ void Process::run() {
             //not sure of std::this_thread usage
             //std::this_thread::sleep_for(std::chrono::seconds(secondsToWait);
             if (this->cyclic && (secondsToWait > 0)) {
-                ::sleep(secondsToWait);
+                if (this->waitFunction) {
+                    this->waitFunction(static_cast<unsigned int>(secondsToWait));
+                } else {
+                    ::sleep(secondsToWait);
+                }
             }
 
-        } while(this->cyclic);
+        } while(this->cyclic && !this->stopRequested);
     }
 }
\ No newline at end of file
@@ -14,6 +14,8 @@ namespace Processes {
         unsigned int iterationPeriodS;
         std::string logPath;
         std::function<void()> processIterationFunction;
+        std::function<void(unsigned int)> waitFunction;
+        std::atomic<bool> stopRequested = false;
 
         Process(bool cyclic, unsigned int iterationPeriodS, const std::string& logPath, const std::function<void()>& processIterationFunction) 
             : cyclic{cyclic}, iterationPeriodS{iterationPeriodS}, logPath{logPath}, processIterationFunction{processIterationFunction} {}
@@ -29,8 +31,22 @@ namespace Processes {
 
         //daemonizes process, redirects std::cout to file specified in log Path
         bool daemonize();
-        //runs the passed function every passed period
+        //runs the passed function every passed period until stop() is called
         void run();
+        //run() returns after current iteration and wait
+        void stop() {
+            this->stopRequested = true;
+        }
+
+        //takes effect from next iteration
+        void setIterationPeriod(unsigned int iterationPeriodS) {
+            this->iterationPeriodS = iterationPeriodS;
+        }
+
+        //called with seconds left until next iteration instead of sleeping, has to return once they pass
+        void setWaitFunction(const std::function<void(unsigned int)>& waitFunction) {
+            this->waitFunction = waitFunction;
+        }
     };
 }
 
@@ -0,0 +1,171 @@
+#include "DiscoveryClient.hpp"
+
+#include "Network/Protocol/Frame.hpp"
+#include "Utility/Serialization/Deserializer.hpp"
+#include "Utility/Result.hpp"
+
+#include <poll.h>
+
+#include <string>
+#include <vector>
+#include <span>
+#include <chrono>
+#include <algorithm>
+#include <cerrno>
+
+using Unix::DiscoveryClient;
+using Unix::DiscoveryResponse;
+using Network::Protocol::Frame;
+using Utility::Serialization::Deserializer;
+using Utility::Result;
+using Utility::Error;
+using Utility::ErrorCode;
+
+Result<DiscoveryClient> DiscoveryClient::connect(const std::string& path, bool requireChecksum, std::size_t readSize) {
+    auto funcReturn = UnixSocket::clientFactory(path);
+    if (!funcReturn.isOk()) {
+        return funcReturn.within("Failed opening UNIX domain socket");
+    }
+
+    return Result<DiscoveryClient>{DiscoveryClient{std::move(funcReturn).value(), requireChecksum, readSize}};
+}
+
+Result<std::uint64_t> DiscoveryClient::send(const UnixRequest& request) {
+    //daemon splits pipelined requests by newlines
+    this->unsent += request.toString() + "\n";
+    std::uint64_t id = this->nextId++;
+    this->inFlight.push_back(id);
+
+    auto flushReturn = this->flush();
+    if (!flushReturn.isOk()) {
+        return flushReturn.within("Failed sending request");
+    }
+    return Result<std::uint64_t>{id};
+}
+
+Result<> DiscoveryClient::flush() {
+    while (!this->unsent.empty()) {
+        auto sendReturn = this->socket.sendSome(std::span<const std::uint8_t>(reinterpret_cast<const std::uint8_t*>(this->unsent.data()), this->unsent.size()));
+        if (!sendReturn.isOk()) {
+            return sendReturn.error();
+        }
+        if (sendReturn.value() == 0) {
+            break;
+        }
+        this->unsent.erase(0, sendReturn.value());
+    }
+    return Result<>{};
+}
+
+Result<> DiscoveryClient::readAvailable() {
+    while (true) {
+        auto receiveReturn = this->socket.receiveSome(this->readBuffer);
+        if (!receiveReturn.isOk()) {
+            return receiveReturn.error();
+        }
+        if (receiveReturn.value() == 0) {
+            return Result<>{};
+        }
+        this->stream.insert(this->stream.end(), this->readBuffer.begin(), this->readBuffer.begin() + receiveReturn.value());
+    }
+}
+
+Result<> DiscoveryClient::extractResponses() {
+    for (auto frameSize = Frame::size(this->stream); frameSize.has_value() && this->stream.size() >= frameSize.value(); frameSize = Frame::size(this->stream)) {
+        if (this->inFlight.empty()) {
+            return Error{ErrorCode::Failed, "Received response to no request"};
+        }
+
+        DiscoveryResponse response{};
+        response.id = this->inFlight.front();
+        this->inFlight.pop_front();
+        response.buff.assign(this->stream.begin(), this->stream.begin() + frameSize.value());
+        this->stream.erase(this->stream.begin(), this->stream.begin() + frameSize.value());
+
+        Frame::MessageType type = Frame::messageType(response.buff);
+        auto frameReturn = Frame::open(response.buff, this->requireChecksum);
+        if (!frameReturn.isOk()) {
+            response.error = "Received corrupted data from daemon: " + frameReturn.message();
+        } else {
+            response.offset = frameReturn.value().offset;
+            if (type == Frame::MessageType::Error) {
+                std::size_t offset = response.offset;
+                auto messageReturn = Deserializer::deserialize(response.buff, offset);
+                response.error = messageReturn.isOk() ? std::move(messageReturn).value() : "Daemon couldn't serve request";
+            }
+        }
+        this->completed.push_back(std::move(response));
+    }
+    return Result<>{};
+}
+
+Result<std::vector<DiscoveryResponse>> DiscoveryClient::process() {
+    auto flushReturn = this->flush();
+    if (!flushReturn.isOk()) {
+        return flushReturn.within("Failed sending request");
+    }
+
+    //responses that arrived before connection closed are still handed out
+    auto readReturn = this->readAvailable();
+    auto extractReturn = this->extractResponses();
+    if (!extractReturn.isOk()) {
+        return extractReturn.within("Failed receiving response");
+    }
+    if (!readReturn.isOk() && this->completed.empty()) {
+        return readReturn.within("Failed receiving response");
+    }
+
+    std::vector<DiscoveryResponse> responses(std::make_move_iterator(this->completed.begin()), std::make_move_iterator(this->completed.end()));
+    this->completed.clear();
+    return Result<std::vector<DiscoveryResponse>>{std::move(responses)};
+}
+
+Result<DiscoveryResponse> DiscoveryClient::receive(std::uint64_t id, std::chrono::milliseconds timeout) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (true) {
+        auto flushReturn = this->flush();
+        if (!flushReturn.isOk()) {
+            return flushReturn.within("Failed sending request");
+        }
+        auto readReturn = this->readAvailable();
+        auto extractReturn = this->extractResponses();
+        if (!extractReturn.isOk()) {
+            return extractReturn.within("Failed receiving response");
+        }
+
+        auto it = std::ranges::find(this->completed, id, &DiscoveryResponse::id);
+        if (it != this->completed.end()) {
+            DiscoveryResponse response = std::move(*it);
+            this->completed.erase(it);
+            return Result<DiscoveryResponse>{std::move(response)};
+        }
+        if (!readReturn.isOk()) {
+            return readReturn.within("Failed receiving response");
+        }
+        if (std::ranges::find(this->inFlight, id) == this->inFlight.end()) {
+            return Error{ErrorCode::NotFound, "No request is waiting for response with id", static_cast<std::int64_t>(id)};
+        }
+
+        auto left = std::chrono::ceil<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+        if (left.count() <= 0) {
+            return Error{ErrorCode::Failed, "Timed out waiting for response"};
+        }
+
+        ::pollfd pfd{this->fd(), this->events(), 0};
+        if (::poll(&pfd, 1, static_cast<int>(left.count())) < 0 && errno != EINTR) {
+            return Error::system("poll() failed on socket", this->fd());
+        }
+    }
+}
+
+Result<DiscoveryResponse> DiscoveryClient::request(const UnixRequest& request, std::chrono::milliseconds timeout) {
+    auto sendReturn = this->send(request);
+    if (!sendReturn.isOk()) {
+        return sendReturn.error();
+    }
+    return this->receive(sendReturn.value(), timeout);
+}
+
+short DiscoveryClient::events() const {
+    return this->unsent.empty() ? POLLIN : POLLIN | POLLOUT;
+}
@@ -0,0 +1,80 @@
+#pragma once
+#ifndef DISCOVERYCLIENT_HPP
+#define DISCOVERYCLIENT_HPP
+
+#include "UnixSocket.hpp"
+#include "UnixRequest.hpp"
+#include "Utility/Result.hpp"
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <optional>
+
+using Utility::Result;
+
+namespace Unix {
+    //opened response frame, payload starts at offset
+    struct DiscoveryResponse {
+        std::uint64_t id{};
+        std::vector<std::uint8_t> buff{};
+        std::size_t offset{};
+        //set if daemon couldn't serve the request
+        std::optional<std::string> error{};
+    };
+
+    //persistent connection to daemon, requests can be pipelined and responses arrive in order requests were sent
+    //blocking calls wait with poll(), async users wait on fd() for events() themselves and call process()
+    class DiscoveryClient {
+    private:
+        UnixSocket socket;
+        bool requireChecksum;
+        //reused for every read, received bytes wait in stream until whole frame is there
+        std::vector<std::uint8_t> readBuffer;
+        std::vector<std::uint8_t> stream{};
+        std::string unsent{};
+        //ids of sent requests still waiting for response, oldest first
+        std::deque<std::uint64_t> inFlight{};
+        std::deque<DiscoveryResponse> completed{};
+        std::uint64_t nextId = 1;
+
+        DiscoveryClient(UnixSocket socket, bool requireChecksum, std::size_t readSize)
+            : socket{std::move(socket)}, requireChecksum{requireChecksum}, readBuffer(readSize) {}
+
+        Result<> flush();
+        Result<> readAvailable();
+        Result<> extractResponses();
+
+    public:
+        static Result<DiscoveryClient> connect(const std::string& path, bool requireChecksum, std::size_t readSize);
+
+        //queues request and sends as much of it as socket takes, returns id its response will carry
+        Result<std::uint64_t> send(const UnixRequest& request);
+
+        //non blocking, sends queued requests and reads arrived data, returns responses completed so far
+        Result<std::vector<DiscoveryResponse>> process();
+
+        //blocks until response to request with passed id arrives or timeout passes, other responses are kept for later
+        Result<DiscoveryResponse> receive(std::uint64_t id, std::chrono::milliseconds timeout);
+
+        //send followed by receive of its response
+        Result<DiscoveryResponse> request(const UnixRequest& request, std::chrono::milliseconds timeout);
+
+        int fd() const {
+            return this->socket.fd();
+        }
+
+        //poll() events to wait for, writability matters only while requests are queued
+        short events() const;
+
+        //requests sent without response received yet
+        std::size_t pending() const {
+            return this->inFlight.size();
+        }
+    };
+}
+
+#endif
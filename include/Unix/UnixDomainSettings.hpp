@@ -9,8 +9,21 @@ namespace Unix {
     class UnixDomainSettings {
     public:
         std::string requestString;
+        std::string eventsRequestString;
+        std::string shardsRequestString;
+        std::string latencyRequestString;
+        std::string lossRequestString;
+        std::string pageRequestString;
+        std::string reloadRequestString;
+        unsigned int maxPageSize;
+        unsigned int pageScanLimit;
+        unsigned int maxRequestSize;
+        unsigned int requestTimeoutMs;
+        unsigned int idleTimeoutS;
         unsigned int maxBufferSize;
         std::string socketPath;
+        bool useChecksum;
+        unsigned int compressionThreshold;
     };
 }
 
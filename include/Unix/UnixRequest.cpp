@@ -0,0 +1,39 @@
+#include "UnixRequest.hpp"
+
+#include "Utility/Result.hpp"
+
+#include <string>
+#include <sstream>
+
+using Unix::UnixRequest;
+using Utility::Result;
+using Utility::Error;
+using Utility::ErrorCode;
+
+std::string UnixRequest::toString() const {
+    std::string text = this->command;
+    for (const auto& [key, value] : this->options) {
+        text += " " + key + "=" + value;
+    }
+    return text;
+}
+
+Result<UnixRequest> UnixRequest::parse(const std::string& text) {
+    std::istringstream stream(text);
+    UnixRequest request;
+
+    if (!(stream >> request.command)) {
+        return Error{ErrorCode::Failed, "Empty request"};
+    }
+
+    std::string token;
+    while (stream >> token) {
+        auto separator = token.find('=');
+        if (separator == std::string::npos || separator == 0) {
+            return Error{ErrorCode::Failed, "Malformed request option", token};
+        }
+        request.options[token.substr(0, separator)] = token.substr(separator + 1);
+    }
+
+    return Result<UnixRequest>{std::move(request)};
+}
@@ -0,0 +1,32 @@
+#pragma once
+#ifndef UNIXREQUEST_HPP
+#define UNIXREQUEST_HPP
+
+#include "Utility/Result.hpp"
+
+#include <string>
+#include <map>
+#include <optional>
+
+using Utility::Result;
+
+namespace Unix {
+    //request sent over UNIX domain socket, command followed by space separated key=value options
+    struct UnixRequest {
+        std::string command;
+        std::map<std::string, std::string> options;
+
+        std::optional<std::string> option(const std::string& key) const {
+            auto it = this->options.find(key);
+            if (it == this->options.end()) {
+                return std::nullopt;
+            }
+            return it->second;
+        }
+
+        std::string toString() const;
+        static Result<UnixRequest> parse(const std::string& text);
+    };
+}
+
+#endif
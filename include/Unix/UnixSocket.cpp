@@ -1,6 +1,6 @@
 #include "UnixSocket.hpp"
 
-#include "Utility/FunctionReturn.hpp"
+#include "Utility/Result.hpp"
 
 #include <sys/socket.h>
 #include <sys/un.h>
@@ -13,15 +13,16 @@
 #include <vector>
 
 using Unix::UnixSocket;
-using Utility::FunctionReturn;
-using Utility::ExitCode;
+using Utility::Result;
+using Utility::Error;
+using Utility::ErrorCode;
 
-FunctionReturn<UnixSocket> UnixSocket::serverFactory(const std::string& path) {
+Result<UnixSocket> UnixSocket::serverFactory(const std::string& path) {
     ::unlink(path.c_str());
 
     int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0);
     if (fd < 0) {
-        return FunctionReturn<UnixSocket>{ExitCode::Error, "socket(AF_UNIX, SOCK_STREAM) failed"};
+        return Error::system("socket(AF_UNIX, SOCK_STREAM) failed");
     }
 
     sockaddr_un addr{};
@@ -29,38 +30,56 @@ FunctionReturn<UnixSocket> UnixSocket::serverFactory(const std::string& path) {
     std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
 
     if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        auto error = Error::system("bind() failed for", path);
         ::close(fd);
-        return FunctionReturn<UnixSocket>{ExitCode::Error, "bind() failed"};
+        return error;
     }
 
     if (::listen(fd, SOMAXCONN) < 0) {
+        auto error = Error::system("listen() failed for", path);
         ::close(fd);
-        return {ExitCode::Error, "listen() failed"};
+        return error;
     }
 
-    return FunctionReturn<UnixSocket>{ UnixSocket{fd, path, true} };
+    return Result<UnixSocket>{ UnixSocket{fd, path, true} };
 }
 
 // accepts a single client and returns a connected UnixSocket
-FunctionReturn<UnixSocket> UnixSocket::acceptClient() {
+Result<UnixSocket> UnixSocket::acceptClient() {
     if (!this->isServer || this->sockFd < 0) {
-        return {ExitCode::Error, "acceptClient() called on non-server socket"};
+        return Error{ErrorCode::Failed, "acceptClient() called on non-server socket", this->sockFd};
     }
 
-    int cfd = ::accept(this->sockFd, nullptr, nullptr);
+    //responses are written as socket buffer drains, so slow reader doesn't block daemon
+    int cfd = ::accept4(this->sockFd, nullptr, nullptr, SOCK_NONBLOCK);
     if (cfd < 0) {
-        return {ExitCode::Error, "accept() failed"};
+        return Error::system("accept() failed on socket", this->sockFd);
     }
 
     // client connection doesn't own a path
-    return FunctionReturn<UnixSocket>{ UnixSocket{cfd, "", false} };
+    return Result<UnixSocket>{ UnixSocket{cfd, "", false} };
+}
+
+Result<UnixSocket> UnixSocket::acceptedFactory(int fd) {
+    if (fd < 0) {
+        return Error{ErrorCode::Failed, "acceptedFactory() called with invalid descriptor", fd};
+    }
+
+    int flags = ::fcntl(fd, F_GETFL);
+    if (flags < 0 || ::fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0) {
+        auto error = Error::system("fcntl(O_NONBLOCK) failed on socket", fd);
+        ::close(fd);
+        return error;
+    }
+
+    return Result<UnixSocket>{ UnixSocket{fd, "", false} };
 }
 
 // connect to a UNIX domain socket
-FunctionReturn<UnixSocket> UnixSocket::clientFactory(const std::string& path) {
+Result<UnixSocket> UnixSocket::clientFactory(const std::string& path) {
     int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0);
     if (fd < 0) {
-        return {ExitCode::Error, "socket(AF_UNIX, SOCK_STREAM) failed"};
+        return Error::system("socket(AF_UNIX, SOCK_STREAM) failed");
     }
 
     sockaddr_un addr{};
@@ -68,18 +87,50 @@ FunctionReturn<UnixSocket> UnixSocket::clientFactory(const std::string& path) {
     std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
 
     if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        auto error = Error::system("connect() failed for", path);
         ::close(fd);
-        return {ExitCode::Error, "connect() failed"};
+        return error;
     }
 
-    return FunctionReturn<UnixSocket>{ UnixSocket{fd, "", false} };
+    return Result<UnixSocket>{ UnixSocket{fd, "", false} };
 }
 
 
+Result<UnixSocket> UnixSocket::adoptedServerFactory(int fd, const std::string& path) {
+    if (fd < 0) {
+        return Error{ErrorCode::Failed, "adoptedServerFactory() called with invalid descriptor", fd};
+    }
+
+    int listening = 0;
+    ::socklen_t length = sizeof(listening);
+    if (::getsockopt(fd, SOL_SOCKET, SO_ACCEPTCONN, &listening, &length) < 0 || listening == 0) {
+        ::close(fd);
+        return Error{ErrorCode::Failed, "Adopted descriptor is not a listening socket", fd};
+    }
+
+    //running daemon could have been configured with other socket path
+    sockaddr_un addr{};
+    ::socklen_t addrLength = sizeof(addr);
+    if (::getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &addrLength) < 0 || addr.sun_family != AF_UNIX
+        || std::strncmp(addr.sun_path, path.c_str(), sizeof(addr.sun_path)) != 0) {
+        ::close(fd);
+        return Error{ErrorCode::Failed, "Adopted socket isn't bound to", path};
+    }
+
+    int flags = ::fcntl(fd, F_GETFL);
+    if (flags < 0 || ::fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0) {
+        auto error = Error::system("fcntl(O_NONBLOCK) failed on socket", fd);
+        ::close(fd);
+        return error;
+    }
+
+    return Result<UnixSocket>{ UnixSocket{fd, path, true} };
+}
+
 // sends entire buffer;
-FunctionReturn<> UnixSocket::send(const std::vector<std::uint8_t>& buff) {
+Result<> UnixSocket::send(const std::vector<std::uint8_t>& buff) {
     if (this->sockFd < 0) {
-        return {ExitCode::Error, "invalid socket"};
+        return Error{ErrorCode::Failed, "Invalid socket"};
     }
     const std::uint8_t* p = buff.data();
     size_t left = buff.size();
@@ -90,20 +141,20 @@ FunctionReturn<> UnixSocket::send(const std::vector<std::uint8_t>& buff) {
             if (errno == EINTR) {
                 continue;
             } 
-            return {ExitCode::Error, "write() failed"};
+            return Error::system("write() failed on socket", this->sockFd);
         } else if (n == 0) {
-            return {ExitCode::Error, "write() returned 0"};
+            return Error{ErrorCode::Failed, "write() returned 0 on socket", this->sockFd};
         }
         p += n;
         left -= static_cast<size_t>(n);
     }
-    return {ExitCode::Ok};
+    return Result<>{};
 }
 
 //sends string (command)
-FunctionReturn<> UnixSocket::send(const std::string& s) {
+Result<> UnixSocket::send(const std::string& s) {
     if (this->sockFd < 0) {
-        return {ExitCode::Error, "invalid socket"};
+        return Error{ErrorCode::Failed, "Invalid socket"};
     }
     const char* p = s.data();
     size_t left = s.size();
@@ -113,19 +164,19 @@ FunctionReturn<> UnixSocket::send(const std::string& s) {
             if (errno == EINTR) {
                 continue;
             }
-            return {ExitCode::Error, "write() failed"};
+            return Error::system("write() failed on socket", this->sockFd);
         }
-        if (n == 0) return {ExitCode::Error, "write() returned 0"};
+        if (n == 0) return Error{ErrorCode::Failed, "write() returned 0 on socket", this->sockFd};
         p += n;
         left -= static_cast<size_t>(n);
     }
-    return {};
+    return Result<>{};
 }
 
 // Receive up to maxBytes into a std::string (blocking once)
-FunctionReturn<std::string> UnixSocket::receiveString(std::size_t maxBytes) {
+Result<std::string> UnixSocket::receiveString(std::size_t maxBytes) {
     if (this->sockFd < 0) {
-        return {ExitCode::Error, "invalid socket"};
+        return Error{ErrorCode::Failed, "Invalid socket"};
     }
 
     std::string out;
@@ -135,20 +186,20 @@ FunctionReturn<std::string> UnixSocket::receiveString(std::size_t maxBytes) {
         if (errno == EINTR) {
             return receiveString(maxBytes);
         }
-        return {ExitCode::Error, "read() failed"};
+        return Error::system("read() failed on socket", this->sockFd);
     }
     if (n == 0) {
         out.clear();
-        return {std::move(out)};
+        return Result<std::string>{std::move(out)};
     }
     out.resize(static_cast<std::size_t>(n));
-    return {std::move(out)};
+    return Result<std::string>{std::move(out)};
 }
 
 // receive up to maxBytes into a byte vector (blocking once)
-FunctionReturn<void> UnixSocket::receive(std::vector<std::uint8_t>& buff) {
+Result<> UnixSocket::receive(std::vector<std::uint8_t>& buff) {
     if (this->sockFd < 0) {
-        return {ExitCode::Error, "invalid socket"};
+        return Error{ErrorCode::Failed, "Invalid socket"};
     }
 
     ssize_t n = ::read(this->sockFd, buff.data(), buff.size());
@@ -159,14 +210,149 @@ FunctionReturn<void> UnixSocket::receive(std::vector<std::uint8_t>& buff) {
             return this->receive(buff);
         } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
             buff.clear();
-            return {ExitCode::Ok};
+            return Result<>{};
         }
-        return {ExitCode::Error, "read() failed: " + std::string(::strerror(errno))};
+        return Error::system("read() failed on socket", this->sockFd);
     } else if (n == 0) {
         buff.clear();
-        return {ExitCode::Ok};
+        return Result<>{};
     }
 
     buff.resize(static_cast<std::size_t>(n));
-    return {ExitCode::Ok};
-}
\ No newline at end of file
+    return Result<>{};
+}
+Result<std::size_t> UnixSocket::sendSome(std::span<const std::uint8_t> buff) {
+    if (this->sockFd < 0) {
+        return Error{ErrorCode::Failed, "Invalid socket"};
+    }
+
+    while (true) {
+        //MSG_NOSIGNAL keeps peer that went away from killing process with SIGPIPE
+        ssize_t n = ::send(this->sockFd, buff.data(), buff.size(), MSG_NOSIGNAL);
+        if (n >= 0) {
+            return Result<std::size_t>{static_cast<std::size_t>(n)};
+        }
+        if (errno == EINTR) {
+            continue;
+        }
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            return Result<std::size_t>{std::size_t{0}};
+        }
+        return Error::system("send() failed on socket", this->sockFd);
+    }
+}
+
+Result<std::size_t> UnixSocket::receiveSome(std::span<std::uint8_t> buff) {
+    if (this->sockFd < 0) {
+        return Error{ErrorCode::Failed, "Invalid socket"};
+    }
+
+    while (true) {
+        ssize_t n = ::read(this->sockFd, buff.data(), buff.size());
+        if (n > 0) {
+            return Result<std::size_t>{static_cast<std::size_t>(n)};
+        }
+        if (n == 0) {
+            return Error{ErrorCode::Failed, "Connection closed by peer on socket", this->sockFd};
+        }
+        if (errno == EINTR) {
+            continue;
+        }
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            return Result<std::size_t>{std::size_t{0}};
+        }
+        return Error::system("read() failed on socket", this->sockFd);
+    }
+}
+
+Result<std::size_t> UnixSocket::sendSomeWithDescriptors(std::span<const std::uint8_t> buff, const std::vector<int>& fds) {
+    if (this->sockFd < 0) {
+        return Error{ErrorCode::Failed, "Invalid socket"};
+    }
+    if (buff.empty() || fds.size() > MAX_PASSED_DESCRIPTORS) {
+        return Error{ErrorCode::Overflow, "Descriptors need at least one byte to travel with, count", static_cast<std::int64_t>(fds.size())};
+    }
+
+    ::iovec iov{const_cast<std::uint8_t*>(buff.data()), buff.size()};
+    alignas(::cmsghdr) char control[CMSG_SPACE(sizeof(int) * MAX_PASSED_DESCRIPTORS)]{};
+    ::msghdr msg{};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    if (!fds.empty()) {
+        msg.msg_control = control;
+        msg.msg_controllen = CMSG_SPACE(sizeof(int) * fds.size());
+        ::cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_RIGHTS;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(int) * fds.size());
+        std::memcpy(CMSG_DATA(cmsg), fds.data(), sizeof(int) * fds.size());
+    }
+
+    while (true) {
+        ssize_t n = ::sendmsg(this->sockFd, &msg, MSG_NOSIGNAL);
+        if (n >= 0) {
+            return Result<std::size_t>{static_cast<std::size_t>(n)};
+        }
+        if (errno == EINTR) {
+            continue;
+        }
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            return Result<std::size_t>{std::size_t{0}};
+        }
+        return Error::system("sendmsg() failed on socket", this->sockFd);
+    }
+}
+
+Result<std::size_t> UnixSocket::receiveSomeWithDescriptors(std::span<std::uint8_t> buff, std::vector<int>& fds) {
+    if (this->sockFd < 0) {
+        return Error{ErrorCode::Failed, "Invalid socket"};
+    }
+
+    ::iovec iov{buff.data(), buff.size()};
+    alignas(::cmsghdr) char control[CMSG_SPACE(sizeof(int) * MAX_PASSED_DESCRIPTORS)]{};
+    ::msghdr msg{};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    while (true) {
+        //received descriptors are close on exec like every other descriptor of daemon
+        ssize_t n = ::recvmsg(this->sockFd, &msg, MSG_CMSG_CLOEXEC);
+        if (n > 0) {
+            for (::cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+                if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS) {
+                    std::size_t count = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+                    for (std::size_t i = 0; i < count; i++) {
+                        int fd = -1;
+                        std::memcpy(&fd, CMSG_DATA(cmsg) + i * sizeof(int), sizeof(int));
+                        fds.push_back(fd);
+                    }
+                }
+            }
+            if ((msg.msg_flags & MSG_CTRUNC) != 0) {
+                return Error{ErrorCode::Overflow, "Received descriptors were truncated on socket", this->sockFd};
+            }
+            return Result<std::size_t>{static_cast<std::size_t>(n)};
+        }
+        if (n == 0) {
+            return Error{ErrorCode::Failed, "Connection closed by peer on socket", this->sockFd};
+        }
+        if (errno == EINTR) {
+            continue;
+        }
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            return Result<std::size_t>{std::size_t{0}};
+        }
+        return Error::system("recvmsg() failed on socket", this->sockFd);
+    }
+}
+
+Result<::uid_t> UnixSocket::peerUid() const {
+    ::ucred credentials{};
+    ::socklen_t length = sizeof(credentials);
+    if (::getsockopt(this->sockFd, SOL_SOCKET, SO_PEERCRED, &credentials, &length) < 0) {
+        return Error::system("getsockopt(SO_PEERCRED) failed on socket", this->sockFd);
+    }
+    return Result<::uid_t>{credentials.uid};
+}
@@ -2,7 +2,7 @@
 #ifndef UNIXSOCKET_HPP
 #define UNIXOCKET_HPP
 
-#include "Utility/FunctionReturn.hpp"
+#include "Utility/Result.hpp"
 
 #include <sys/socket.h>
 #include <sys/un.h>
@@ -13,14 +13,18 @@
 #include <string>
 #include <cstring>
 #include <vector>
+#include <span>
 #include <cstdint>
 
-using Utility::FunctionReturn;
-using Utility::ExitCode;
+using Utility::Result;
 
 namespace Unix {
     //represents socket over unix domain, splits into server and client, server accepts requests and sends out data to requestors
     class UnixSocket {
+    public:
+        //limit of descriptors passed along with one message
+        static constexpr std::size_t MAX_PASSED_DESCRIPTORS = 8u;
+
     private:
         int sockFd{-1};
         std::string path;  
@@ -70,21 +74,52 @@ namespace Unix {
         }
 
         // creates a listening UNIX domain socket
-        static FunctionReturn<UnixSocket> serverFactory(const std::string& path);
+        static Result<UnixSocket> serverFactory(const std::string& path);
 
-        // accepts a single client and returns a connected UnixSocket
-        FunctionReturn<UnixSocket> acceptClient();
+        // accepts a single client and returns a connected non-blocking UnixSocket
+        Result<UnixSocket> acceptClient();
+
+        // takes ownership of client connection accepted elsewhere, e.g. by io_uring, and makes it non-blocking
+        static Result<UnixSocket> acceptedFactory(int fd);
 
         // connect to a UNIX domain socket
-        static FunctionReturn<UnixSocket> clientFactory(const std::string& path);
+        static Result<UnixSocket> clientFactory(const std::string& path);
+
+        // takes over listening socket handed over by another process, path stays bound to it
+        static Result<UnixSocket> adoptedServerFactory(int fd, const std::string& path);
+
+        Result<> send(const std::vector<std::uint8_t>& buff);
+
+        Result<> send(const std::string& s);
+
+        Result<std::string> receiveString(std::size_t maxBytes = 64);
 
-        FunctionReturn<> send(const std::vector<std::uint8_t>& buff);
+        Result<> receive(std::vector<std::uint8_t>& buff);
 
-        FunctionReturn<> send(const std::string& s);
+        // single write on non-blocking socket, returns amount of bytes written, 0 if socket buffer is full
+        Result<std::size_t> sendSome(std::span<const std::uint8_t> buff);
 
-        FunctionReturn<std::string> receiveString(std::size_t maxBytes = 64);
+        // single read on non-blocking socket, returns amount of bytes read, 0 if nothing is waiting, error once peer closed connection
+        Result<std::size_t> receiveSome(std::span<std::uint8_t> buff);
 
-        FunctionReturn<void> receive(std::vector<std::uint8_t>& buff);
+        // sendSome with descriptors attached to sent bytes (SCM_RIGHTS), receiver gets its own copies of them
+        Result<std::size_t> sendSomeWithDescriptors(std::span<const std::uint8_t> buff, const std::vector<int>& fds);
+
+        // receiveSome that appends descriptors attached to read bytes to fds, caller owns them
+        Result<std::size_t> receiveSomeWithDescriptors(std::span<std::uint8_t> buff, std::vector<int>& fds);
+
+        // user ID of connected peer process
+        Result<::uid_t> peerUid() const;
+
+        // server socket leaves its path in place when destroyed, used once its descriptor was handed to another process
+        void keepPath() {
+            this->isServer = false;
+        }
+
+        //used to wait for readiness with poll()
+        int fd() const {
+            return this->sockFd;
+        }
 
     };
 
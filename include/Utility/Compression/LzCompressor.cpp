@@ -0,0 +1,201 @@
+#include "LzCompressor.hpp"
+
+#include "Utility/Result.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+using Utility::Compression::LzCompressor;
+using Utility::Result;
+using Utility::Error;
+using Utility::ErrorCode;
+
+namespace {
+    constexpr std::size_t MIN_MATCH = 4u;
+    constexpr std::size_t MAX_OFFSET = 65535u;
+    constexpr std::size_t LAST_LITERALS = 5u;
+    constexpr std::size_t MATCH_FIND_LIMIT = 12u;
+    constexpr unsigned int HASH_LOG = 12u;
+    constexpr std::uint32_t EMPTY = 0xFFFFFFFFu;
+
+    inline std::uint32_t read32(const std::uint8_t* p) {
+        std::uint32_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+    inline std::uint32_t hash(std::uint32_t sequence) {
+        return (sequence * 2654435761u) >> (32u - HASH_LOG);
+    }
+
+    inline void writeLength(std::uint8_t*& op, std::size_t length) {
+        while (length >= 255u) {
+            *op++ = 255u;
+            length -= 255u;
+        }
+        *op++ = static_cast<std::uint8_t>(length);
+    }
+
+    //token, literals and optionally match offset with its length
+    inline void writeSequence(std::uint8_t*& op, const std::uint8_t* literals, std::size_t literalLength, std::size_t offset, std::size_t matchLength) {
+        std::uint8_t* token = op++;
+        *token = static_cast<std::uint8_t>((literalLength >= 15u ? 15u : literalLength) << 4);
+        if (literalLength >= 15u) {
+            writeLength(op, literalLength - 15u);
+        }
+        std::memcpy(op, literals, literalLength);
+        op += literalLength;
+
+        if (matchLength == 0) {
+            return;
+        }
+
+        *op++ = static_cast<std::uint8_t>(offset & 0xFFu);
+        *op++ = static_cast<std::uint8_t>(offset >> 8);
+        std::size_t extra = matchLength - MIN_MATCH;
+        *token |= static_cast<std::uint8_t>(extra >= 15u ? 15u : extra);
+        if (extra >= 15u) {
+            writeLength(op, extra - 15u);
+        }
+    }
+
+    inline bool readLength(const std::uint8_t*& ip, const std::uint8_t* end, std::size_t& length) {
+        std::uint8_t b;
+        do {
+            if (ip >= end) {
+                return false;
+            }
+            b = *ip++;
+            length += b;
+        } while (b == 255u);
+        return true;
+    }
+}
+
+void LzCompressor::compress(const std::uint8_t* data, std::size_t size, std::vector<std::uint8_t>& out) {
+    std::size_t start = out.size();
+    out.resize(start + maxCompressedSize(size));
+    std::uint8_t* op = out.data() + start;
+
+    std::size_t anchor = 0;
+    if (size > MATCH_FIND_LIMIT) {
+        std::array<std::uint32_t, 1u << HASH_LOG> table;
+        table.fill(EMPTY);
+
+        std::size_t limit = size - MATCH_FIND_LIMIT;
+        std::size_t matchEnd = size - LAST_LITERALS;
+        std::size_t ip = 0;
+        unsigned int misses = 0;
+
+        while (ip < limit) {
+            std::uint32_t sequence = read32(data + ip);
+            std::uint32_t h = hash(sequence);
+            std::uint32_t ref = table[h];
+            table[h] = static_cast<std::uint32_t>(ip);
+
+            if (ref == EMPTY || ip - ref > MAX_OFFSET || read32(data + ref) != sequence) {
+                //skip faster over incompressible data
+                ip += 1u + (misses++ >> 6);
+                continue;
+            }
+            misses = 0;
+
+            //extend match backwards over pending literals
+            while (ip > anchor && ref > 0 && data[ip - 1] == data[ref - 1]) {
+                --ip;
+                --ref;
+            }
+
+            std::size_t length = MIN_MATCH;
+            while (ip + length < matchEnd && data[ref + length] == data[ip + length]) {
+                ++length;
+            }
+
+            writeSequence(op, data + anchor, ip - anchor, ip - ref, length);
+            ip += length;
+            anchor = ip;
+        }
+    }
+
+    writeSequence(op, data + anchor, size - anchor, 0, 0);
+    out.resize(static_cast<std::size_t>(op - out.data()));
+}
+
+Result<> LzCompressor::decompress(const std::uint8_t* data, std::size_t size, std::size_t originalSize, std::vector<std::uint8_t>& out) {
+    //claimed size is checked against block first, so a few bytes can't make receiver allocate megabytes
+    if (originalSize > size * MAX_EXPANSION) {
+        return Error{ErrorCode::Failed, "LZ decompression failed, original size exceeds expansion bound"};
+    }
+
+    std::size_t start = out.size();
+    out.resize(start + originalSize);
+    std::uint8_t* op = out.data() + start;
+    std::uint8_t* const oend = op + originalSize;
+
+    const std::uint8_t* ip = data;
+    const std::uint8_t* const iend = data + size;
+
+    while (ip < iend) {
+        std::uint8_t token = *ip++;
+
+        std::size_t literalLength = token >> 4;
+        if (literalLength == 15u && !readLength(ip, iend, literalLength)) {
+            out.resize(start);
+            return Error{ErrorCode::Overflow, "LZ decompression failed, truncated literal length"};
+        }
+        if (literalLength > static_cast<std::size_t>(iend - ip) || literalLength > static_cast<std::size_t>(oend - op)) {
+            out.resize(start);
+            return Error{ErrorCode::Failed, "LZ decompression failed, literals overflow"};
+        }
+        std::memcpy(op, ip, literalLength);
+        ip += literalLength;
+        op += literalLength;
+
+        //last sequence has literals only
+        if (ip == iend) {
+            break;
+        }
+
+        if (iend - ip < 2) {
+            out.resize(start);
+            return Error{ErrorCode::Overflow, "LZ decompression failed, truncated offset"};
+        }
+        std::size_t offset = static_cast<std::size_t>(ip[0]) | (static_cast<std::size_t>(ip[1]) << 8);
+        ip += 2;
+        if (offset == 0 || offset > static_cast<std::size_t>(op - (out.data() + start))) {
+            out.resize(start);
+            return Error{ErrorCode::Failed, "LZ decompression failed, invalid offset"};
+        }
+
+        std::size_t matchLength = token & 0x0Fu;
+        if (matchLength == 15u && !readLength(ip, iend, matchLength)) {
+            out.resize(start);
+            return Error{ErrorCode::Overflow, "LZ decompression failed, truncated match length"};
+        }
+        matchLength += MIN_MATCH;
+        if (matchLength > static_cast<std::size_t>(oend - op)) {
+            out.resize(start);
+            return Error{ErrorCode::Failed, "LZ decompression failed, match overflow"};
+        }
+
+        const std::uint8_t* match = op - offset;
+        if (offset >= matchLength) {
+            std::memcpy(op, match, matchLength);
+            op += matchLength;
+        } else {
+            //overlapping copy repeats the last offset bytes
+            for (std::size_t i = 0; i < matchLength; ++i) {
+                *op++ = *match++;
+            }
+        }
+    }
+
+    if (op != oend) {
+        out.resize(start);
+        return Error{ErrorCode::Failed, "LZ decompression failed, size mismatch"};
+    }
+
+    return Result<>{};
+}
@@ -0,0 +1,35 @@
+#pragma once
+#ifndef LZCOMPRESSOR_HPP
+#define LZCOMPRESSOR_HPP
+
+#include "Utility/Result.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+using Utility::Result;
+
+namespace Utility::Compression {
+    //fast LZ77 compressor producing LZ4 block format (4B minimal match, 64KiB window, no entropy coding)
+    //made for text encoded addresses and repeated interface names, speed is preferred over ratio
+    class LzCompressor {
+    public:
+        //appends compressed block to out
+        static void compress(const std::uint8_t* data, std::size_t size, std::vector<std::uint8_t>& out);
+
+        //one LZ4 block byte expands to at most that many bytes
+        static constexpr std::size_t MAX_EXPANSION = 255u;
+
+        //appends exactly originalSize decompressed bytes to out, fails on malformed or truncated block
+        //originalSize that block can't expand to is rejected before out grows
+        static Result<> decompress(const std::uint8_t* data, std::size_t size, std::size_t originalSize, std::vector<std::uint8_t>& out);
+
+        //worst case size of compressed block for given input size
+        static constexpr std::size_t maxCompressedSize(std::size_t size) {
+            return size + size / 255 + 16;
+        }
+    };
+}
+
+#endif
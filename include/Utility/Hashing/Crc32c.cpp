@@ -0,0 +1,124 @@
+#include "Crc32c.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <nmmintrin.h>
+#elif defined(__aarch64__)
+#include <arm_acle.h>
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#endif
+
+using Utility::Hashing::Crc32c;
+
+namespace {
+    constexpr std::uint32_t POLYNOMIAL = 0x82F63B78u; //reflected 0x1EDC6F41
+
+    constexpr std::array<std::array<std::uint32_t, 256>, 8> makeTables() {
+        std::array<std::array<std::uint32_t, 256>, 8> tables{};
+        for (std::uint32_t i = 0; i < 256; ++i) {
+            std::uint32_t crc = i;
+            for (int b = 0; b < 8; ++b) {
+                crc = (crc & 1) ? (crc >> 1) ^ POLYNOMIAL : crc >> 1;
+            }
+            tables[0][i] = crc;
+        }
+        for (std::uint32_t i = 0; i < 256; ++i) {
+            for (std::size_t t = 1; t < 8; ++t) {
+                tables[t][i] = (tables[t - 1][i] >> 8) ^ tables[0][tables[t - 1][i] & 0xFF];
+            }
+        }
+        return tables;
+    }
+
+    constexpr auto TABLES = makeTables();
+
+    std::uint32_t computePortable(const std::uint8_t* p, std::size_t size, std::uint32_t crc) {
+        while (size >= 8) {
+            std::uint32_t lo, hi;
+            std::memcpy(&lo, p, sizeof(lo));
+            std::memcpy(&hi, p + 4, sizeof(hi));
+            lo ^= crc;
+            crc = TABLES[7][lo & 0xFF] ^ TABLES[6][(lo >> 8) & 0xFF]
+                ^ TABLES[5][(lo >> 16) & 0xFF] ^ TABLES[4][lo >> 24]
+                ^ TABLES[3][hi & 0xFF] ^ TABLES[2][(hi >> 8) & 0xFF]
+                ^ TABLES[1][(hi >> 16) & 0xFF] ^ TABLES[0][hi >> 24];
+            p += 8;
+            size -= 8;
+        }
+        while (size-- > 0) {
+            crc = TABLES[0][(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+        }
+        return crc;
+    }
+
+#if defined(__x86_64__)
+    __attribute__((target("sse4.2")))
+    std::uint32_t computeHardware(const std::uint8_t* p, std::size_t size, std::uint32_t crc) {
+        std::uint64_t crc64 = crc;
+        while (size >= 8) {
+            std::uint64_t v;
+            std::memcpy(&v, p, sizeof(v));
+            crc64 = _mm_crc32_u64(crc64, v);
+            p += 8;
+            size -= 8;
+        }
+        crc = static_cast<std::uint32_t>(crc64);
+        while (size-- > 0) {
+            crc = _mm_crc32_u8(crc, *p++);
+        }
+        return crc;
+    }
+
+    bool detectHardware() {
+        return __builtin_cpu_supports("sse4.2");
+    }
+#elif defined(__aarch64__)
+    __attribute__((target("+crc")))
+    std::uint32_t computeHardware(const std::uint8_t* p, std::size_t size, std::uint32_t crc) {
+        while (size >= 8) {
+            std::uint64_t v;
+            std::memcpy(&v, p, sizeof(v));
+            crc = __crc32cd(crc, v);
+            p += 8;
+            size -= 8;
+        }
+        while (size-- > 0) {
+            crc = __crc32cb(crc, *p++);
+        }
+        return crc;
+    }
+
+    bool detectHardware() {
+        return (::getauxval(AT_HWCAP) & HWCAP_CRC32) != 0;
+    }
+#else
+    std::uint32_t computeHardware(const std::uint8_t* p, std::size_t size, std::uint32_t crc) {
+        return computePortable(p, size, crc);
+    }
+
+    bool detectHardware() {
+        return false;
+    }
+#endif
+
+    using ComputeFunction = std::uint32_t (*)(const std::uint8_t*, std::size_t, std::uint32_t);
+
+    //resolved once, CPU features don't change during runtime
+    ComputeFunction resolve() {
+        static const ComputeFunction compute = detectHardware() ? computeHardware : computePortable;
+        return compute;
+    }
+}
+
+std::uint32_t Crc32c::compute(const std::uint8_t* data, std::size_t size, std::uint32_t crc) {
+    return ~resolve()(data, size, ~crc);
+}
+
+bool Crc32c::isAccelerated() {
+    return resolve() != computePortable;
+}
@@ -0,0 +1,19 @@
+#pragma once
+#ifndef CRC32C_HPP
+#define CRC32C_HPP
+
+#include <cstdint>
+#include <cstddef>
+
+namespace Utility::Hashing {
+    //CRC32C (Castagnoli) checksum, uses SSE4.2 or ARMv8 CRC instructions when CPU supports them
+    //falls back to table driven (slicing by 8) implementation otherwise
+    class Crc32c {
+    public:
+        static std::uint32_t compute(const std::uint8_t* data, std::size_t size, std::uint32_t crc = 0);
+        //true if hardware implementation is used on this CPU
+        static bool isAccelerated();
+    };
+}
+
+#endif
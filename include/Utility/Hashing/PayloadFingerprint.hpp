@@ -0,0 +1,103 @@
+#pragma once
+#ifndef PAYLOADFINGERPRINT_HPP
+#define PAYLOADFINGERPRINT_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+namespace Utility::Hashing {
+    //non cryptographic 64-bit hash (xxHash64 algorithm) of raw payload bytes
+    //used to detect byte identical payloads without deserializing them
+    class PayloadFingerprint {
+    private:
+        static constexpr std::uint64_t PRIME1 = 0x9E3779B185EBCA87ull;
+        static constexpr std::uint64_t PRIME2 = 0xC2B2AE3D27D4EB4Full;
+        static constexpr std::uint64_t PRIME3 = 0x165667B19E3779F9ull;
+        static constexpr std::uint64_t PRIME4 = 0x85EBCA77C2B2AE63ull;
+        static constexpr std::uint64_t PRIME5 = 0x27D4EB2F165667C5ull;
+
+        static inline std::uint64_t rotl(std::uint64_t x, int r) {
+            return (x << r) | (x >> (64 - r));
+        }
+
+        static inline std::uint64_t read64(const std::uint8_t* p) {
+            std::uint64_t v;
+            std::memcpy(&v, p, sizeof(v));
+            return v;
+        }
+
+        static inline std::uint32_t read32(const std::uint8_t* p) {
+            std::uint32_t v;
+            std::memcpy(&v, p, sizeof(v));
+            return v;
+        }
+
+        static inline std::uint64_t round(std::uint64_t acc, std::uint64_t input) {
+            acc += input * PRIME2;
+            acc = rotl(acc, 31);
+            return acc * PRIME1;
+        }
+
+        static inline std::uint64_t mergeRound(std::uint64_t acc, std::uint64_t val) {
+            acc ^= round(0, val);
+            return acc * PRIME1 + PRIME4;
+        }
+
+    public:
+        static inline std::uint64_t compute(const std::uint8_t* data, std::size_t size, std::uint64_t seed = 0) {
+            const std::uint8_t* p = data;
+            const std::uint8_t* end = data + size;
+            std::uint64_t h;
+
+            if (size >= 32) {
+                std::uint64_t v1 = seed + PRIME1 + PRIME2;
+                std::uint64_t v2 = seed + PRIME2;
+                std::uint64_t v3 = seed;
+                std::uint64_t v4 = seed - PRIME1;
+                do {
+                    v1 = round(v1, read64(p));
+                    v2 = round(v2, read64(p + 8));
+                    v3 = round(v3, read64(p + 16));
+                    v4 = round(v4, read64(p + 24));
+                    p += 32;
+                } while (p + 32 <= end);
+
+                h = rotl(v1, 1) + rotl(v2, 7) + rotl(v3, 12) + rotl(v4, 18);
+                h = mergeRound(h, v1);
+                h = mergeRound(h, v2);
+                h = mergeRound(h, v3);
+                h = mergeRound(h, v4);
+            } else {
+                h = seed + PRIME5;
+            }
+
+            h += static_cast<std::uint64_t>(size);
+
+            while (p + 8 <= end) {
+                h ^= round(0, read64(p));
+                h = rotl(h, 27) * PRIME1 + PRIME4;
+                p += 8;
+            }
+            if (p + 4 <= end) {
+                h ^= static_cast<std::uint64_t>(read32(p)) * PRIME1;
+                h = rotl(h, 23) * PRIME2 + PRIME3;
+                p += 4;
+            }
+            while (p < end) {
+                h ^= static_cast<std::uint64_t>(*p) * PRIME5;
+                h = rotl(h, 11) * PRIME1;
+                ++p;
+            }
+
+            h ^= h >> 33;
+            h *= PRIME2;
+            h ^= h >> 29;
+            h *= PRIME3;
+            h ^= h >> 32;
+            return h;
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,193 @@
+#pragma once
+#ifndef RESULT_HPP
+#define RESULT_HPP
+
+#include <expected>
+#include <array>
+#include <string>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <cerrno>
+
+namespace Utility {
+    enum class ErrorCode : std::uint8_t {
+        Failed,
+        //system call failed, errno is kept in error
+        System,
+        //buffer ended before value did
+        Overflow,
+        NotFound,
+        Unsupported
+    };
+
+    //failure of Result, holds only static strings and numbers, so failing and passing it up allocates nothing
+    //text is built by message() once somebody reports the error
+    //cold paths like file and settings handling may attach owned detail, e.g. path or key, which is the only allocation
+    class Error {
+    public:
+        static constexpr std::size_t MAX_CONTEXTS = 6;
+
+    private:
+        ErrorCode errorCode = ErrorCode::Failed;
+        int errnoValue = 0;
+        const char* what = "";
+        //number failed operation was about, e.g. socket descriptor or interface index
+        std::int64_t subject = 0;
+        bool hasSubject = false;
+        //appended after what, names what operation was about when number can't
+        std::string detail{};
+        //added by callers on the way up, innermost first, deeper chains keep the innermost ones
+        std::array<const char*, MAX_CONTEXTS> contexts{};
+        std::uint8_t contextCount = 0;
+
+    public:
+        Error(ErrorCode code, const char* what) : errorCode{code}, what{what} {}
+        Error(ErrorCode code, const char* what, std::int64_t subject) : errorCode{code}, what{what}, subject{subject}, hasSubject{true} {}
+        Error(ErrorCode code, const char* what, std::string detail) : errorCode{code}, what{what}, detail{std::move(detail)} {}
+
+        //captures errno of system call that just failed
+        static Error system(const char* what) {
+            Error error{ErrorCode::System, what};
+            error.errnoValue = errno;
+            return error;
+        }
+
+        static Error system(const char* what, std::int64_t subject) {
+            Error error{ErrorCode::System, what, subject};
+            error.errnoValue = errno;
+            return error;
+        }
+
+        static Error system(const char* what, std::string detail) {
+            int errnoValue = errno;
+            Error error{ErrorCode::System, what, std::move(detail)};
+            error.errnoValue = errnoValue;
+            return error;
+        }
+
+        //returned by value, so within() on temporary doesn't leave caller with reference to it
+        Error within(const char* context) && {
+            if (this->contextCount < MAX_CONTEXTS) {
+                this->contexts[this->contextCount++] = context;
+            }
+            return std::move(*this);
+        }
+
+        Error within(const char* context) const & {
+            return Error{*this}.within(context);
+        }
+
+        ErrorCode code() const {
+            return this->errorCode;
+        }
+
+        //errno of failed system call, 0 if error didn't come from one
+        int systemError() const {
+            return this->errnoValue;
+        }
+
+        //outermost context first, e.g. "Couldn't deserialize neighbor page: Vector deserialization failed: Primitive deserialization failed, overflow"
+        std::string message() const {
+            std::string text{};
+            for (std::size_t i = this->contextCount; i > 0; i--) {
+                text += this->contexts[i - 1];
+                text += ": ";
+            }
+            text += this->what;
+            if (this->hasSubject) {
+                text += " " + std::to_string(this->subject);
+            }
+            if (!this->detail.empty()) {
+                text += " " + this->detail;
+            }
+            if (this->errnoValue != 0) {
+                text += ": ";
+                text += std::strerror(this->errnoValue);
+            }
+            return text;
+        }
+    };
+
+    //move only result of functions that's failure can be handled, successful value is moved out instead of copied
+    template<typename T = void>
+    class [[nodiscard]] Result {
+    private:
+        std::expected<T, Error> outcome;
+
+    public:
+        Result(T&& value) : outcome{std::move(value)} {}
+        Result(const T& value) requires std::is_trivially_copyable_v<T> : outcome{value} {}
+        Result(Error error) : outcome{std::unexpect, std::move(error)} {}
+
+        Result(const Result&) = delete;
+        Result& operator=(const Result&) = delete;
+        Result(Result&&) = default;
+        Result& operator=(Result&&) = default;
+        ~Result() = default;
+
+        bool isOk() const {
+            return this->outcome.has_value();
+        }
+
+        T& value() & {
+            return *this->outcome;
+        }
+
+        const T& value() const & {
+            return *this->outcome;
+        }
+
+        T&& value() && {
+            return std::move(*this->outcome);
+        }
+
+        const Error& error() const {
+            return this->outcome.error();
+        }
+
+        //error with caller's context added, converts to result of any type
+        Error within(const char* context) const {
+            return this->outcome.error().within(context);
+        }
+
+        std::string message() const {
+            return this->isOk() ? std::string{} : this->outcome.error().message();
+        }
+    };
+
+    template<>
+    class [[nodiscard]] Result<void> {
+    private:
+        std::expected<void, Error> outcome;
+
+    public:
+        Result() = default;
+        Result(Error error) : outcome{std::unexpect, std::move(error)} {}
+
+        Result(const Result&) = delete;
+        Result& operator=(const Result&) = delete;
+        Result(Result&&) = default;
+        Result& operator=(Result&&) = default;
+        ~Result() = default;
+
+        bool isOk() const {
+            return this->outcome.has_value();
+        }
+
+        const Error& error() const {
+            return this->outcome.error();
+        }
+
+        Error within(const char* context) const {
+            return this->outcome.error().within(context);
+        }
+
+        std::string message() const {
+            return this->isOk() ? std::string{} : this->outcome.error().message();
+        }
+    };
+}
+
+#endif
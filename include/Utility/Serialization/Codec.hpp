@@ -0,0 +1,195 @@
+#pragma once
+#ifndef CODEC_HPP
+#define CODEC_HPP
+
+#include "Result.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+#include <span>
+#include <string>
+#include <tuple>
+#include <concepts>
+#include <type_traits>
+
+using Utility::Result;
+using Utility::Error;
+using Utility::ErrorCode;
+
+namespace Utility::Serialization {
+
+    //one serialized member of described type, name is reported when it can't be decoded
+    template<typename C, typename M>
+    struct Field {
+        const char* name;
+        M C::* member;
+    };
+
+    template<typename C, typename M>
+    Field(const char*, M C::*) -> Field<C, M>;
+
+    //type describes its serialized members in wire order with static constexpr fields() returning tuple of Fields
+    template<typename T>
+    concept Described = requires { { std::tuple_size<decltype(T::fields())>::value } -> std::convertible_to<std::size_t>; }
+        && std::is_default_constructible_v<T>;
+
+    template<typename T>
+    struct IsVector : std::false_type {};
+
+    template<typename T>
+    struct IsVector<std::vector<T>> : std::true_type {};
+
+    //generates encode, decode and exact size of described types from their field lists at compile time
+    //wire format is the one of Serializer and Deserializer: trivial types as raw bytes, strings and vectors prefixed with 64 bit length
+    //encode sizes buffer once and writes fields through a pointer, so nothing is virtual and calls inline into callers
+    class Codec {
+    public:
+        template<typename T>
+        static constexpr std::size_t minimumSize() {
+            if constexpr (std::is_trivial_v<T>) {
+                return sizeof(T);
+            } else if constexpr (std::same_as<T, std::string> || IsVector<T>::value) {
+                return sizeof(std::uint64_t);
+            } else {
+                static_assert(Described<T>, "type has no codec");
+                return std::apply([](auto... fields) {
+                    return (minimumSize<std::remove_cvref_t<decltype(std::declval<T>().*(fields.member))>>() + ... + std::size_t{0});
+                }, T::fields());
+            }
+        }
+
+        template<typename T>
+        static std::size_t encodedSize(const T& value) {
+            if constexpr (std::is_trivial_v<T>) {
+                return sizeof(T);
+            } else if constexpr (std::same_as<T, std::string>) {
+                return sizeof(std::uint64_t) + value.size();
+            } else if constexpr (IsVector<T>::value) {
+                using Element = typename T::value_type;
+                if constexpr (std::is_trivial_v<Element>) {
+                    return sizeof(std::uint64_t) + value.size() * sizeof(Element);
+                } else {
+                    std::size_t size = sizeof(std::uint64_t);
+                    for (const auto& element : value) {
+                        size += encodedSize(element);
+                    }
+                    return size;
+                }
+            } else {
+                static_assert(Described<T>, "type has no codec");
+                return std::apply([&](auto... fields) {
+                    return (encodedSize(value.*(fields.member)) + ... + std::size_t{0});
+                }, T::fields());
+            }
+        }
+
+        //appends value to buff
+        template<typename T>
+        static void encode(const T& value, std::vector<std::uint8_t>& buff) {
+            std::size_t start = buff.size();
+            buff.resize(start + encodedSize(value));
+            std::uint8_t* out = buff.data() + start;
+            write(value, out);
+        }
+
+        template<typename T>
+        static Result<T> decode(std::span<const std::uint8_t> buff, std::size_t& offset) {
+            T value{};
+            auto readReturn = read(buff, offset, value);
+            if (!readReturn.isOk()) {
+                return readReturn.error();
+            }
+            return Result<T>{std::move(value)};
+        }
+
+    private:
+        template<typename T>
+        static void write(const T& value, std::uint8_t*& out) {
+            if constexpr (std::is_trivial_v<T>) {
+                std::memcpy(out, &value, sizeof(T));
+                out += sizeof(T);
+            } else if constexpr (std::same_as<T, std::string>) {
+                write(static_cast<std::uint64_t>(value.size()), out);
+                std::memcpy(out, value.data(), value.size());
+                out += value.size();
+            } else if constexpr (IsVector<T>::value) {
+                write(static_cast<std::uint64_t>(value.size()), out);
+                if constexpr (std::is_trivial_v<typename T::value_type>) {
+                    std::memcpy(out, value.data(), value.size() * sizeof(typename T::value_type));
+                    out += value.size() * sizeof(typename T::value_type);
+                } else {
+                    for (const auto& element : value) {
+                        write(element, out);
+                    }
+                }
+            } else {
+                std::apply([&](auto... fields) {
+                    (write(value.*(fields.member), out), ...);
+                }, T::fields());
+            }
+        }
+
+        template<typename T>
+        static Result<> read(std::span<const std::uint8_t> buff, std::size_t& offset, T& value) {
+            if constexpr (std::is_trivial_v<T>) {
+                if (buff.size() < offset || buff.size() - offset < sizeof(T)) {
+                    return Error{ErrorCode::Overflow, "Primitive deserialization failed, overflow"};
+                }
+                std::memcpy(&value, buff.data() + offset, sizeof(T));
+                offset += sizeof(T);
+                return Result<>{};
+            } else if constexpr (std::same_as<T, std::string>) {
+                std::uint64_t length = 0;
+                auto lengthReturn = read(buff, offset, length);
+                if (!lengthReturn.isOk() || buff.size() - offset < length) {
+                    return Error{ErrorCode::Overflow, "String deserialization failed, overflow"};
+                }
+                value.assign(reinterpret_cast<const char*>(buff.data() + offset), length);
+                offset += length;
+                return Result<>{};
+            } else if constexpr (IsVector<T>::value) {
+                using Element = typename T::value_type;
+                std::uint64_t length = 0;
+                auto lengthReturn = read(buff, offset, length);
+                //every element takes at least its minimum size, so corrupted length can't make reserve allocate more than buffer holds
+                if (!lengthReturn.isOk() || (buff.size() - offset) / minimumSize<Element>() < length) {
+                    return Error{ErrorCode::Overflow, "Vector deserialization failed, overflow"};
+                }
+                value.resize(length);
+                if constexpr (std::is_trivial_v<Element>) {
+                    std::memcpy(value.data(), buff.data() + offset, length * sizeof(Element));
+                    offset += length * sizeof(Element);
+                } else {
+                    for (auto& element : value) {
+                        auto elementReturn = read(buff, offset, element);
+                        if (!elementReturn.isOk()) {
+                            return elementReturn.within("Vector deserialization failed");
+                        }
+                    }
+                }
+                return Result<>{};
+            } else {
+                static_assert(Described<T>, "type has no codec");
+                Result<> result{};
+                std::apply([&](auto... fields) {
+                    //stops at first field that fails
+                    ((result = readField(buff, offset, value.*(fields.member), fields.name)).isOk() && ...);
+                }, T::fields());
+                return result;
+            }
+        }
+
+        template<typename M>
+        static Result<> readField(std::span<const std::uint8_t> buff, std::size_t& offset, M& member, const char* name) {
+            auto readReturn = read(buff, offset, member);
+            if (!readReturn.isOk()) {
+                return readReturn.within(name);
+            }
+            return readReturn;
+        }
+    };
+}
+
+#endif
@@ -2,56 +2,59 @@
 #ifndef DESERIALIZER_HPP
 #define DESERIALIZER_HPP
 
-#include "FunctionReturn.hpp"
+#include "Result.hpp"
+#include "Codec.hpp"
 
 #include <cstdint>
 #include <vector>
+#include <span>
 #include <string>
 #include <concepts>
 #include <type_traits>
 #include <cstring>
 
-using Utility::FunctionReturn;
-using Utility::ExitCode;
+using Utility::Result;
+using Utility::Error;
+using Utility::ErrorCode;
 
 namespace Utility::Serialization {
 
     //concept that requires type to have a static deserialize method
     template<typename T>
     concept Deserializable = requires(T t, std::vector<std::uint8_t>& buff, std::size_t& offset) {
-        { T::deserialize(buff, offset) } -> std::same_as<FunctionReturn<T>>;
+        { T::deserialize(buff, offset) } -> std::same_as<Result<T>>;
     };
 
     //handles deserialization of primitives, strings, vectors of deserializable classes
     //vector and string deserialization is handled by acquiring length first, compound types' deserialization order handled in concrete classes
-    //deserializes from vector of bytes
+    //deserializes from contiguous bytes (vector or memory mapped file)
     //deserialization shoudln't fail unless buffers are mutated outside of this program
     class Deserializer {
     public:
     //functions made inline to fix multiple definition problems
         template<typename T>
             requires (std::is_trivial_v<T>)
-        inline static FunctionReturn<T> deserialize(const std::vector<std::uint8_t>& buff, std::size_t& offset);
+        inline static Result<T> deserialize(std::span<const std::uint8_t> buff, std::size_t& offset);
 
-        inline static FunctionReturn<std::string> deserialize(const std::vector<std::uint8_t>& buff,  std::size_t& offset);
+        inline static Result<std::string> deserialize(std::span<const std::uint8_t> buff,  std::size_t& offset);
 
         template<Deserializable T>
-        inline static FunctionReturn<std::vector<T>> deserialize(const std::vector<std::uint8_t>& buff, std::size_t& offset);
+        inline static Result<std::vector<T>> deserialize(std::span<const std::uint8_t> buff, std::size_t& offset);
 
         template<typename T>
             requires (std::is_trivial_v<T>)
-        static FunctionReturn<T> deserialize(const std::vector<std::uint8_t>& buff) {
+        static Result<T> deserialize(std::span<const std::uint8_t> buff) {
             std::size_t offset = 0;
             return deserialize<T>(buff, offset);
         }
 
-        static FunctionReturn<std::string> deserialize(const std::vector<std::uint8_t>& buff) {
+        static Result<std::string> deserialize(std::span<const std::uint8_t> buff) {
             std::size_t offset = 0;
             return deserialize(buff, offset);
         }
 
         template<Deserializable T>
-        static FunctionReturn<std::vector<T>> deserialize(const std::vector<std::uint8_t>& buff) {
+        static Result<std::vector<T>> deserialize(std::span<const std::uint8_t> buff) {
             std::size_t offset = 0;
             return deserialize<T>(buff, offset);
         }
@@ -59,53 +62,56 @@ namespace Utility::Serialization {
 
     template<typename T>
         requires (std::is_trivial_v<T>)
-    FunctionReturn<T> Deserializer::deserialize(const std::vector<std::uint8_t>& buff, std::size_t& offset) {
+    Result<T> Deserializer::deserialize(std::span<const std::uint8_t> buff, std::size_t& offset) {
         if (offset + sizeof(T) > buff.size()) {
-            return FunctionReturn<T>{ExitCode::Error, "Primitive deserialization failed, overflow"};
+            return Error{ErrorCode::Overflow, "Primitive deserialization failed, overflow"};
         }
         T val;
         std::memcpy(&val, buff.data() + offset, sizeof(T));
         offset += sizeof(T);
 
-        return FunctionReturn<T>{val};
+        return Result<T>{val};
     }
 
-    FunctionReturn<std::string> Deserializer::deserialize(const std::vector<std::uint8_t>& buff,  std::size_t& offset) {
+    Result<std::string> Deserializer::deserialize(std::span<const std::uint8_t> buff,  std::size_t& offset) {
         auto funcReturn = Deserializer::deserialize<std::uint64_t>(buff, offset);
         if (!funcReturn.isOk()) {
-            return FunctionReturn<std::string>{"String deserialization failed", funcReturn};
+            return funcReturn.within("String deserialization failed");
         }
-        std::uint64_t length = funcReturn.data.value();
+        std::uint64_t length = funcReturn.value();
 
         if (offset + length > buff.size()) {
-            // , msg = "String deserialization failed, overflow"
-            return FunctionReturn<std::string>{ExitCode::Error, "String deserialization failed, overflow"};
+            return Error{ErrorCode::Overflow, "String deserialization failed, overflow"};
         }
         std::string str(reinterpret_cast<const char*>(buff.data() + offset), length);
         offset += length;
 
-        return  FunctionReturn<std::string>{str};
+        return Result<std::string>{std::move(str)};
     }
 
     template<Deserializable T>
-    FunctionReturn<std::vector<T>> Deserializer::deserialize(const std::vector<std::uint8_t>& buff, std::size_t& offset) {
+    Result<std::vector<T>> Deserializer::deserialize(std::span<const std::uint8_t> buff, std::size_t& offset) {
+        if constexpr (Described<T>) {
+            return Codec::decode<std::vector<T>>(buff, offset);
+        }
+
         auto funcReturn = Deserializer::deserialize<std::uint64_t>(buff, offset);
         if (!funcReturn.isOk()) {
-            return FunctionReturn<std::vector<T>>{"Vector deserialization failed", funcReturn};
+            return funcReturn.within("Vector deserialization failed");
         }
-        std::uint64_t length = funcReturn.data.value();
+        std::uint64_t length = funcReturn.value();
 
         std::vector<T> vec;
         vec.reserve(length);
         for (uint64_t i = 0; i < length; ++i) {
             auto funcReturnElem = T::deserialize(buff, offset);
             if (!funcReturnElem.isOk()) {
-                return FunctionReturn<std::vector<T>>{"Vector deserialization failed", funcReturnElem};
+                return funcReturnElem.within("Vector deserialization failed");
             }
-            vec.push_back(funcReturnElem.data.value());
+            vec.push_back(std::move(funcReturnElem).value());
         }
 
-        return FunctionReturn<std::vector<T>>{vec};
+        return Result<std::vector<T>>{std::move(vec)};
     }
 }
 #endif
\ No newline at end of file
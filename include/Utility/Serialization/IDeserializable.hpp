@@ -2,27 +2,28 @@
 #ifndef IDESERIALIZABLE_HPP
 #define IDESERIALIZABLE_HPP
 
-#include "FunctionReturn.hpp"
+#include "Result.hpp"
 
 #include <vector>
+#include <span>
 #include <cstdint>
 #include <concepts>
 #include <type_traits>
 
-using Utility::FunctionReturn;
+using Utility::Result;
 
 namespace Utility::Serialization {
 
     template<typename T>
     concept DeserializableImplemented = requires(T t, std::vector<std::uint8_t>& buff, std::size_t& offset) {
-        { T::deserializeImpl(buff, offset) } -> std::same_as<FunctionReturn<T>>;
+        { T::deserializeImpl(buff, offset) } -> std::same_as<Result<T>>;
     };
 
     //ensures that derived have deserializeImpl method and makes deserialize static
     template<typename TDerived>
     class IDeserializable {
     public:
-        static FunctionReturn<TDerived> deserialize(const std::vector<std::uint8_t> buff, std::size_t& offset) {
+        static Result<TDerived> deserialize(std::span<const std::uint8_t> buff, std::size_t& offset) {
             return TDerived::deserializeImpl(buff, offset);
         }
 
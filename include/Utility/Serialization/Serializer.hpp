@@ -2,6 +2,8 @@
 #ifndef SERIALIZER_HPP
 #define SERIALIZER_HPP
 
+#include "Codec.hpp"
+
 #include <vector>
 #include <cstdint>
 #include <type_traits>
@@ -48,6 +50,12 @@ namespace Utility::Serialization {
 
     template<Serializable T>
     void Serializer::serialize(std::vector<std::uint8_t>& buff, const std::vector<T>& vec) {
+        //described types are sized and written in one pass
+        if constexpr (Described<T>) {
+            Codec::encode(vec, buff);
+            return;
+        }
+
         std::uint64_t length = vec.size();
         Serializer::serialize(buff, length);
 